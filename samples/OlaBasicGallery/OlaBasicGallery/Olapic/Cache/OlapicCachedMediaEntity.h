@@ -0,0 +1,76 @@
+//
+//  OlapicCachedMediaEntity.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+
+@class OlapicMediaCache;
+/**
+ *  A media entity backed by an OlapicMediaCache file. The values
+ *  requested with get: are read directly from the file, and the
+ *  whole entity is only read the first time the SDK needs it (the data,
+ *  the uploader, the original size, the media URLs, etc.)
+ */
+@interface OlapicCachedMediaEntity : OlapicMediaEntity{
+    /**
+     *  The file with the entity
+     */
+    OlapicMediaCache *cache;
+    /**
+     *  The entity index on the file
+     */
+    NSUInteger index;
+    /**
+     *  If the whole entity was already read
+     */
+    BOOL loaded;
+}
+
+@property (nonatomic,strong,readonly) OlapicMediaCache *cache;
+@property (nonatomic,readonly) NSUInteger index;
+/**
+ *  Class constructor
+ *
+ *  @param mediaCache The file with the entity
+ *  @param mediaIndex The entity index on the file
+ *
+ *  @return An instance of this object (OlapicCachedMediaEntity)
+ */
+-(id)initWithCache:(OlapicMediaCache *)mediaCache index:(NSUInteger)mediaIndex;
+/**
+ *  Check if the whole entity was already read from the file
+ *
+ *  @return If the entity was read
+ */
+-(BOOL)isLoaded;
+
+@end
\ No newline at end of file
@@ -0,0 +1,147 @@
+//
+//  OlapicCachedMediaEntity.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicCachedMediaEntity.h"
+#import "OlapicMediaCache.h"
+
+@interface OlapicCachedMediaEntity()
+/**
+ *  Read the whole entity from the file. The SDK parses it so the
+ *  uploader and the original size are the same it would set
+ */
+-(void)load;
+
+@end
+
+@implementation OlapicCachedMediaEntity
+
+@synthesize cache = cache;
+@synthesize index = index;
+/**
+ *  Class constructor
+ *
+ *  @param mediaCache The file with the entity
+ *  @param mediaIndex The entity index on the file
+ *
+ *  @return An instance of this object (OlapicCachedMediaEntity)
+ */
+-(id)initWithCache:(OlapicMediaCache *)mediaCache index:(NSUInteger)mediaIndex{
+    self = [super init];
+    if(self){
+        cache = mediaCache;
+        index = mediaIndex;
+        loaded = NO;
+    }
+    return self;
+}
+/**
+ *  Check if the whole entity was already read from the file
+ *
+ *  @return If the entity was read
+ */
+-(BOOL)isLoaded{
+    @synchronized(self){
+        return loaded;
+    }
+}
+/**
+ *  Read the whole entity from the file. The SDK parses it so the
+ *  uploader and the original size are the same it would set
+ */
+-(void)load{
+    @synchronized(self){
+        if(loaded) return;
+        NSMutableDictionary *values = [cache dictionaryForRecord:index];
+        if(values){
+            OlapicMediaEntity *parsed = [[OlapicMediaEntity alloc] initWithData:values];
+            data = parsed.data;
+            uploader = parsed.uploader;
+            originalSize = parsed.originalSize;
+        }
+        // Only now, get: reads the data without locking once it's set
+        loaded = YES;
+    }
+}
+#pragma mark - Lazy values
+-(id)get:(NSString *)path{
+    if(![self isLoaded]){
+        return [cache valueAtPath:path forRecord:index];
+    }
+    return [super get:path];
+}
+
+-(NSMutableDictionary *)data{
+    [self load];
+    return data;
+}
+
+-(OlapicUploaderEntity *)uploader{
+    [self load];
+    return uploader;
+}
+
+-(CGSize)originalSize{
+    [self load];
+    return originalSize;
+}
+
+-(BOOL)isVideo{
+    [self load];
+    return [super isVideo];
+}
+
+-(NSString *)getMediaURLForImageSize:(OlapicMediaImageSize)size{
+    [self load];
+    return [super getMediaURLForImageSize:size];
+}
+
+-(void)getUploader:(void (^)(OlapicUploaderEntity *uploader))success onFailure:(void (^)(NSError *error))failure{
+    [self load];
+    [super getUploader:success onFailure:failure];
+}
+
+-(void)getImageWithSize:(OlapicMediaImageSize)size onSuccess:(void (^)(NSData *mediaData,UIImage *mediaImage))success onFailure:(void (^)(NSError *error))failure{
+    [self load];
+    [super getImageWithSize:size onSuccess:success onFailure:failure];
+}
+
+-(void)report:(NSDictionary *)metadata onSuccess:(void (^)(void))success onFailure:(void (^)(NSError *error))failure{
+    [self load];
+    [super report:metadata onSuccess:success onFailure:failure];
+}
+
+-(void)getRelatedStreams:(void(^)(NSArray *streams))success onFailure:(void (^)(NSError *error))failure{
+    [self load];
+    [super getRelatedStreams:success onFailure:failure];
+}
+
+@end
\ No newline at end of file
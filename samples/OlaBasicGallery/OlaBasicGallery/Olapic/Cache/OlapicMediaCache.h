@@ -0,0 +1,146 @@
+//
+//  OlapicMediaCache.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+/**
+ *  A compact binary file with the data of a list of media entities,
+ *  made to be memory mapped and read without deserializing it.
+ *
+ *  The file format (all the integers are little endian uint32):
+ *
+ *  - Header: 'OLPC', version, string count, record count,
+ *    string table offset, record table offset
+ *  - Strings: the UTF-8 bytes of every different string (keys and
+ *    values), each one stored only once. The string table has an
+ *    (offset, length) pair for each one
+ *  - Records: the record table has the offset of each entity's value
+ *  - Values: a type byte followed by the value:
+ *    - null, false, true: nothing else
+ *    - integer, double: 8 bytes
+ *    - string: the string index
+ *    - array: item count, byte length, items
+ *    - dictionary: entry count, byte length, (key string index, value) entries
+ *
+ *  The strings are created on demand, only once, and shared by all
+ *  the entities. The containers store their length, so
+ *  a path can be read skipping everything else.
+ *
+ *  Every offset and length is checked against the file before it's
+ *  used: a value that doesn't fit is read as nil, never out of the
+ *  mapped bytes.
+ */
+@interface OlapicMediaCache : NSObject{
+    /**
+     *  The mapped file
+     */
+    NSData *buffer;
+    /**
+     *  The strings already created, by index
+     */
+    NSPointerArray *strings;
+    /**
+     *  The number of strings
+     */
+    uint32_t stringCount;
+    /**
+     *  The number of records
+     */
+    uint32_t recordCount;
+    /**
+     *  The offset of the string table
+     */
+    uint32_t stringTableOffset;
+    /**
+     *  The offset of the record table
+     */
+    uint32_t recordTableOffset;
+}
+/**
+ *  Write the data of a list of entities to a file
+ *
+ *  @param media The OlapicMediaEntity objects
+ *  @param path  The file path
+ *  @param error A reference to save the error, if the file can't be written
+ *
+ *  @return If the file was written
+ */
++(BOOL)writeMedia:(NSArray *)media toFile:(NSString *)path error:(NSError **)error;
+/**
+ *  Class constructor. The file is memory mapped, only its string
+ *  and record tables are read to check they're inside the file
+ *
+ *  @param path  The file path
+ *  @param error A reference to save the error, if the file is not valid
+ *
+ *  @return An instance of this object (OlapicMediaCache), or nil if the file is not valid
+ */
+-(id)initWithContentsOfFile:(NSString *)path error:(NSError **)error;
+/**
+ *  Get the number of entities on the file
+ *
+ *  @return The number of entities
+ */
+-(NSUInteger)count;
+/**
+ *  Get a media entity that reads its data from the file when it's needed
+ *
+ *  @param index The entity index
+ *
+ *  @return An OlapicCachedMediaEntity
+ */
+-(OlapicMediaEntity *)mediaAtIndex:(NSUInteger)index;
+/**
+ *  Get all the media entities on the file (it doesn't read their data)
+ *
+ *  @return An array of OlapicCachedMediaEntity objects
+ */
+-(NSArray *)allMedia;
+/**
+ *  Read a single value from an entity, without reading the rest
+ *
+ *  @param path  The navigation path, using slashes like OlapicEntity's get: (key1/key2/value)
+ *  @param index The entity index
+ *
+ *  @return The value, or nil if the path doesn't exist
+ */
+-(id)valueAtPath:(NSString *)path forRecord:(NSUInteger)index;
+/**
+ *  Read all the data of an entity
+ *
+ *  @param index The entity index
+ *
+ *  @return The entity data
+ */
+-(NSMutableDictionary *)dictionaryForRecord:(NSUInteger)index;
+
+@end
\ No newline at end of file
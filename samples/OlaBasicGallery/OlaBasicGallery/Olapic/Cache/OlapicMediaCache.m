@@ -0,0 +1,610 @@
+//
+//  OlapicMediaCache.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicMediaCache.h"
+#import "OlapicCachedMediaEntity.h"
+#import "OlapicEmbeddedResources.h"
+
+/**
+ *  The value types on the file
+ */
+typedef NS_ENUM(uint8_t, OlapicMediaCacheType){
+    OlapicMediaCacheTypeNull = 0,
+    OlapicMediaCacheTypeFalse = 1,
+    OlapicMediaCacheTypeTrue = 2,
+    OlapicMediaCacheTypeInteger = 3,
+    OlapicMediaCacheTypeDouble = 4,
+    OlapicMediaCacheTypeString = 5,
+    OlapicMediaCacheTypeArray = 6,
+    OlapicMediaCacheTypeDictionary = 7
+};
+/**
+ *  How deep the arrays and dictionaries can be nested
+ */
+static NSUInteger const OlapicMediaCacheMaxDepth = 64;
+/**
+ *  The file signature and format version
+ */
+static const char OlapicMediaCacheMagic[4] = {'O','L','P','C'};
+static const uint32_t OlapicMediaCacheVersion = 1;
+static const uint32_t OlapicMediaCacheHeaderLength = 24;
+
+/**
+ *  Append a little endian uint32 to a buffer
+ *
+ *  @param data  The buffer
+ *  @param value The value
+ */
+static void OlapicMediaCacheAppendUInt32(NSMutableData *data, uint32_t value){
+    uint32_t little = CFSwapInt32HostToLittle(value);
+    [data appendBytes:&little length:sizeof(little)];
+}
+
+@interface OlapicMediaCache()
+/**
+ *  Encode a value, adding its strings to the string table
+ *
+ *  @param value   The value
+ *  @param body    The buffer where the value goes
+ *  @param indexes The index of each string already on the table
+ *  @param list    The strings on the table
+ */
++(void)encodeValue:(id)value into:(NSMutableData *)body indexes:(NSMutableDictionary *)indexes strings:(NSMutableArray *)list;
+/**
+ *  Get the index of a string on the table, adding it if it's new
+ *
+ *  @param string  The string
+ *  @param indexes The index of each string already on the table
+ *  @param list    The strings on the table
+ *
+ *  @return The string index
+ */
++(uint32_t)indexForString:(NSString *)string indexes:(NSMutableDictionary *)indexes strings:(NSMutableArray *)list;
+/**
+ *  Read a uint32 from the file
+ *
+ *  @param offset The offset
+ *  @param value  A reference to save the value
+ *
+ *  @return NO if the offset is out of the file
+ */
+-(BOOL)readUInt32At:(NSUInteger)offset into:(uint32_t *)value;
+/**
+ *  Get the offset where a value ends
+ *
+ *  @param offset The offset of the value
+ *
+ *  @return The offset after the value, or NSNotFound if the value is not valid
+ */
+-(NSUInteger)skipValueAt:(NSUInteger)offset;
+/**
+ *  Read a value
+ *
+ *  @param offset  The offset of the value
+ *  @param mutable If a dictionary should be mutable
+ *  @param depth   How deep the value is
+ *
+ *  @return The value, or nil if it's not valid or nested too deep
+ */
+-(id)decodeValueAt:(NSUInteger)offset mutable:(BOOL)mutable depth:(NSUInteger)depth;
+/**
+ *  Get a string from the table, creating it only the first time
+ *
+ *  @param index The string index
+ *
+ *  @return The string
+ */
+-(NSString *)stringAtIndex:(uint32_t)index;
+/**
+ *  Compare a string from the table with some UTF-8 bytes, without
+ *  creating the string
+ *
+ *  @param index  The string index
+ *  @param bytes  The bytes to compare
+ *  @param length The number of bytes
+ *
+ *  @return If they are the same
+ */
+-(BOOL)stringAtIndex:(uint32_t)index matchesBytes:(const char *)bytes length:(NSUInteger)length;
+/**
+ *  Get the offset of an entity value
+ *
+ *  @param index The entity index
+ *
+ *  @return The offset, or NSNotFound if the index is not valid
+ */
+-(NSUInteger)offsetForRecord:(NSUInteger)index;
+/**
+ *  Check that every string and every record of the tables is
+ *  inside the file
+ *
+ *  @return NO if the file is not valid
+ */
+-(BOOL)validateTables;
+/**
+ *  Get the offset where a container ends
+ *
+ *  @param offset The offset of the container
+ *
+ *  @return The offset after the container, or NSNotFound if it's not inside the file
+ */
+-(NSUInteger)endOfContainerAt:(NSUInteger)offset;
+
+@end
+
+@implementation OlapicMediaCache
+#pragma mark - Writing
+/**
+ *  Write the data of a list of entities to a file
+ *
+ *  @param media The OlapicMediaEntity objects
+ *  @param path  The file path
+ *  @param error A reference to save the error, if the file can't be written
+ *
+ *  @return If the file was written
+ */
++(BOOL)writeMedia:(NSArray *)media toFile:(NSString *)path error:(NSError **)error{
+    NSMutableDictionary *indexes = [[NSMutableDictionary alloc] init];
+    NSMutableArray *list = [[NSMutableArray alloc] init];
+    NSMutableData *body = [[NSMutableData alloc] init];
+    NSMutableArray *recordOffsets = [[NSMutableArray alloc] initWithCapacity:[media count]];
+    for(OlapicEntity *entity in media){
+        [recordOffsets addObject:[NSNumber numberWithUnsignedInteger:[body length]]];
+        [self encodeValue:[OlapicEmbeddedResources completeDataForEntity:entity] into:body indexes:indexes strings:list];
+    }
+    uint32_t stringCount = (uint32_t)[list count];
+    uint32_t recordCount = (uint32_t)[recordOffsets count];
+    uint32_t stringTableOffset = OlapicMediaCacheHeaderLength;
+    uint32_t recordTableOffset = stringTableOffset + (stringCount * 8);
+    uint32_t stringsStart = recordTableOffset + (recordCount * 4);
+    NSMutableData *stringBytes = [[NSMutableData alloc] init];
+    NSMutableData *file = [[NSMutableData alloc] init];
+    [file appendBytes:OlapicMediaCacheMagic length:4];
+    OlapicMediaCacheAppendUInt32(file, OlapicMediaCacheVersion);
+    OlapicMediaCacheAppendUInt32(file, stringCount);
+    OlapicMediaCacheAppendUInt32(file, recordCount);
+    OlapicMediaCacheAppendUInt32(file, stringTableOffset);
+    OlapicMediaCacheAppendUInt32(file, recordTableOffset);
+    for(NSString *string in list){
+        NSData *utf8 = [string dataUsingEncoding:NSUTF8StringEncoding];
+        OlapicMediaCacheAppendUInt32(file, stringsStart + (uint32_t)[stringBytes length]);
+        OlapicMediaCacheAppendUInt32(file, (uint32_t)[utf8 length]);
+        [stringBytes appendData:utf8];
+    }
+    uint32_t bodyStart = stringsStart + (uint32_t)[stringBytes length];
+    for(NSNumber *offset in recordOffsets){
+        OlapicMediaCacheAppendUInt32(file, bodyStart + [offset unsignedIntValue]);
+    }
+    [file appendData:stringBytes];
+    [file appendData:body];
+    return [file writeToFile:path options:NSDataWritingAtomic error:error];
+}
+/**
+ *  Get the index of a string on the table, adding it if it's new
+ *
+ *  @param string  The string
+ *  @param indexes The index of each string already on the table
+ *  @param list    The strings on the table
+ *
+ *  @return The string index
+ */
++(uint32_t)indexForString:(NSString *)string indexes:(NSMutableDictionary *)indexes strings:(NSMutableArray *)list{
+    NSNumber *index = [indexes objectForKey:string];
+    if(!index){
+        index = [NSNumber numberWithUnsignedInteger:[list count]];
+        [indexes setObject:index forKey:string];
+        [list addObject:string];
+    }
+    return [index unsignedIntValue];
+}
+/**
+ *  Encode a value, adding its strings to the string table
+ *
+ *  @param value   The value
+ *  @param body    The buffer where the value goes
+ *  @param indexes The index of each string already on the table
+ *  @param list    The strings on the table
+ */
++(void)encodeValue:(id)value into:(NSMutableData *)body indexes:(NSMutableDictionary *)indexes strings:(NSMutableArray *)list{
+    uint8_t type;
+    if(!value || value == [NSNull null]){
+        type = OlapicMediaCacheTypeNull;
+        [body appendBytes:&type length:1];
+    }else if([value isKindOfClass:[NSNumber class]]){
+        const char *objCType = [value objCType];
+        if(CFGetTypeID((__bridge CFTypeRef)value) == CFBooleanGetTypeID()){
+            type = [value boolValue] ? OlapicMediaCacheTypeTrue : OlapicMediaCacheTypeFalse;
+            [body appendBytes:&type length:1];
+        }else if(strcmp(objCType, @encode(double)) == 0 || strcmp(objCType, @encode(float)) == 0){
+            type = OlapicMediaCacheTypeDouble;
+            CFSwappedFloat64 number = CFConvertDoubleHostToSwapped([value doubleValue]);
+            [body appendBytes:&type length:1];
+            [body appendBytes:&number length:sizeof(number)];
+        }else{
+            type = OlapicMediaCacheTypeInteger;
+            int64_t number = CFSwapInt64HostToLittle([value longLongValue]);
+            [body appendBytes:&type length:1];
+            [body appendBytes:&number length:sizeof(number)];
+        }
+    }else if([value isKindOfClass:[NSArray class]] || [value isKindOfClass:[NSDictionary class]]){
+        BOOL dictionary = [value isKindOfClass:[NSDictionary class]];
+        type = dictionary ? OlapicMediaCacheTypeDictionary : OlapicMediaCacheTypeArray;
+        [body appendBytes:&type length:1];
+        OlapicMediaCacheAppendUInt32(body, (uint32_t)[value count]);
+        NSUInteger lengthOffset = [body length];
+        OlapicMediaCacheAppendUInt32(body, 0);
+        if(dictionary){
+            for(id key in value){
+                OlapicMediaCacheAppendUInt32(body, [self indexForString:[key description] indexes:indexes strings:list]);
+                [self encodeValue:[value objectForKey:key] into:body indexes:indexes strings:list];
+            }
+        }else{
+            for(id item in value){
+                [self encodeValue:item into:body indexes:indexes strings:list];
+            }
+        }
+        uint32_t length = CFSwapInt32HostToLittle((uint32_t)([body length] - lengthOffset - 4));
+        [body replaceBytesInRange:NSMakeRange(lengthOffset, 4) withBytes:&length];
+    }else{
+        NSString *string = [value isKindOfClass:[NSString class]] ? value : [value description];
+        type = OlapicMediaCacheTypeString;
+        [body appendBytes:&type length:1];
+        OlapicMediaCacheAppendUInt32(body, [self indexForString:string indexes:indexes strings:list]);
+    }
+}
+#pragma mark - Reading
+/**
+ *  Class constructor. The file is memory mapped, only its string
+ *  and record tables are read to check they're inside the file
+ *
+ *  @param path  The file path
+ *  @param error A reference to save the error, if the file is not valid
+ *
+ *  @return An instance of this object (OlapicMediaCache), or nil if the file is not valid
+ */
+-(id)initWithContentsOfFile:(NSString *)path error:(NSError **)error{
+    self = [super init];
+    if(self){
+        buffer = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:error];
+        if(!buffer) return nil;
+        uint32_t version = 0;
+        BOOL valid = [buffer length] >= OlapicMediaCacheHeaderLength && memcmp([buffer bytes], OlapicMediaCacheMagic, 4) == 0;
+        valid = valid && [self readUInt32At:4 into:&version] && version == OlapicMediaCacheVersion;
+        valid = valid && [self readUInt32At:8 into:&stringCount] && [self readUInt32At:12 into:&recordCount];
+        valid = valid && [self readUInt32At:16 into:&stringTableOffset] && [self readUInt32At:20 into:&recordTableOffset];
+        valid = valid && (uint64_t)stringTableOffset + (uint64_t)stringCount * 8 <= [buffer length];
+        valid = valid && (uint64_t)recordTableOffset + (uint64_t)recordCount * 4 <= [buffer length];
+        valid = valid && [self validateTables];
+        if(!valid){
+            if(error) *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadCorruptFileError userInfo:@{NSFilePathErrorKey: path}];
+            return nil;
+        }
+        strings = [NSPointerArray strongObjectsPointerArray];
+        strings.count = stringCount;
+    }
+    return self;
+}
+/**
+ *  Check that every string and every record of the tables is
+ *  inside the file
+ *
+ *  @return NO if the file is not valid
+ */
+-(BOOL)validateTables{
+    uint32_t offset = 0, length = 0;
+    for(uint32_t i = 0; i < stringCount; i++){
+        if(![self readUInt32At:stringTableOffset + (i * 8) into:&offset] || ![self readUInt32At:stringTableOffset + (i * 8) + 4 into:&length]) return NO;
+        if((uint64_t)offset + length > [buffer length]) return NO;
+    }
+    for(uint32_t i = 0; i < recordCount; i++){
+        if(![self readUInt32At:recordTableOffset + (i * 4) into:&offset]) return NO;
+        if(offset >= [buffer length] || ((const uint8_t *)[buffer bytes])[offset] != OlapicMediaCacheTypeDictionary) return NO;
+        if([self endOfContainerAt:offset] == NSNotFound) return NO;
+    }
+    return YES;
+}
+/**
+ *  Get the number of entities on the file
+ *
+ *  @return The number of entities
+ */
+-(NSUInteger)count{
+    return recordCount;
+}
+/**
+ *  Get a media entity that reads its data from the file when it's needed
+ *
+ *  @param index The entity index
+ *
+ *  @return An OlapicCachedMediaEntity
+ */
+-(OlapicMediaEntity *)mediaAtIndex:(NSUInteger)index{
+    if(index >= recordCount) return nil;
+    return [[OlapicCachedMediaEntity alloc] initWithCache:self index:index];
+}
+/**
+ *  Get all the media entities on the file (it doesn't read their data)
+ *
+ *  @return An array of OlapicCachedMediaEntity objects
+ */
+-(NSArray *)allMedia{
+    NSMutableArray *media = [[NSMutableArray alloc] initWithCapacity:recordCount];
+    for(NSUInteger i = 0; i < recordCount; i++){
+        [media addObject:[self mediaAtIndex:i]];
+    }
+    return media;
+}
+/**
+ *  Read a single value from an entity, without reading the rest
+ *
+ *  @param path  The navigation path, using slashes like OlapicEntity's get: (key1/key2/value)
+ *  @param index The entity index
+ *
+ *  @return The value, or nil if the path doesn't exist
+ */
+-(id)valueAtPath:(NSString *)path forRecord:(NSUInteger)index{
+    NSUInteger offset = [self offsetForRecord:index];
+    const uint8_t *bytes = [buffer bytes];
+    for(NSString *component in [path componentsSeparatedByString:@"/"]){
+        if(offset == NSNotFound || offset >= [buffer length]) return nil;
+        if(![component length]) continue;
+        uint8_t type = bytes[offset];
+        if(type != OlapicMediaCacheTypeDictionary && type != OlapicMediaCacheTypeArray) return nil;
+        uint32_t count = 0;
+        NSUInteger end = [self endOfContainerAt:offset];
+        if(end == NSNotFound || ![self readUInt32At:offset + 1 into:&count]) return nil;
+        NSUInteger cursor = offset + 9;
+        offset = NSNotFound;
+        if(type == OlapicMediaCacheTypeDictionary){
+            const char *key = [component UTF8String];
+            NSUInteger keyLength = strlen(key);
+            for(uint32_t i = 0; i < count && cursor != NSNotFound; i++){
+                uint32_t keyIndex = 0;
+                // Every entry has to be inside its dictionary
+                if(cursor + 4 >= end || ![self readUInt32At:cursor into:&keyIndex]) return nil;
+                if([self stringAtIndex:keyIndex matchesBytes:key length:keyLength]){
+                    offset = cursor + 4;
+                    break;
+                }
+                cursor = [self skipValueAt:cursor + 4];
+                if(cursor != NSNotFound && cursor > end) return nil;
+            }
+        }else{
+            NSInteger item = [component integerValue];
+            if(item < 0 || item >= count) return nil;
+            for(NSInteger i = 0; i < item && cursor != NSNotFound; i++){
+                cursor = [self skipValueAt:cursor];
+            }
+            if(cursor != NSNotFound && cursor >= end) return nil;
+            offset = cursor;
+        }
+    }
+    if(offset == NSNotFound || [self skipValueAt:offset] == NSNotFound) return nil;
+    return [self decodeValueAt:offset mutable:NO depth:0];
+}
+/**
+ *  Read all the data of an entity
+ *
+ *  @param index The entity index
+ *
+ *  @return The entity data
+ */
+-(NSMutableDictionary *)dictionaryForRecord:(NSUInteger)index{
+    NSUInteger offset = [self offsetForRecord:index];
+    if(offset == NSNotFound) return nil;
+    id value = [self decodeValueAt:offset mutable:YES depth:0];
+    return [value isKindOfClass:[NSMutableDictionary class]] ? value : nil;
+}
+/**
+ *  Get the offset of an entity value
+ *
+ *  @param index The entity index
+ *
+ *  @return The offset, or NSNotFound if the index is not valid
+ */
+-(NSUInteger)offsetForRecord:(NSUInteger)index{
+    uint32_t offset = 0;
+    if(index >= recordCount || ![self readUInt32At:recordTableOffset + (index * 4) into:&offset] || offset >= [buffer length]){
+        return NSNotFound;
+    }
+    return offset;
+}
+/**
+ *  Read a uint32 from the file
+ *
+ *  @param offset The offset
+ *  @param value  A reference to save the value
+ *
+ *  @return NO if the offset is out of the file
+ */
+-(BOOL)readUInt32At:(NSUInteger)offset into:(uint32_t *)value{
+    if(offset + 4 > [buffer length]) return NO;
+    uint32_t little;
+    memcpy(&little, (const uint8_t *)[buffer bytes] + offset, 4);
+    *value = CFSwapInt32LittleToHost(little);
+    return YES;
+}
+/**
+ *  Get the offset where a value ends
+ *
+ *  @param offset The offset of the value
+ *
+ *  @return The offset after the value, or NSNotFound if the value is not valid
+ */
+-(NSUInteger)skipValueAt:(NSUInteger)offset{
+    if(offset >= [buffer length]) return NSNotFound;
+    NSUInteger end;
+    switch(((const uint8_t *)[buffer bytes])[offset]){
+        case OlapicMediaCacheTypeNull:
+        case OlapicMediaCacheTypeFalse:
+        case OlapicMediaCacheTypeTrue:
+            end = offset + 1;
+            break;
+        case OlapicMediaCacheTypeInteger:
+        case OlapicMediaCacheTypeDouble:
+            end = offset + 9;
+            break;
+        case OlapicMediaCacheTypeString:
+            end = offset + 5;
+            break;
+        case OlapicMediaCacheTypeArray:
+        case OlapicMediaCacheTypeDictionary:
+            return [self endOfContainerAt:offset];
+        default:
+            return NSNotFound;
+    }
+    return end <= [buffer length] ? end : NSNotFound;
+}
+/**
+ *  Get the offset where a container ends
+ *
+ *  @param offset The offset of the container
+ *
+ *  @return The offset after the container, or NSNotFound if it's not inside the file
+ */
+-(NSUInteger)endOfContainerAt:(NSUInteger)offset{
+    uint32_t length = 0;
+    if(![self readUInt32At:offset + 5 into:&length]) return NSNotFound;
+    uint64_t end = (uint64_t)offset + 9 + length;
+    return end <= [buffer length] ? (NSUInteger)end : NSNotFound;
+}
+/**
+ *  Read a value
+ *
+ *  @param offset  The offset of the value
+ *  @param mutable If a dictionary should be mutable
+ *  @param depth   How deep the value is
+ *
+ *  @return The value, or nil if it's not valid or nested too deep
+ */
+-(id)decodeValueAt:(NSUInteger)offset mutable:(BOOL)mutable depth:(NSUInteger)depth{
+    // The file can be corrupt, the nesting can't be trusted to end
+    if(offset >= [buffer length] || depth > OlapicMediaCacheMaxDepth) return nil;
+    const uint8_t *bytes = [buffer bytes];
+    uint32_t count = 0, index = 0;
+    switch(bytes[offset]){
+        case OlapicMediaCacheTypeNull:
+            return [NSNull null];
+        case OlapicMediaCacheTypeFalse:
+            return [NSNumber numberWithBool:NO];
+        case OlapicMediaCacheTypeTrue:
+            return [NSNumber numberWithBool:YES];
+        case OlapicMediaCacheTypeInteger:{
+            if(offset + 9 > [buffer length]) return nil;
+            int64_t number;
+            memcpy(&number, bytes + offset + 1, 8);
+            return [NSNumber numberWithLongLong:(int64_t)CFSwapInt64LittleToHost(number)];
+        }
+        case OlapicMediaCacheTypeDouble:{
+            if(offset + 9 > [buffer length]) return nil;
+            CFSwappedFloat64 number;
+            memcpy(&number, bytes + offset + 1, 8);
+            return [NSNumber numberWithDouble:CFConvertDoubleSwappedToHost(number)];
+        }
+        case OlapicMediaCacheTypeString:
+            if(![self readUInt32At:offset + 1 into:&index]) return nil;
+            return [self stringAtIndex:index];
+        case OlapicMediaCacheTypeArray:{
+            NSUInteger end = [self endOfContainerAt:offset];
+            if(end == NSNotFound || ![self readUInt32At:offset + 1 into:&count]) return nil;
+            // The count comes from the file, it can't reserve more than the bytes allow
+            NSMutableArray *array = [[NSMutableArray alloc] initWithCapacity:MIN(count, end - offset)];
+            NSUInteger cursor = offset + 9;
+            for(uint32_t i = 0; i < count; i++){
+                id item = cursor < end ? [self decodeValueAt:cursor mutable:NO depth:depth + 1] : nil;
+                if(!item) return nil;
+                [array addObject:item];
+                cursor = [self skipValueAt:cursor];
+            }
+            // The items have to fill the array exactly
+            return cursor == end ? array : nil;
+        }
+        case OlapicMediaCacheTypeDictionary:{
+            NSUInteger end = [self endOfContainerAt:offset];
+            if(end == NSNotFound || ![self readUInt32At:offset + 1 into:&count]) return nil;
+            NSMutableDictionary *dictionary = [[NSMutableDictionary alloc] initWithCapacity:MIN(count, end - offset)];
+            NSUInteger cursor = offset + 9;
+            for(uint32_t i = 0; i < count; i++){
+                if(cursor == NSNotFound || cursor + 4 >= end || ![self readUInt32At:cursor into:&index]) return nil;
+                NSString *key = [self stringAtIndex:index];
+                id value = [self decodeValueAt:cursor + 4 mutable:NO depth:depth + 1];
+                if(!key || !value) return nil;
+                [dictionary setObject:value forKey:key];
+                cursor = [self skipValueAt:cursor + 4];
+            }
+            if(cursor != end) return nil;
+            return mutable ? dictionary : [dictionary copy];
+        }
+        default:
+            return nil;
+    }
+}
+/**
+ *  Get a string from the table, creating it only the first time
+ *
+ *  @param index The string index
+ *
+ *  @return The string
+ */
+-(NSString *)stringAtIndex:(uint32_t)index{
+    if(index >= stringCount) return nil;
+    @synchronized(strings){
+        NSString *string = (__bridge NSString *)[strings pointerAtIndex:index];
+        if(string) return string;
+        uint32_t offset = 0, length = 0;
+        if(![self readUInt32At:stringTableOffset + (index * 8) into:&offset] || ![self readUInt32At:stringTableOffset + (index * 8) + 4 into:&length]) return nil;
+        if((uint64_t)offset + length > [buffer length]) return nil;
+        string = [[NSString alloc] initWithBytes:(const uint8_t *)[buffer bytes] + offset length:length encoding:NSUTF8StringEncoding];
+        [strings replacePointerAtIndex:index withPointer:(__bridge void *)string];
+        return string;
+    }
+}
+/**
+ *  Compare a string from the table with some UTF-8 bytes, without
+ *  creating the string
+ *
+ *  @param index  The string index
+ *  @param bytes  The bytes to compare
+ *  @param length The number of bytes
+ *
+ *  @return If they are the same
+ */
+-(BOOL)stringAtIndex:(uint32_t)index matchesBytes:(const char *)bytes length:(NSUInteger)length{
+    uint32_t offset = 0, stringLength = 0;
+    if(index >= stringCount || ![self readUInt32At:stringTableOffset + (index * 8) into:&offset] || ![self readUInt32At:stringTableOffset + (index * 8) + 4 into:&stringLength]){
+        return NO;
+    }
+    if(stringLength != length || (uint64_t)offset + length > [buffer length]) return NO;
+    return memcmp((const uint8_t *)[buffer bytes] + offset, bytes, length) == 0;
+}
+
+@end
\ No newline at end of file
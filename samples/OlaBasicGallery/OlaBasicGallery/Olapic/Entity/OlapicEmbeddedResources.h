@@ -0,0 +1,119 @@
+//
+//  OlapicEmbeddedResources.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+/**
+ *  The '_embedded' resources of an entity, kept as the raw JSON from
+ *  the response. The SDK handlers convert all the embedded resources
+ *  when an entity is created, but most of them are never used, so
+ *  OlapicIdentityMap removes them from the JSON before creating the
+ *  entity and attaches them with this object.
+ *
+ *  A resource becomes an entity the first time it's requested.
+ */
+@interface OlapicEmbeddedResources : NSObject{
+    /**
+     *  The raw '_embedded' object
+     */
+    NSDictionary *raw;
+    /**
+     *  The resources already converted, by name
+     */
+    NSMutableDictionary *resolved;
+}
+
+@property (nonatomic,strong,readonly) NSDictionary *raw;
+/**
+ *  Class constructor
+ *
+ *  @param embedded The raw '_embedded' object
+ *
+ *  @return An instance of this object (OlapicEmbeddedResources)
+ */
+-(id)initWithJSON:(NSDictionary *)embedded;
+/**
+ *  Attach the raw resources to an entity
+ *
+ *  @param embedded The raw '_embedded' object
+ *  @param entity   The entity
+ */
++(void)attachResources:(NSDictionary *)embedded toEntity:(OlapicEntity *)entity;
+/**
+ *  Get the resources attached to an entity
+ *
+ *  @param entity The entity
+ *
+ *  @return The resources, or nil if the entity doesn't have any
+ */
++(OlapicEmbeddedResources *)resourcesForEntity:(OlapicEntity *)entity;
+/**
+ *  Get the entity data with its raw resources back on the '_embedded'
+ *  key, without changing the entity (for example, to save it)
+ *
+ *  @param entity The entity
+ *
+ *  @return The complete entity data
+ */
++(NSDictionary *)completeDataForEntity:(OlapicEntity *)entity;
+/**
+ *  Put the raw resources back on the entity data, for the SDK methods
+ *  that read them (like getUploader: or getRelatedStreams:)
+ *
+ *  @param entity The entity
+ */
++(void)restoreResourcesForEntity:(OlapicEntity *)entity;
+/**
+ *  Get the names of the embedded resources
+ *
+ *  @return An array of strings
+ */
+-(NSArray *)resourceNames;
+/**
+ *  Get the raw JSON of a resource, without converting it
+ *
+ *  @param name The resource name (like 'uploader')
+ *
+ *  @return The JSON object, or nil if there's no resource with that name
+ */
+-(id)rawResourceNamed:(NSString *)name;
+/**
+ *  Get a resource entity, creating it the first time
+ *
+ *  @param name    The resource name (like 'uploader')
+ *  @param handler The SDK handler for the resource type
+ *
+ *  @return The entity (or an array of entities, if the resource is a list)
+ */
+-(id)resourceNamed:(NSString *)name withHandler:(OlapicHandler *)handler;
+
+@end
\ No newline at end of file
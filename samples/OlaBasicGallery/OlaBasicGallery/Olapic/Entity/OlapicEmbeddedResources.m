@@ -0,0 +1,156 @@
+//
+//  OlapicEmbeddedResources.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicEmbeddedResources.h"
+#import "OlapicIdentityMap.h"
+#import <objc/runtime.h>
+
+/**
+ *  The key for the associated object on the entities
+ */
+static char OlapicEmbeddedResourcesKey;
+
+@implementation OlapicEmbeddedResources
+
+@synthesize raw;
+/**
+ *  Class constructor
+ *
+ *  @param embedded The raw '_embedded' object
+ *
+ *  @return An instance of this object (OlapicEmbeddedResources)
+ */
+-(id)initWithJSON:(NSDictionary *)embedded{
+    self = [super init];
+    if(self){
+        raw = embedded;
+        resolved = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+/**
+ *  Attach the raw resources to an entity
+ *
+ *  @param embedded The raw '_embedded' object
+ *  @param entity   The entity
+ */
++(void)attachResources:(NSDictionary *)embedded toEntity:(OlapicEntity *)entity{
+    if(!entity) return;
+    OlapicEmbeddedResources *resources = [embedded isKindOfClass:[NSDictionary class]] ? [[OlapicEmbeddedResources alloc] initWithJSON:embedded] : nil;
+    objc_setAssociatedObject(entity, &OlapicEmbeddedResourcesKey, resources, OBJC_ASSOCIATION_RETAIN);
+}
+/**
+ *  Get the resources attached to an entity
+ *
+ *  @param entity The entity
+ *
+ *  @return The resources, or nil if the entity doesn't have any
+ */
++(OlapicEmbeddedResources *)resourcesForEntity:(OlapicEntity *)entity{
+    if(!entity) return nil;
+    return objc_getAssociatedObject(entity, &OlapicEmbeddedResourcesKey);
+}
+/**
+ *  Get the entity data with its raw resources back on the '_embedded'
+ *  key, without changing the entity (for example, to save it)
+ *
+ *  @param entity The entity
+ *
+ *  @return The complete entity data
+ */
++(NSDictionary *)completeDataForEntity:(OlapicEntity *)entity{
+    OlapicEmbeddedResources *resources = [OlapicEmbeddedResources resourcesForEntity:entity];
+    if(!resources || [entity.data objectForKey:@"_embedded"]) return entity.data;
+    NSMutableDictionary *values = [entity.data mutableCopy];
+    [values setObject:resources.raw forKey:@"_embedded"];
+    return values;
+}
+/**
+ *  Put the raw resources back on the entity data, for the SDK methods
+ *  that read them (like getUploader: or getRelatedStreams:)
+ *
+ *  @param entity The entity
+ */
++(void)restoreResourcesForEntity:(OlapicEntity *)entity{
+    OlapicEmbeddedResources *resources = [OlapicEmbeddedResources resourcesForEntity:entity];
+    if(resources && entity.data && ![entity.data objectForKey:@"_embedded"]){
+        [entity.data setObject:resources.raw forKey:@"_embedded"];
+    }
+}
+/**
+ *  Get the names of the embedded resources
+ *
+ *  @return An array of strings
+ */
+-(NSArray *)resourceNames{
+    return [raw allKeys];
+}
+/**
+ *  Get the raw JSON of a resource, without converting it
+ *
+ *  @param name The resource name (like 'uploader')
+ *
+ *  @return The JSON object, or nil if there's no resource with that name
+ */
+-(id)rawResourceNamed:(NSString *)name{
+    return [raw objectForKey:name];
+}
+/**
+ *  Get a resource entity, creating it the first time
+ *
+ *  @param name    The resource name (like 'uploader')
+ *  @param handler The SDK handler for the resource type
+ *
+ *  @return The entity (or an array of entities, if the resource is a list)
+ */
+-(id)resourceNamed:(NSString *)name withHandler:(OlapicHandler *)handler{
+    @synchronized(self){
+        id resource = [resolved objectForKey:name];
+        if(resource) return resource;
+        id JSON = [raw objectForKey:name];
+        OlapicIdentityMap *identityMap = [OlapicIdentityMap sharedMap];
+        if([JSON isKindOfClass:[NSArray class]]){
+            NSMutableArray *items = [[NSMutableArray alloc] initWithCapacity:[JSON count]];
+            for(id item in JSON){
+                id entity = [item isKindOfClass:[NSDictionary class]] ? [identityMap entityFromJSON:item withHandler:handler] : nil;
+                if(entity) [items addObject:entity];
+            }
+            resource = items;
+        }else if([JSON isKindOfClass:[NSDictionary class]]){
+            resource = [identityMap entityFromJSON:JSON withHandler:handler];
+        }
+        if(resource) [resolved setObject:resource forKey:name];
+        return resource;
+    }
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,92 @@
+//
+//  OlapicEntityInterner.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+/**
+ *  Strings longer than this are not interned (captions, URLs, etc.
+ *  are rarely repeated)
+ */
+static NSUInteger const OlapicEntityInternerMaxStringLength = 128;
+/**
+ *  Removes the duplicated content between the entities before they are
+ *  created: the dictionary keys and the short values (sources, types,
+ *  dates, etc.) point to a single string instance, and all the media
+ *  from the same uploader share the same uploader data. The entities
+ *  themselves are shared by OlapicIdentityMap.
+ *
+ *  Everything is weakly referenced, so the shared values go away with
+ *  the last entity that uses them. It's safe to use from multiple threads.
+ */
+@interface OlapicEntityInterner : NSObject{
+    /**
+     *  The canonical instance of each string
+     */
+    NSHashTable *strings;
+    /**
+     *  The uploader data, by uploader ID
+     */
+    NSMapTable *uploaderData;
+}
+/**
+ *  Get the interner shared by all the lists
+ *
+ *  @return The shared instance of OlapicEntityInterner
+ */
++(OlapicEntityInterner *)sharedInterner;
+/**
+ *  Get the canonical instance of a string
+ *
+ *  @param string The string
+ *
+ *  @return An equal string, shared with the rest of the entities
+ */
+-(NSString *)internString:(NSString *)string;
+/**
+ *  Copy a JSON object, replacing the strings with their canonical
+ *  instances and the uploader objects with their shared data
+ *
+ *  @param JSON The JSON object
+ *
+ *  @return The interned JSON object
+ */
+-(id)internJSON:(id)JSON;
+/**
+ *  Get the ID of an entity JSON object
+ *
+ *  @param JSON The JSON object
+ *
+ *  @return The ID as a string, or nil if it doesn't have one
+ */
++(NSString *)identifierForJSON:(NSDictionary *)JSON;
+
+@end
\ No newline at end of file
@@ -0,0 +1,166 @@
+//
+//  OlapicEntityInterner.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicEntityInterner.h"
+
+@interface OlapicEntityInterner()
+/**
+ *  Copy a JSON object, replacing the strings with their canonical
+ *  instances and the uploader objects with their shared data
+ *
+ *  @param JSON The JSON object
+ *  @param key  The key of the object on its parent dictionary
+ *
+ *  @return The interned JSON object
+ */
+-(id)internJSON:(id)JSON forKey:(NSString *)key;
+
+@end
+
+@implementation OlapicEntityInterner
+/**
+ *  Get the interner shared by all the lists
+ *
+ *  @return The shared instance of OlapicEntityInterner
+ */
++(OlapicEntityInterner *)sharedInterner{
+    static OlapicEntityInterner *sharedInterner = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedInterner = [[OlapicEntityInterner alloc] init];
+    });
+    return sharedInterner;
+}
+/**
+ *  Class constructor
+ *
+ *  @return An instance of this object (OlapicEntityInterner)
+ */
+-(id)init{
+    self = [super init];
+    if(self){
+        strings = [NSHashTable weakObjectsHashTable];
+        uploaderData = [NSMapTable strongToWeakObjectsMapTable];
+    }
+    return self;
+}
+/**
+ *  Get the canonical instance of a string
+ *
+ *  @param string The string
+ *
+ *  @return An equal string, shared with the rest of the entities
+ */
+-(NSString *)internString:(NSString *)string{
+    if([string length] > OlapicEntityInternerMaxStringLength) return string;
+    @synchronized(strings){
+        NSString *canonical = [strings member:string];
+        if(canonical) return canonical;
+        // The JSON strings can be mutable
+        canonical = [string copy];
+        [strings addObject:canonical];
+        return canonical;
+    }
+}
+/**
+ *  Copy a JSON object, replacing the strings with their canonical
+ *  instances and the uploader objects with their shared data
+ *
+ *  @param JSON The JSON object
+ *
+ *  @return The interned JSON object
+ */
+-(id)internJSON:(id)JSON{
+    return [self internJSON:JSON forKey:nil];
+}
+/**
+ *  Copy a JSON object, replacing the strings with their canonical
+ *  instances and the uploader objects with their shared data
+ *
+ *  @param JSON The JSON object
+ *  @param key  The key of the object on its parent dictionary
+ *
+ *  @return The interned JSON object
+ */
+-(id)internJSON:(id)JSON forKey:(NSString *)key{
+    if([JSON isKindOfClass:[NSString class]]){
+        return [self internString:JSON];
+    }
+    if([JSON isKindOfClass:[NSArray class]]){
+        NSMutableArray *items = [[NSMutableArray alloc] initWithCapacity:[JSON count]];
+        for(id item in JSON){
+            [items addObject:[self internJSON:item forKey:nil]];
+        }
+        return items;
+    }
+    if(![JSON isKindOfClass:[NSDictionary class]]){
+        return JSON;
+    }
+    NSString *uploaderID = [key isEqualToString:@"uploader"] ? [OlapicEntityInterner identifierForJSON:JSON] : nil;
+    if(uploaderID){
+        @synchronized(uploaderData){
+            NSDictionary *shared = [uploaderData objectForKey:uploaderID];
+            if(shared) return shared;
+        }
+    }
+    NSMutableDictionary *dictionary = [[NSMutableDictionary alloc] initWithCapacity:[JSON count]];
+    for(NSString *entryKey in JSON){
+        NSString *internedKey = [entryKey isKindOfClass:[NSString class]] ? [self internString:entryKey] : entryKey;
+        [dictionary setObject:[self internJSON:[JSON objectForKey:entryKey] forKey:internedKey] forKey:internedKey];
+    }
+    if(uploaderID){
+        // Shared data can't be mutable
+        NSDictionary *shared = [dictionary copy];
+        @synchronized(uploaderData){
+            NSDictionary *existing = [uploaderData objectForKey:uploaderID];
+            if(existing) return existing;
+            [uploaderData setObject:shared forKey:uploaderID];
+        }
+        return shared;
+    }
+    return dictionary;
+}
+/**
+ *  Get the ID of an entity JSON object
+ *
+ *  @param JSON The JSON object
+ *
+ *  @return The ID as a string, or nil if it doesn't have one
+ */
++(NSString *)identifierForJSON:(NSDictionary *)JSON{
+    if(![JSON isKindOfClass:[NSDictionary class]]) return nil;
+    id identifier = [JSON objectForKey:@"id"];
+    if([identifier isKindOfClass:[NSNumber class]]) return [identifier stringValue];
+    return [identifier isKindOfClass:[NSString class]] && [identifier length] ? identifier : nil;
+}
+
+@end
\ No newline at end of file
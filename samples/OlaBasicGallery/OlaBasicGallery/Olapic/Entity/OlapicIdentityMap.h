@@ -0,0 +1,119 @@
+//
+//  OlapicIdentityMap.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+/**
+ *  Keeps a single live instance for each entity, by type and ID, so
+ *  the same media or uploader showing up on different lists (or on
+ *  getUploader: results) is always the same object.
+ *
+ *  When an entity that already exists arrives again, its data is
+ *  updated in place instead of creating a new one. The map doesn't
+ *  retain the entities: they go away with the last object using them.
+ *
+ *  The '_embedded' resources are not converted when the entities are
+ *  created: they are attached as OlapicEmbeddedResources, and the
+ *  uploader is created the first time it's requested.
+ */
+@interface OlapicIdentityMap : NSObject{
+    /**
+     *  The live entities, by 'type/ID'
+     */
+    NSMapTable *entities;
+    /**
+     *  The callbacks waiting for the uploader requests that are
+     *  running, by media
+     */
+    NSMapTable *uploaderRequests;
+}
+/**
+ *  Get the identity map shared by all the lists
+ *
+ *  @return The shared instance of OlapicIdentityMap
+ */
++(OlapicIdentityMap *)sharedMap;
+/**
+ *  Get the live entity of a given type and ID
+ *
+ *  @param type       The entity class (OlapicMediaEntity, OlapicUploaderEntity, etc.)
+ *  @param identifier The entity ID
+ *
+ *  @return The entity, or nil if there's none
+ */
+-(id)entityOfType:(Class)type identifier:(NSString *)identifier;
+/**
+ *  Add an entity to the map
+ *
+ *  @param entity The entity
+ *
+ *  @return The live instance for the entity ID (updated with the data
+ *          of the given entity), or the same entity if it's the first one
+ */
+-(id)registerEntity:(OlapicEntity *)entity;
+/**
+ *  Get the entity for an API JSON object. The strings are interned and,
+ *  if the entity already exists, it's updated instead of creating a
+ *  new one. It can be called from any thread, the updates are made on
+ *  the main thread
+ *
+ *  @param JSON    The entity JSON object
+ *  @param handler The SDK handler for the entity type
+ *
+ *  @return The entity
+ */
+-(id)entityFromJSON:(NSDictionary *)JSON withHandler:(OlapicHandler *)handler;
+/**
+ *  Get the entity for a JSON object already copied by the
+ *  OlapicEntityInterner. If the entity already exists, it's updated
+ *  instead of creating a new one. Unlike the interning, the lookup
+ *  and the update aren't meant to run on many threads at once
+ *
+ *  @param values  The interned JSON object (it's changed)
+ *  @param handler The SDK handler for the entity type
+ *
+ *  @return The entity
+ */
+-(id)entityFromInternedJSON:(NSMutableDictionary *)values withHandler:(OlapicHandler *)handler;
+/**
+ *  Get the uploader of a media. If the media already has its uploader,
+ *  or there's a live instance of it, it doesn't make a request, and if
+ *  the uploader of the media is already being requested it waits for
+ *  that request. It should be called on the main thread
+ *
+ *  @param media   The media entity
+ *  @param success The success callback, with the shared uploader
+ *  @param failure The failure callback
+ */
+-(void)getUploaderForMedia:(OlapicMediaEntity *)media onSuccess:(void (^)(OlapicUploaderEntity *uploader))success onFailure:(void (^)(NSError *error))failure;
+
+@end
\ No newline at end of file
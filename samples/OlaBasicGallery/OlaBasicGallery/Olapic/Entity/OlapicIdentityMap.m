@@ -0,0 +1,336 @@
+//
+//  OlapicIdentityMap.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicIdentityMap.h"
+#import "OlapicEntityInterner.h"
+#import "OlapicEmbeddedResources.h"
+
+@interface OlapicIdentityMap()
+/**
+ *  Get the entity class created by a handler
+ *
+ *  @param handler The SDK handler
+ *
+ *  @return The entity class, or Nil if its entities are not shared
+ */
++(Class)entityTypeForHandler:(OlapicHandler *)handler;
+/**
+ *  Get the entity class used as the type of an entity (so the
+ *  subclasses share the IDs with their SDK class)
+ *
+ *  @param entity The entity
+ *
+ *  @return The entity class
+ */
++(Class)entityTypeForEntity:(OlapicEntity *)entity;
+/**
+ *  Get the map key of an entity
+ *
+ *  @param type       The entity class
+ *  @param identifier The entity ID
+ *
+ *  @return The key
+ */
++(NSString *)keyForType:(Class)type identifier:(NSString *)identifier;
+/**
+ *  Merge the data of an entity. The top level keys are merged, so the
+ *  fields a list didn't ask for are kept, and so are the '_embedded'
+ *  and '_links' resources the new data doesn't have. Any other value,
+ *  dictionaries included, is replaced whole, so the keys the server
+ *  removed from it go away
+ *
+ *  @param values   The new values
+ *  @param existing The current values
+ *
+ *  @return The merged object
+ */
++(id)mergeValues:(id)values into:(id)existing;
+/**
+ *  Update the data of a live entity, on the main thread. The new values
+ *  are merged, so a list that only keeps some fields doesn't remove
+ *  the rest
+ *
+ *  @param entity The live entity
+ *  @param values The new data
+ */
+-(void)updateEntity:(OlapicEntity *)entity withData:(NSDictionary *)values;
+
+@end
+
+@implementation OlapicIdentityMap
+/**
+ *  Get the identity map shared by all the lists
+ *
+ *  @return The shared instance of OlapicIdentityMap
+ */
++(OlapicIdentityMap *)sharedMap{
+    static OlapicIdentityMap *sharedMap = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedMap = [[OlapicIdentityMap alloc] init];
+    });
+    return sharedMap;
+}
+/**
+ *  Class constructor
+ *
+ *  @return An instance of this object (OlapicIdentityMap)
+ */
+-(id)init{
+    self = [super init];
+    if(self){
+        entities = [NSMapTable strongToWeakObjectsMapTable];
+        uploaderRequests = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+    }
+    return self;
+}
+/**
+ *  Get the live entity of a given type and ID
+ *
+ *  @param type       The entity class (OlapicMediaEntity, OlapicUploaderEntity, etc.)
+ *  @param identifier The entity ID
+ *
+ *  @return The entity, or nil if there's none
+ */
+-(id)entityOfType:(Class)type identifier:(NSString *)identifier{
+    if(!type || !identifier) return nil;
+    @synchronized(entities){
+        return [entities objectForKey:[OlapicIdentityMap keyForType:type identifier:identifier]];
+    }
+}
+/**
+ *  Add an entity to the map
+ *
+ *  @param entity The entity
+ *
+ *  @return The live instance for the entity ID (updated with the data
+ *          of the given entity), or the same entity if it's the first one
+ */
+-(id)registerEntity:(OlapicEntity *)entity{
+    NSString *identifier = [OlapicEntityInterner identifierForJSON:entity.data];
+    if(!entity || !identifier) return entity;
+    NSString *key = [OlapicIdentityMap keyForType:[OlapicIdentityMap entityTypeForEntity:entity] identifier:identifier];
+    OlapicEntity *existing;
+    @synchronized(entities){
+        existing = [entities objectForKey:key];
+        if(!existing){
+            [entities setObject:entity forKey:key];
+            return entity;
+        }
+    }
+    if(existing != entity){
+        [self updateEntity:existing withData:entity.data];
+    }
+    return existing;
+}
+/**
+ *  Get the entity for an API JSON object. The strings are interned and,
+ *  if the entity already exists, it's updated instead of creating a
+ *  new one. It can be called from any thread, the updates are made on
+ *  the main thread
+ *
+ *  @param JSON    The entity JSON object
+ *  @param handler The SDK handler for the entity type
+ *
+ *  @return The entity
+ */
+-(id)entityFromJSON:(NSDictionary *)JSON withHandler:(OlapicHandler *)handler{
+    return [self entityFromInternedJSON:[[OlapicEntityInterner sharedInterner] internJSON:JSON] withHandler:handler];
+}
+/**
+ *  Get the entity for a JSON object already copied by the
+ *  OlapicEntityInterner. If the entity already exists, it's updated
+ *  instead of creating a new one. Unlike the interning, the lookup
+ *  and the update aren't meant to run on many threads at once
+ *
+ *  @param values  The interned JSON object (it's changed)
+ *  @param handler The SDK handler for the entity type
+ *
+ *  @return The entity
+ */
+-(id)entityFromInternedJSON:(NSMutableDictionary *)values withHandler:(OlapicHandler *)handler{
+    // The embedded resources are converted when they're needed
+    NSDictionary *embedded = [values objectForKey:@"_embedded"];
+    [values removeObjectForKey:@"_embedded"];
+    OlapicEntity *existing = [self entityOfType:[OlapicIdentityMap entityTypeForHandler:handler] identifier:[OlapicEntityInterner identifierForJSON:values]];
+    if(existing){
+        [self updateEntity:existing withData:values];
+        if(embedded) [OlapicEmbeddedResources attachResources:embedded toEntity:existing];
+        return existing;
+    }
+    id entity = [handler createEntityFromJSON:values];
+    [OlapicEmbeddedResources attachResources:embedded toEntity:entity];
+    return [self registerEntity:entity];
+}
+/**
+ *  Get the uploader of a media. If the media already has its uploader,
+ *  or there's a live instance of it, it doesn't make a request, and if
+ *  the uploader of the media is already being requested it waits for
+ *  that request. It should be called on the main thread
+ *
+ *  @param media   The media entity
+ *  @param success The success callback, with the shared uploader
+ *  @param failure The failure callback
+ */
+-(void)getUploaderForMedia:(OlapicMediaEntity *)media onSuccess:(void (^)(OlapicUploaderEntity *uploader))success onFailure:(void (^)(NSError *error))failure{
+    if(!media.uploader){
+        // Create it from the response, if it came embedded
+        OlapicEmbeddedResources *resources = [OlapicEmbeddedResources resourcesForEntity:media];
+        media.uploader = [resources resourceNamed:@"uploader" withHandler:[[OlapicSDK sharedOlapicSDK] uploaders]];
+    }
+    if(media.uploader){
+        if(success) success(media.uploader);
+        return;
+    }
+    void (^callback)(OlapicUploaderEntity *uploader, NSError *error) = ^(OlapicUploaderEntity *uploader, NSError *error){
+        if(uploader){
+            if(success) success(uploader);
+        }else if(failure){
+            failure(error);
+        }
+    };
+    NSMutableArray *waiting = [uploaderRequests objectForKey:media];
+    if(waiting){
+        // Already requested (by the prefetcher, or another screen)
+        [waiting addObject:callback];
+        return;
+    }
+    waiting = [[NSMutableArray alloc] initWithObjects:callback, nil];
+    [uploaderRequests setObject:waiting forKey:media];
+    __weak OlapicMediaEntity *weakMedia = media;
+    // The callbacks are taken from the map first, so they can ask again
+    void (^finish)(OlapicUploaderEntity *uploader, NSError *error) = ^(OlapicUploaderEntity *uploader, NSError *error){
+        OlapicMediaEntity *requested = weakMedia;
+        if(requested) [uploaderRequests removeObjectForKey:requested];
+        for(void (^waitingCallback)(OlapicUploaderEntity *uploader, NSError *error) in waiting){
+            waitingCallback(uploader, error);
+        }
+    };
+    [OlapicEmbeddedResources restoreResourcesForEntity:media];
+    [media getUploader:^(OlapicUploaderEntity *uploader){
+        OlapicUploaderEntity *shared = [self registerEntity:uploader];
+        weakMedia.uploader = shared;
+        finish(shared, nil);
+    } onFailure:^(NSError *error){
+        finish(nil, error);
+    }];
+}
+/**
+ *  Update the data of a live entity, on the main thread. The new values
+ *  are merged, so a list that only keeps some fields doesn't remove
+ *  the rest
+ *
+ *  @param entity The live entity
+ *  @param values The new data
+ */
+-(void)updateEntity:(OlapicEntity *)entity withData:(NSDictionary *)values{
+    if(!values || entity.data == values) return;
+    void (^update)(void) = ^{
+        entity.data = [OlapicIdentityMap mergeValues:values into:entity.data];
+    };
+    if([NSThread isMainThread]){
+        update();
+    }else{
+        dispatch_async(dispatch_get_main_queue(), update);
+    }
+}
+/**
+ *  Merge the data of an entity. The top level keys are merged, so the
+ *  fields a list didn't ask for are kept, and so are the '_embedded'
+ *  and '_links' resources the new data doesn't have. Any other value,
+ *  dictionaries included, is replaced whole, so the keys the server
+ *  removed from it go away
+ *
+ *  @param values   The new values
+ *  @param existing The current values
+ *
+ *  @return The merged object
+ */
++(id)mergeValues:(id)values into:(id)existing{
+    if(![values isKindOfClass:[NSDictionary class]] || ![existing isKindOfClass:[NSDictionary class]]){
+        return values;
+    }
+    NSMutableDictionary *merged = [existing mutableCopy];
+    for(NSString *key in values){
+        id value = [values objectForKey:key];
+        id current = [existing objectForKey:key];
+        if(([key isEqualToString:@"_embedded"] || [key isEqualToString:@"_links"]) && [value isKindOfClass:[NSDictionary class]] && [current isKindOfClass:[NSDictionary class]]){
+            // One resource (or link) at a time, each one replaced whole
+            NSMutableDictionary *resources = [current mutableCopy];
+            [resources addEntriesFromDictionary:value];
+            value = resources;
+        }
+        [merged setObject:value forKey:key];
+    }
+    return merged;
+}
+/**
+ *  Get the entity class created by a handler
+ *
+ *  @param handler The SDK handler
+ *
+ *  @return The entity class, or Nil if its entities are not shared
+ */
++(Class)entityTypeForHandler:(OlapicHandler *)handler{
+    if([handler isKindOfClass:[OlapicMediaHandler class]]) return [OlapicMediaEntity class];
+    if([handler isKindOfClass:[OlapicUploaderHandler class]]) return [OlapicUploaderEntity class];
+    if([handler isKindOfClass:[OlapicStreamHandler class]]) return [OlapicStreamEntity class];
+    if([handler isKindOfClass:[OlapicCategoryHandler class]]) return [OlapicCategoryEntity class];
+    return Nil;
+}
+/**
+ *  Get the entity class used as the type of an entity (so the
+ *  subclasses share the IDs with their SDK class)
+ *
+ *  @param entity The entity
+ *
+ *  @return The entity class
+ */
++(Class)entityTypeForEntity:(OlapicEntity *)entity{
+    for(Class type in @[[OlapicMediaEntity class],[OlapicUploaderEntity class],[OlapicStreamEntity class],[OlapicCategoryEntity class]]){
+        if([entity isKindOfClass:type]) return type;
+    }
+    return [entity class];
+}
+/**
+ *  Get the map key of an entity
+ *
+ *  @param type       The entity class
+ *  @param identifier The entity ID
+ *
+ *  @return The key
+ */
++(NSString *)keyForType:(Class)type identifier:(NSString *)identifier{
+    return [NSString stringWithFormat:@"%@/%@",NSStringFromClass(type),identifier];
+}
+
+@end
\ No newline at end of file
@@ -32,6 +32,9 @@
 
 #import <Foundation/Foundation.h>
 #import <OlapicSDK/OlapicSDK.h>
+#import "OlapicNetworkTask.h"
+#import "OlapicImageMemoryManager.h"
+#import "OlapicPlaceholderStore.h"
 /**
  *  Its like a UIImageView that works with the SDK's
  *  media entities: It recieves an entity and it handles
@@ -39,8 +42,17 @@
  *  case its needed).
  *  This object is used mostly for thumbnails. It has
  *  a special method to download the original image
+ *
+ *  Its decoded images are counted by the OlapicImageMemoryManager. When
+ *  they are evicted it keeps the compressed thumbnail, and decodes it
+ *  again the next time it's displayed.
+ *
+ *  While the thumbnail loads (or after it's evicted) it shows the media
+ *  placeholder from the OlapicPlaceholderStore, if it has one, instead
+ *  of the loading indicator. The first thumbnail downloaded for a media
+ *  creates its placeholder.
  */
-@interface OlapicAsyncImageView : UIView{
+@interface OlapicAsyncImageView : UIView <OlapicImageMemoryOwner>{
     /**
      *  The media entity from where the image comes
      */
@@ -81,6 +93,14 @@
      *  for the 'Zoom screen'
      */
     UIImage *fullImage;
+    /**
+     *  The compressed thumbnail, to decode it again after an eviction
+     */
+    NSData *thumbData;
+    /**
+     *  If the decoded images were evicted
+     */
+    BOOL evicted;
 }
 
 @property (nonatomic,strong) OlapicMediaEntity *media;
@@ -92,6 +112,7 @@
 @property (nonatomic,strong) void (^callback)(OlapicAsyncImageView  *image);
 @property (nonatomic,strong) UIImage *thumbImage;
 @property (nonatomic,strong) UIImage *fullImage;
+@property (nonatomic,readonly) BOOL evicted;
 /**
  *  Class constructor
  *
@@ -104,14 +125,29 @@
 -(id)initWithMedia:(OlapicMediaEntity *)med callback:(void (^)(OlapicAsyncImageView *image))call andFrame:(CGRect)rect;
 /**
  *  Tell the object to start downloading the thumbnail
+ *
+ *  @return The request task, so it can be cancelled
  */
--(void)download;
+-(OlapicNetworkTask *)download;
 /**
- *  Download the original image from the media object
+ *  Download the image for the 'Zoom screen'. It will use the smallest
+ *  image size that can fill the screen, so it won't always be the original
  *
  *  @param call A callback action to be called when the image is ready (it will be accessible via the ivar fullImage).
  */
 -(void)downloadFullImageAndDo:(void (^)(OlapicAsyncImageView *image))call;
+/**
+ *  Download the compressed original image, so it can be decoded by parts
+ *  (like the OlapicTiledImageView does) instead of all at once
+ *
+ *  @param call A callback action to be called with the image data
+ */
+-(void)downloadOriginalDataAndDo:(void (^)(NSData *data))call;
+/**
+ *  Tell the object it's on the screen, so its images are the last ones
+ *  to be evicted (and they're decoded again if they were)
+ */
+-(void)markDisplayed;
 /**
  *  Resize and crop an image proportionally
  *
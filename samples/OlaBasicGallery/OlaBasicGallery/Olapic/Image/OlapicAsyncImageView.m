@@ -31,6 +31,8 @@
 //  THE SOFTWARE.
 
 #import "OlapicAsyncImageView.h"
+#import "OlapicImageSizeSelector.h"
+#import "OlapicNetworkClient.h"
 
 @interface OlapicAsyncImageView()
 /**
@@ -46,11 +48,27 @@
  *  Hide the fake overlay and call the button action
  */
 -(void)buttonAction;
+/**
+ *  Show the thumbnail from its compressed data
+ *
+ *  @return NO if the data is not a valid image
+ */
+-(BOOL)decodeThumbnail;
+/**
+ *  Report the memory used by the decoded images to the memory manager
+ */
+-(void)updateImageCost;
+/**
+ *  Show the media placeholder (its dominant colour and tiny preview)
+ *
+ *  @return NO if the media doesn't have a placeholder yet
+ */
+-(BOOL)showPlaceholder;
 
 @end
 
 @implementation OlapicAsyncImageView
-@synthesize media,image,loader,border,button,overlay,callback,fullImage,thumbImage;
+@synthesize media,image,loader,border,button,overlay,callback,fullImage,thumbImage,evicted;
 /**
  *  Class constructor
  *
@@ -96,13 +114,25 @@
 }
 /**
  *  Tell the object to start downloading the thumbnail
+ *
+ *  @return The request task, so it can be cancelled
  */
--(void)download{
-    [loader startAnimating];
-    [[[OlapicSDK sharedOlapicSDK] media] loadImageWithSize:OlapicMediaImageSizeThumbnail fromMedia:media onSuccess:^(NSData *mediaData, UIImage *mediaImage){
-        thumbImage = mediaImage;
-        image.image = [OlapicAsyncImageView resizeImage:mediaImage to:CGSizeMake(self.frame.size.width,self.frame.size.height) detectingRetina:YES];
+-(OlapicNetworkTask *)download{
+    if(![self showPlaceholder]){
+        [loader startAnimating];
+    }
+    // The thumbnail is also used by the zoom screen, so it can't be a cropped one
+    OlapicMediaImageSize size = [OlapicImageSizeSelector imageSizeForMedia:media fittingSize:self.frame.size allowingCrop:NO];
+    return [[OlapicNetworkClient sharedClient] getData:[media getMediaURLForImageSize:size] parameters:nil priority:OlapicRequestPriorityNormal onSuccess:^(NSData *mediaData){
+        thumbData = mediaData;
+        if(![self decodeThumbnail]){
+            thumbData = nil;
+            [loader stopAnimating];
+            self.backgroundColor = [UIColor redColor];
+            return;
+        }
         [loader stopAnimating];
+        [[OlapicPlaceholderStore sharedStore] addPlaceholderForMedia:media fromImageData:mediaData];
         [self adjustSize];
     } onFailure:^(NSError *error){
         [loader stopAnimating];
@@ -132,22 +162,102 @@
  */
 -(void)buttonAction{
     overlay.alpha = 0;
+    // The zoom screen starts with the thumbnail
+    [self markDisplayed];
     if(callback) callback(self);
 }
 /**
- *  Download the original image from the media object
+ *  Download the image for the 'Zoom screen'. It will use the smallest
+ *  image size that can fill the screen, so it won't always be the original
  *
  *  @param call A callback action to be called when the image is ready (it will be accessible via the ivar fullImage).
  */
 -(void)downloadFullImageAndDo:(void (^)(OlapicAsyncImageView *image))call{
-    OlapicSDK *olapic = [OlapicSDK sharedOlapicSDK];
-    [[olapic media] loadImageWithSize:OlapicMediaImageSizeOriginal fromMedia:media onSuccess:^(NSData *mediaData, UIImage *mediaImage){
+    OlapicMediaImageSize size = [OlapicImageSizeSelector imageSizeForMedia:media fittingSize:[UIScreen mainScreen].bounds.size allowingCrop:NO];
+    OlapicRequestPriority priority = size == OlapicMediaImageSizeOriginal ? OlapicRequestPriorityOriginal : OlapicRequestPriorityHigh;
+    [[OlapicNetworkClient sharedClient] getData:[media getMediaURLForImageSize:size] parameters:nil priority:priority onSuccess:^(NSData *mediaData){
+        UIImage *mediaImage = [UIImage imageWithData:mediaData];
+        if(!mediaImage) return;
         fullImage = mediaImage;
+        [self updateImageCost];
         if(call) call(self);
     } onFailure:^(NSError *error){
     
     }];
 }
+/**
+ *  Download the compressed original image, so it can be decoded by parts
+ *  (like the OlapicTiledImageView does) instead of all at once
+ *
+ *  @param call A callback action to be called with the image data
+ */
+-(void)downloadOriginalDataAndDo:(void (^)(NSData *data))call{
+    [[OlapicNetworkClient sharedClient] getData:[media getMediaURLForImageSize:OlapicMediaImageSizeOriginal] parameters:nil priority:OlapicRequestPriorityOriginal onSuccess:^(NSData *mediaData){
+        if(call) call(mediaData);
+    } onFailure:^(NSError *error){
+    
+    }];
+}
+/**
+ *  Show the thumbnail from its compressed data
+ *
+ *  @return NO if the data is not a valid image
+ */
+-(BOOL)decodeThumbnail{
+    UIImage *mediaImage = thumbData ? [UIImage imageWithData:thumbData] : nil;
+    if(!mediaImage) return NO;
+    thumbImage = mediaImage;
+    self.backgroundColor = [UIColor clearColor];
+    image.image = [OlapicAsyncImageView resizeImage:mediaImage to:CGSizeMake(self.frame.size.width,self.frame.size.height) detectingRetina:YES];
+    evicted = NO;
+    [self updateImageCost];
+    return YES;
+}
+/**
+ *  Show the media placeholder (its dominant colour and tiny preview)
+ *
+ *  @return NO if the media doesn't have a placeholder yet
+ */
+-(BOOL)showPlaceholder{
+    OlapicPlaceholderStore *store = [OlapicPlaceholderStore sharedStore];
+    UIColor *color = [store dominantColorForMedia:media];
+    if(!color) return NO;
+    self.backgroundColor = color;
+    // Stretched with the linear filter, it looks blurred
+    image.image = [store previewForMedia:media];
+    return YES;
+}
+/**
+ *  Report the memory used by the decoded images to the memory manager
+ */
+-(void)updateImageCost{
+    NSUInteger cost = [OlapicImageMemoryManager costForImage:thumbImage] + [OlapicImageMemoryManager costForImage:image.image] + [OlapicImageMemoryManager costForImage:fullImage];
+    [[OlapicImageMemoryManager sharedManager] setCost:cost forOwner:self];
+}
+/**
+ *  Tell the object it's on the screen, so its images are the last ones
+ *  to be evicted (and they're decoded again if they were)
+ */
+-(void)markDisplayed{
+    if(evicted){
+        [self decodeThumbnail];
+    }else{
+        [[OlapicImageMemoryManager sharedManager] touchOwner:self];
+    }
+}
+/**
+ *  Release the decoded images, keeping the compressed thumbnail. The
+ *  full image can be downloaded again
+ */
+-(void)evictDecodedImages{
+    if(!thumbData) return;
+    evicted = YES;
+    thumbImage = nil;
+    fullImage = nil;
+    image.image = nil;
+    [self showPlaceholder];
+    [[OlapicImageMemoryManager sharedManager] removeOwner:self];
+}
 /**
  *  Resize and crop an image proportionally
  *
@@ -200,5 +310,11 @@
     [super drawRect:rect];
     [self adjustSize];
 }
+/**
+ *  Stop counting the images when the object goes away
+ */
+-(void)dealloc{
+    [[OlapicImageMemoryManager sharedManager] removeOwner:self];
+}
 
 @end
\ No newline at end of file
@@ -0,0 +1,131 @@
+//
+//  OlapicImageMemoryManager.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@class OlapicImageMemoryEntry;
+/**
+ *  An object that keeps decoded images and can let them go when the
+ *  memory manager needs the space
+ */
+@protocol OlapicImageMemoryOwner <NSObject>
+/**
+ *  Release the decoded images, keeping only what's needed to get them
+ *  back (the compressed data, or the URL). The owner should set its
+ *  cost to 0 (or remove itself) after this
+ */
+-(void)evictDecodedImages;
+
+@end
+/**
+ *  Keeps the decoded images of the whole app under a memory budget.
+ *  Each owner (like a thumbnail) reports how much memory its images
+ *  use and when they are displayed; when the total goes over the budget
+ *  the least recently displayed owners are asked to release their images.
+ *  The owners are kept on a linked list (and a dictionary to find their
+ *  entries), so marking one as displayed doesn't depend on how many
+ *  there are.
+ *
+ *  On a memory warning it goes down to a quarter of the budget.
+ *
+ *  The owners are not retained, so they must be removed when they go
+ *  away. All the methods should be called from the main thread.
+ */
+@interface OlapicImageMemoryManager : NSObject{
+    /**
+     *  The maximum number of bytes for the decoded images
+     */
+    NSUInteger budget;
+    /**
+     *  The bytes currently used
+     */
+    NSUInteger totalCost;
+    /**
+     *  The entry (cost and position on the list) of each owner, by
+     *  non retained NSValue
+     */
+    NSMutableDictionary *entries;
+    /**
+     *  The least recently displayed owner, the first of the list
+     */
+    OlapicImageMemoryEntry *leastRecent;
+    /**
+     *  The most recently displayed owner, the last of the list
+     */
+    OlapicImageMemoryEntry *__unsafe_unretained mostRecent;
+}
+
+@property (nonatomic) NSUInteger budget;
+@property (nonatomic,readonly) NSUInteger totalCost;
+/**
+ *  Get the shared instance
+ *
+ *  @return The shared instance
+ */
++(OlapicImageMemoryManager *)sharedManager;
+/**
+ *  Get the memory used by a decoded image
+ *
+ *  @param image The image
+ *
+ *  @return The number of bytes
+ */
++(NSUInteger)costForImage:(UIImage *)image;
+/**
+ *  Update the memory used by an owner. It counts as displayed
+ *
+ *  @param cost  The number of bytes (0 removes the owner)
+ *  @param owner The owner
+ */
+-(void)setCost:(NSUInteger)cost forOwner:(id<OlapicImageMemoryOwner>)owner;
+/**
+ *  Mark an owner as just displayed, so it's the last to be evicted
+ *
+ *  @param owner The owner
+ */
+-(void)touchOwner:(id<OlapicImageMemoryOwner>)owner;
+/**
+ *  Stop tracking an owner (it must be called when the owner goes away)
+ *
+ *  @param owner The owner
+ */
+-(void)removeOwner:(id<OlapicImageMemoryOwner>)owner;
+/**
+ *  Evict the least recently displayed owners until the total cost is
+ *  under a limit
+ *
+ *  @param limit The number of bytes
+ */
+-(void)trimToCost:(NSUInteger)limit;
+
+@end
\ No newline at end of file
@@ -0,0 +1,283 @@
+//
+//  OlapicImageMemoryManager.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicImageMemoryManager.h"
+
+/**
+ *  An owner on the list of the memory manager
+ */
+@interface OlapicImageMemoryEntry : NSObject{
+    @public
+    /**
+     *  The owner (a non retained NSValue)
+     */
+    NSValue *key;
+    /**
+     *  The bytes used by the owner
+     */
+    NSUInteger cost;
+    /**
+     *  The owner displayed before this one
+     */
+    OlapicImageMemoryEntry *__unsafe_unretained previous;
+    /**
+     *  The owner displayed after this one (the list retains the entries)
+     */
+    OlapicImageMemoryEntry *next;
+}
+
+@end
+
+@implementation OlapicImageMemoryEntry
+
+@end
+
+@interface OlapicImageMemoryManager()
+/**
+ *  Free memory after a memory warning
+ *
+ *  @param notification The notification
+ */
+-(void)didReceiveMemoryWarning:(NSNotification *)notification;
+/**
+ *  Evict the least recently displayed owners until the total cost is
+ *  under a limit, keeping one of them
+ *
+ *  @param limit The number of bytes
+ *  @param kept  An owner that shouldn't be evicted (or nil)
+ */
+-(void)trimToCost:(NSUInteger)limit keeping:(NSValue *)kept;
+/**
+ *  Take an entry out of the list
+ *
+ *  @param entry The entry
+ */
+-(void)unlinkEntry:(OlapicImageMemoryEntry *)entry;
+/**
+ *  Put an entry at the end of the list, as the most recently displayed
+ *
+ *  @param entry The entry
+ */
+-(void)appendEntry:(OlapicImageMemoryEntry *)entry;
+
+@end
+
+@implementation OlapicImageMemoryManager
+
+@synthesize budget,totalCost;
+/**
+ *  Get the shared instance
+ *
+ *  @return The shared instance
+ */
++(OlapicImageMemoryManager *)sharedManager{
+    static OlapicImageMemoryManager *sharedManager = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedManager = [[OlapicImageMemoryManager alloc] init];
+    });
+    return sharedManager;
+}
+/**
+ *  Class constructor. The default budget is an eighth of the device
+ *  memory, up to 96MB
+ *
+ *  @return An instance of this object (OlapicImageMemoryManager)
+ */
+-(id)init{
+    self = [super init];
+    if(self){
+        budget = (NSUInteger)MIN([[NSProcessInfo processInfo] physicalMemory] / 8, 96 * 1024 * 1024);
+        totalCost = 0;
+        entries = [[NSMutableDictionary alloc] init];
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    }
+    return self;
+}
+/**
+ *  Change the budget, evicting images if needed
+ *
+ *  @param newBudget The number of bytes
+ */
+-(void)setBudget:(NSUInteger)newBudget{
+    budget = newBudget;
+    [self trimToCost:budget];
+}
+/**
+ *  Get the memory used by a decoded image
+ *
+ *  @param image The image
+ *
+ *  @return The number of bytes
+ */
++(NSUInteger)costForImage:(UIImage *)image{
+    CGImageRef cgImage = image.CGImage;
+    if(!cgImage) return 0;
+    return CGImageGetBytesPerRow(cgImage) * CGImageGetHeight(cgImage);
+}
+/**
+ *  Update the memory used by an owner. It counts as displayed
+ *
+ *  @param cost  The number of bytes (0 removes the owner)
+ *  @param owner The owner
+ */
+-(void)setCost:(NSUInteger)cost forOwner:(id<OlapicImageMemoryOwner>)owner{
+    if(!owner) return;
+    if(!cost){
+        [self removeOwner:owner];
+        return;
+    }
+    NSValue *key = [NSValue valueWithNonretainedObject:owner];
+    OlapicImageMemoryEntry *entry = [entries objectForKey:key];
+    if(entry){
+        totalCost -= entry->cost;
+        [self unlinkEntry:entry];
+    }else{
+        entry = [[OlapicImageMemoryEntry alloc] init];
+        entry->key = key;
+        [entries setObject:entry forKey:key];
+    }
+    entry->cost = cost;
+    totalCost += cost;
+    [self appendEntry:entry];
+    [self trimToCost:budget keeping:key];
+}
+/**
+ *  Mark an owner as just displayed, so it's the last to be evicted
+ *
+ *  @param owner The owner
+ */
+-(void)touchOwner:(id<OlapicImageMemoryOwner>)owner{
+    OlapicImageMemoryEntry *entry = [entries objectForKey:[NSValue valueWithNonretainedObject:owner]];
+    if(!entry || entry == mostRecent) return;
+    [self unlinkEntry:entry];
+    [self appendEntry:entry];
+}
+/**
+ *  Stop tracking an owner (it must be called when the owner goes away)
+ *
+ *  @param owner The owner
+ */
+-(void)removeOwner:(id<OlapicImageMemoryOwner>)owner{
+    NSValue *key = [NSValue valueWithNonretainedObject:owner];
+    OlapicImageMemoryEntry *entry = [entries objectForKey:key];
+    if(!entry) return;
+    totalCost -= entry->cost;
+    [self unlinkEntry:entry];
+    [entries removeObjectForKey:key];
+}
+/**
+ *  Take an entry out of the list
+ *
+ *  @param entry The entry
+ */
+-(void)unlinkEntry:(OlapicImageMemoryEntry *)entry{
+    // Keep it alive while the links change, the list may be its only owner
+    OlapicImageMemoryEntry *unlinked = entry;
+    if(unlinked->previous){
+        unlinked->previous->next = unlinked->next;
+    }else{
+        leastRecent = unlinked->next;
+    }
+    if(unlinked->next){
+        unlinked->next->previous = unlinked->previous;
+    }else{
+        mostRecent = unlinked->previous;
+    }
+    unlinked->previous = nil;
+    unlinked->next = nil;
+}
+/**
+ *  Put an entry at the end of the list, as the most recently displayed
+ *
+ *  @param entry The entry
+ */
+-(void)appendEntry:(OlapicImageMemoryEntry *)entry{
+    entry->previous = mostRecent;
+    if(mostRecent){
+        mostRecent->next = entry;
+    }else{
+        leastRecent = entry;
+    }
+    mostRecent = entry;
+}
+/**
+ *  Evict the least recently displayed owners until the total cost is
+ *  under a limit
+ *
+ *  @param limit The number of bytes
+ */
+-(void)trimToCost:(NSUInteger)limit{
+    [self trimToCost:limit keeping:nil];
+}
+/**
+ *  Evict the least recently displayed owners until the total cost is
+ *  under a limit, keeping one of them
+ *
+ *  @param limit The number of bytes
+ *  @param kept  An owner that shouldn't be evicted (or nil)
+ */
+-(void)trimToCost:(NSUInteger)limit keeping:(NSValue *)kept{
+    OlapicImageMemoryEntry *entry = leastRecent;
+    while(totalCost > limit && entry){
+        if([entry->key isEqual:kept]){
+            entry = entry->next;
+            continue;
+        }
+        OlapicImageMemoryEntry *evicted = entry;
+        entry = entry->next;
+        id<OlapicImageMemoryOwner> owner = [evicted->key nonretainedObjectValue];
+        // Forget it first, the owner may update its cost while evicting
+        totalCost -= evicted->cost;
+        [self unlinkEntry:evicted];
+        [entries removeObjectForKey:evicted->key];
+        [owner evictDecodedImages];
+        // The owner may have changed the list, then start from the first one
+        if(entry && !entry->previous && entry != leastRecent) entry = leastRecent;
+    }
+}
+/**
+ *  Free memory after a memory warning
+ *
+ *  @param notification The notification
+ */
+-(void)didReceiveMemoryWarning:(NSNotification *)notification{
+    [self trimToCost:budget / 4];
+}
+/**
+ *  Stop observing the notifications
+ */
+-(void)dealloc{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,83 @@
+//
+//  OlapicImageSizeSelector.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+/**
+ *  Picks the smallest OlapicMediaImageSize variant that
+ *  is still good enough for a given view. It takes into
+ *  account the screen scale, the media original size and
+ *  the current network (on cellular it will accept a
+ *  slightly smaller image)
+ */
+@interface OlapicImageSizeSelector : NSObject
+/**
+ *  Get the best image size for a media, using the main screen scale
+ *  and the current network status
+ *
+ *  @param media     The media entity from where the image will be downloaded
+ *  @param pointSize The size (in points) of the view that will show the image
+ *  @param crop      If the view can show a square cropped version of the image
+ *
+ *  @return The smallest image size that can fill the view
+ */
++(OlapicMediaImageSize)imageSizeForMedia:(OlapicMediaEntity *)media fittingSize:(CGSize)pointSize allowingCrop:(BOOL)crop;
+/**
+ *  Get the best image size for a media
+ *
+ *  @param media     The media entity from where the image will be downloaded
+ *  @param pointSize The size (in points) of the view that will show the image
+ *  @param crop      If the view can show a square cropped version of the image
+ *  @param scale     The screen scale
+ *  @param cellular  If the device is connected using a cellular network
+ *
+ *  @return The smallest image size that can fill the view
+ */
++(OlapicMediaImageSize)imageSizeForMedia:(OlapicMediaEntity *)media fittingSize:(CGSize)pointSize allowingCrop:(BOOL)crop scale:(CGFloat)scale cellular:(BOOL)cellular;
+/**
+ *  Get the nominal length (in pixels) of the longest side of
+ *  an image size. The original size doesn't have a fixed length,
+ *  so it will return 0
+ *
+ *  @param size The image size
+ *
+ *  @return The length in pixels
+ */
++(CGFloat)pixelLengthForImageSize:(OlapicMediaImageSize)size;
+/**
+ *  Check if the device is currently using a cellular network
+ *
+ *  @return YES if the connection is WWAN
+ */
++(BOOL)isOnCellularNetwork;
+
+@end
\ No newline at end of file
@@ -0,0 +1,117 @@
+//
+//  OlapicImageSizeSelector.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#define kCellularQualityFactor 0.75
+
+#import "OlapicImageSizeSelector.h"
+#import "OlapicNetworkClient.h"
+
+@implementation OlapicImageSizeSelector
+/**
+ *  Get the best image size for a media, using the main screen scale
+ *  and the current network status
+ *
+ *  @param media     The media entity from where the image will be downloaded
+ *  @param pointSize The size (in points) of the view that will show the image
+ *  @param crop      If the view can show a square cropped version of the image
+ *
+ *  @return The smallest image size that can fill the view
+ */
++(OlapicMediaImageSize)imageSizeForMedia:(OlapicMediaEntity *)media fittingSize:(CGSize)pointSize allowingCrop:(BOOL)crop{
+    return [OlapicImageSizeSelector imageSizeForMedia:media fittingSize:pointSize allowingCrop:crop scale:[UIScreen mainScreen].scale cellular:[OlapicImageSizeSelector isOnCellularNetwork]];
+}
+/**
+ *  Get the best image size for a media
+ *
+ *  @param media     The media entity from where the image will be downloaded
+ *  @param pointSize The size (in points) of the view that will show the image
+ *  @param crop      If the view can show a square cropped version of the image
+ *  @param scale     The screen scale
+ *  @param cellular  If the device is connected using a cellular network
+ *
+ *  @return The smallest image size that can fill the view
+ */
++(OlapicMediaImageSize)imageSizeForMedia:(OlapicMediaEntity *)media fittingSize:(CGSize)pointSize allowingCrop:(BOOL)crop scale:(CGFloat)scale cellular:(BOOL)cellular{
+    // The number of pixels needed for the longest side of the view
+    CGFloat needed = MAX(pointSize.width, pointSize.height) * MAX(scale, 1.0);
+    // On cellular, a slightly smaller image is better than waiting for a bigger one
+    if(cellular){
+        needed = needed * kCellularQualityFactor;
+    }
+    // There's no point on asking for more pixels than the original has
+    CGSize original = media.originalSize;
+    CGFloat originalLength = MAX(original.width, original.height);
+    if(originalLength > 0 && originalLength < needed){
+        needed = originalLength;
+    }
+    OlapicMediaImageSize sizes[4] = {OlapicMediaImageSizeSquare, OlapicMediaImageSizeThumbnail, OlapicMediaImageSizeMobile, OlapicMediaImageSizeNormal};
+    for(int i = 0; i < 4; i++){
+        if(sizes[i] == OlapicMediaImageSizeSquare && !crop) continue;
+        if([OlapicImageSizeSelector pixelLengthForImageSize:sizes[i]] >= needed){
+            return sizes[i];
+        }
+    }
+    return OlapicMediaImageSizeOriginal;
+}
+/**
+ *  Get the nominal length (in pixels) of the longest side of
+ *  an image size. The original size doesn't have a fixed length,
+ *  so it will return 0
+ *
+ *  @param size The image size
+ *
+ *  @return The length in pixels
+ */
++(CGFloat)pixelLengthForImageSize:(OlapicMediaImageSize)size{
+    switch(size){
+        case OlapicMediaImageSizeSquare:
+            return 150;
+        case OlapicMediaImageSizeThumbnail:
+            return 150;
+        case OlapicMediaImageSizeMobile:
+            return 480;
+        case OlapicMediaImageSizeNormal:
+            return 640;
+        default:
+            return 0;
+    }
+}
+/**
+ *  Check if the device is currently using a cellular network
+ *
+ *  @return YES if the connection is WWAN
+ */
++(BOOL)isOnCellularNetwork{
+    return [[OlapicNetworkClient sharedClient] networkClass] == OlapicNetworkClassCellular;
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,143 @@
+//
+//  OlapicPlaceholderStore.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import <OlapicSDK/OlapicSDK.h>
+/**
+ *  The side, in pixels, of the placeholder previews
+ */
+extern const NSUInteger OlapicPlaceholderPreviewSide;
+/**
+ *  Keeps a placeholder for every media whose thumbnail was downloaded:
+ *  its dominant colour and a tiny preview (the centre square, scaled
+ *  down to OlapicPlaceholderPreviewSide pixels). They're shown while
+ *  the thumbnail loads, and stretched they look like a blurred version
+ *  of it.
+ *
+ *  The placeholders are computed once per media, off the main thread,
+ *  from the first image data downloaded for it: ImageIO decodes a small
+ *  version of it and vImage scales it down. They're saved on a file in
+ *  the caches directory (about 260 bytes each), so the next sessions
+ *  show them right away.
+ */
+@interface OlapicPlaceholderStore : NSObject{
+    /**
+     *  The placeholders, by media ID: 3 bytes with the dominant colour
+     *  and the RGBA preview pixels
+     */
+    NSMutableDictionary *placeholders;
+    /**
+     *  The media IDs, from the oldest to the newest placeholder
+     */
+    NSMutableArray *order;
+    /**
+     *  The maximum number of placeholders kept
+     */
+    NSUInteger countLimit;
+    /**
+     *  Where the placeholders are saved
+     */
+    NSString *path;
+    /**
+     *  The queue that computes and saves the placeholders
+     */
+    dispatch_queue_t queue;
+    /**
+     *  If there's a save waiting on the queue
+     */
+    BOOL saveScheduled;
+}
+
+@property (nonatomic) NSUInteger countLimit;
+@property (nonatomic,copy,readonly) NSString *path;
+/**
+ *  Get the shared instance
+ *
+ *  @return The shared instance
+ */
++(OlapicPlaceholderStore *)sharedStore;
+/**
+ *  Class constructor
+ *
+ *  @param filePath Where the placeholders are saved (nil to keep them only in memory)
+ *
+ *  @return An instance of this object (OlapicPlaceholderStore)
+ */
+-(id)initWithPath:(NSString *)filePath;
+/**
+ *  Check if a media has a placeholder
+ *
+ *  @param media The media entity
+ *
+ *  @return If it has one
+ */
+-(BOOL)hasPlaceholderForMedia:(OlapicMediaEntity *)media;
+/**
+ *  Get the dominant colour of a media
+ *
+ *  @param media The media entity
+ *
+ *  @return The colour, or nil if the media doesn't have a placeholder
+ */
+-(UIColor *)dominantColorForMedia:(OlapicMediaEntity *)media;
+/**
+ *  Get the tiny preview of a media
+ *
+ *  @param media The media entity
+ *
+ *  @return The preview, or nil if the media doesn't have a placeholder
+ */
+-(UIImage *)previewForMedia:(OlapicMediaEntity *)media;
+/**
+ *  Compute the placeholder of a media in the background, if it doesn't
+ *  have one yet
+ *
+ *  @param media The media entity
+ *  @param data  The compressed data of any of its images
+ */
+-(void)addPlaceholderForMedia:(OlapicMediaEntity *)media fromImageData:(NSData *)data;
+/**
+ *  Save the placeholders now (it's done automatically a moment
+ *  after they change, and when the app goes to the background)
+ */
+-(void)save;
+/**
+ *  Compute a placeholder. It can be called from any thread
+ *
+ *  @param data The compressed image data
+ *
+ *  @return The placeholder bytes (colour and preview), or nil if the data is not a valid image
+ */
++(NSData *)placeholderFromImageData:(NSData *)data;
+
+@end
\ No newline at end of file
@@ -0,0 +1,329 @@
+//
+//  OlapicPlaceholderStore.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicPlaceholderStore.h"
+#import <ImageIO/ImageIO.h>
+#import <Accelerate/Accelerate.h>
+#import "OlapicEntityInterner.h"
+
+const NSUInteger OlapicPlaceholderPreviewSide = 8;
+/**
+ *  The size of the image ImageIO decodes before scaling it down. JPEGs
+ *  are decoded at a fraction of their size, so it's cheap
+ */
+static const NSUInteger OlapicPlaceholderDecodeSide = 64;
+/**
+ *  The bytes of the dominant colour, before the preview
+ */
+static const NSUInteger OlapicPlaceholderColorLength = 3;
+
+@interface OlapicPlaceholderStore()
+/**
+ *  Get the ID the placeholders of a media are saved with
+ *
+ *  @param media The media entity
+ *
+ *  @return The ID, or nil if the media doesn't have one
+ */
+-(NSString *)keyForMedia:(OlapicMediaEntity *)media;
+/**
+ *  Get the placeholder bytes of a media
+ *
+ *  @param media The media entity
+ *
+ *  @return The bytes, or nil if the media doesn't have a placeholder
+ */
+-(NSData *)placeholderForMedia:(OlapicMediaEntity *)media;
+/**
+ *  Save the placeholders a moment later, so a page of new ones is
+ *  saved only once
+ */
+-(void)scheduleSave;
+/**
+ *  Save the placeholders when the app goes to the background
+ *
+ *  @param notification The notification
+ */
+-(void)applicationDidEnterBackground:(NSNotification *)notification;
+
+@end
+
+@implementation OlapicPlaceholderStore
+@synthesize countLimit,path;
+/**
+ *  Get the shared instance
+ *
+ *  @return The shared instance
+ */
++(OlapicPlaceholderStore *)sharedStore{
+    static OlapicPlaceholderStore *sharedStore = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *caches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+        sharedStore = [[OlapicPlaceholderStore alloc] initWithPath:[caches stringByAppendingPathComponent:@"OlapicPlaceholders.plist"]];
+    });
+    return sharedStore;
+}
+/**
+ *  Class constructor
+ *
+ *  @param filePath Where the placeholders are saved (nil to keep them only in memory)
+ *
+ *  @return An instance of this object (OlapicPlaceholderStore)
+ */
+-(id)initWithPath:(NSString *)filePath{
+    self = [super init];
+    if(self){
+        path = [filePath copy];
+        countLimit = 4000;
+        saveScheduled = NO;
+        queue = dispatch_queue_create("com.olapic.placeholders", DISPATCH_QUEUE_SERIAL);
+        placeholders = [[NSMutableDictionary alloc] init];
+        order = [[NSMutableArray alloc] init];
+        NSDictionary *saved = path ? [NSDictionary dictionaryWithContentsOfFile:path] : nil;
+        NSArray *savedOrder = [saved valueForKey:@"order"];
+        NSDictionary *savedPlaceholders = [saved valueForKey:@"placeholders"];
+        if([savedOrder isKindOfClass:[NSArray class]] && [savedPlaceholders isKindOfClass:[NSDictionary class]]){
+            for(NSString *key in savedOrder){
+                NSData *placeholder = [savedPlaceholders valueForKey:key];
+                if(![placeholder isKindOfClass:[NSData class]]) continue;
+                [placeholders setValue:placeholder forKey:key];
+                [order addObject:key];
+            }
+        }
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(applicationDidEnterBackground:) name:UIApplicationDidEnterBackgroundNotification object:nil];
+    }
+    return self;
+}
+/**
+ *  Get the ID the placeholders of a media are saved with
+ *
+ *  @param media The media entity
+ *
+ *  @return The ID, or nil if the media doesn't have one
+ */
+-(NSString *)keyForMedia:(OlapicMediaEntity *)media{
+    return media ? [OlapicEntityInterner identifierForJSON:media.data] : nil;
+}
+/**
+ *  Get the placeholder bytes of a media
+ *
+ *  @param media The media entity
+ *
+ *  @return The bytes, or nil if the media doesn't have a placeholder
+ */
+-(NSData *)placeholderForMedia:(OlapicMediaEntity *)media{
+    NSString *key = [self keyForMedia:media];
+    if(!key) return nil;
+    @synchronized(self){
+        return [placeholders objectForKey:key];
+    }
+}
+/**
+ *  Check if a media has a placeholder
+ *
+ *  @param media The media entity
+ *
+ *  @return If it has one
+ */
+-(BOOL)hasPlaceholderForMedia:(OlapicMediaEntity *)media{
+    return [self placeholderForMedia:media] != nil;
+}
+/**
+ *  Get the dominant colour of a media
+ *
+ *  @param media The media entity
+ *
+ *  @return The colour, or nil if the media doesn't have a placeholder
+ */
+-(UIColor *)dominantColorForMedia:(OlapicMediaEntity *)media{
+    NSData *placeholder = [self placeholderForMedia:media];
+    if([placeholder length] < OlapicPlaceholderColorLength) return nil;
+    const uint8_t *bytes = [placeholder bytes];
+    return [UIColor colorWithRed:bytes[0]/255.0 green:bytes[1]/255.0 blue:bytes[2]/255.0 alpha:1.0];
+}
+/**
+ *  Get the tiny preview of a media
+ *
+ *  @param media The media entity
+ *
+ *  @return The preview, or nil if the media doesn't have a placeholder
+ */
+-(UIImage *)previewForMedia:(OlapicMediaEntity *)media{
+    NSData *placeholder = [self placeholderForMedia:media];
+    size_t side = OlapicPlaceholderPreviewSide;
+    if([placeholder length] != OlapicPlaceholderColorLength + side * side * 4) return nil;
+    NSData *pixels = [placeholder subdataWithRange:NSMakeRange(OlapicPlaceholderColorLength, side * side * 4)];
+    CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)pixels);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGImageRef cgImage = CGImageCreate(side, side, 8, 32, side * 4, colorSpace, kCGImageAlphaNoneSkipLast | kCGBitmapByteOrder32Big, provider, NULL, true, kCGRenderingIntentDefault);
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(provider);
+    if(!cgImage) return nil;
+    UIImage *preview = [UIImage imageWithCGImage:cgImage];
+    CGImageRelease(cgImage);
+    return preview;
+}
+/**
+ *  Compute the placeholder of a media in the background, if it doesn't
+ *  have one yet
+ *
+ *  @param media The media entity
+ *  @param data  The compressed data of any of its images
+ */
+-(void)addPlaceholderForMedia:(OlapicMediaEntity *)media fromImageData:(NSData *)data{
+    NSString *key = [self keyForMedia:media];
+    if(!key || !data || [self hasPlaceholderForMedia:media]) return;
+    // A page of thumbnails is computed in parallel, the store is updated in order
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+        NSData *placeholder = [OlapicPlaceholderStore placeholderFromImageData:data];
+        if(!placeholder) return;
+        dispatch_async(queue, ^{
+            @synchronized(self){
+                if([placeholders objectForKey:key]) return;
+                [placeholders setObject:placeholder forKey:key];
+                [order addObject:key];
+                while([order count] > countLimit){
+                    [placeholders removeObjectForKey:[order objectAtIndex:0]];
+                    [order removeObjectAtIndex:0];
+                }
+            }
+            [self scheduleSave];
+        });
+    });
+}
+/**
+ *  Save the placeholders a moment later, so a page of new ones is
+ *  saved only once
+ */
+-(void)scheduleSave{
+    if(!path || saveScheduled) return;
+    saveScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(2 * NSEC_PER_SEC)), queue, ^{
+        [self save];
+    });
+}
+/**
+ *  Save the placeholders now (it's done automatically a moment
+ *  after they change, and when the app goes to the background)
+ */
+-(void)save{
+    if(!path) return;
+    NSDictionary *saved;
+    @synchronized(self){
+        saveScheduled = NO;
+        saved = @{@"order": [order copy], @"placeholders": [placeholders copy]};
+    }
+    if(![saved writeToFile:path atomically:YES]){
+        NSLog(@"PLACEHOLDERS SAVE ERROR : %@",path);
+    }
+}
+/**
+ *  Save the placeholders when the app goes to the background
+ *
+ *  @param notification The notification
+ */
+-(void)applicationDidEnterBackground:(NSNotification *)notification{
+    dispatch_async(queue, ^{
+        [self save];
+    });
+}
+/**
+ *  Compute a placeholder. It can be called from any thread
+ *
+ *  @param data The compressed image data
+ *
+ *  @return The placeholder bytes (colour and preview), or nil if the data is not a valid image
+ */
++(NSData *)placeholderFromImageData:(NSData *)data{
+    CGImageSourceRef source = data ? CGImageSourceCreateWithData((__bridge CFDataRef)data, NULL) : NULL;
+    if(!source) return nil;
+    NSDictionary *options = @{(__bridge id)kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+                              (__bridge id)kCGImageSourceCreateThumbnailWithTransform: @YES,
+                              (__bridge id)kCGImageSourceThumbnailMaxPixelSize: @(OlapicPlaceholderDecodeSide)};
+    CGImageRef image = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    CFRelease(source);
+    if(!image) return nil;
+    // Draw the centre square in a known pixel format (RGBX)
+    size_t width = CGImageGetWidth(image), height = CGImageGetHeight(image);
+    size_t square = MAX(MIN(width, height), (size_t)1);
+    size_t sourceRowBytes = square * 4;
+    uint8_t *sourcePixels = calloc(square * sourceRowBytes, 1);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(sourcePixels, square, square, 8, sourceRowBytes, colorSpace, kCGImageAlphaNoneSkipLast | kCGBitmapByteOrder32Big);
+    CGColorSpaceRelease(colorSpace);
+    if(!context){
+        free(sourcePixels);
+        CGImageRelease(image);
+        return nil;
+    }
+    CGContextDrawImage(context, CGRectMake(-floor((width - square) / 2.0), -floor((height - square) / 2.0), width, height), image);
+    CGContextRelease(context);
+    CGImageRelease(image);
+    // Scale it down with vImage (the channel order doesn't matter to it)
+    size_t side = OlapicPlaceholderPreviewSide;
+    NSMutableData *placeholder = [NSMutableData dataWithLength:OlapicPlaceholderColorLength + side * side * 4];
+    uint8_t *previewPixels = (uint8_t *)[placeholder mutableBytes] + OlapicPlaceholderColorLength;
+    vImage_Buffer sourceBuffer = {sourcePixels, square, square, sourceRowBytes};
+    vImage_Buffer previewBuffer = {previewPixels, side, side, side * 4};
+    vImage_Error scaleError = vImageScale_ARGB8888(&sourceBuffer, &previewBuffer, NULL, kvImageHighQualityResampling);
+    free(sourcePixels);
+    if(scaleError != kvImageNoError) return nil;
+    // The dominant colour: the average of the most common colour bucket
+    // (3 bits per channel) of the preview
+    NSUInteger counts[512] = {0};
+    NSUInteger sums[512][3] = {{0}};
+    NSUInteger best = 0;
+    for(size_t i = 0; i < side * side; i++){
+        uint8_t *pixel = previewPixels + i * 4;
+        pixel[3] = 255;
+        NSUInteger bucket = ((pixel[0] >> 5) << 6) | ((pixel[1] >> 5) << 3) | (pixel[2] >> 5);
+        counts[bucket]++;
+        sums[bucket][0] += pixel[0];
+        sums[bucket][1] += pixel[1];
+        sums[bucket][2] += pixel[2];
+        if(counts[bucket] > counts[best]) best = bucket;
+    }
+    uint8_t *color = [placeholder mutableBytes];
+    for(NSUInteger channel = 0; channel < OlapicPlaceholderColorLength; channel++){
+        color[channel] = counts[best] ? (uint8_t)(sums[best][channel] / counts[best]) : 0;
+    }
+    return placeholder;
+}
+/**
+ *  Stop observing the app notifications
+ */
+-(void)dealloc{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,126 @@
+//
+//  OlapicTiledImageView.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "OlapicImageMemoryManager.h"
+/**
+ *  The length (in pixels) of the side of a tile
+ */
+extern const CGFloat OlapicTiledImageViewTileLength;
+/**
+ *  Shows a big image (like a media original) inside a zooming scroll
+ *  view without decoding the whole bitmap. It's backed by a CATiledLayer,
+ *  so it only draws the tiles that are visible at the current zoom scale.
+ *
+ *  Each level of detail is half the size of the previous one, and it uses
+ *  the smallest level that still has enough pixels for the zoom scale.
+ *  A level is decoded once, downsampled by ImageIO to its size with the
+ *  orientation applied, and its tiles are cut from it as they are needed.
+ *  The decoded levels and the tiles are kept in caches counted by the
+ *  OlapicImageMemoryManager. The smallest levels, that fit in a few
+ *  tiles, are cut whole and let go right away.
+ *
+ *  The view should have the proportions of the image; the zoom is
+ *  taken from the transform of the view or any of its superviews.
+ */
+@interface OlapicTiledImageView : UIView <OlapicImageMemoryOwner,NSCacheDelegate>{
+    /**
+     *  The compressed image
+     */
+    NSData *imageData;
+    /**
+     *  The object used to decode the levels
+     */
+    CGImageSourceRef source;
+    /**
+     *  The size of the image (in pixels), with its orientation applied
+     */
+    CGSize imageSize;
+    /**
+     *  The number of levels (the level 0 is the full size image)
+     */
+    NSUInteger levels;
+    /**
+     *  The decoded tiles, by level, column and row
+     */
+    NSCache *tiles;
+    /**
+     *  The decoded levels the tiles are cut from, by level
+     */
+    NSCache *levelImages;
+    /**
+     *  The bytes used by the decoded tiles and levels
+     */
+    NSUInteger tilesCost;
+}
+
+@property (nonatomic,readonly) CGSize imageSize;
+@property (nonatomic,readonly) NSUInteger levels;
+/**
+ *  Class constructor
+ *
+ *  @param data The compressed image
+ *  @param rect The view frame, with the proportions of the image
+ *  @param zoom The maximum zoom scale that will be used with the view
+ *
+ *  @return An instance of this object (OlapicTiledImageView) or nil if
+ *  the data is not a valid image
+ */
+-(id)initWithImageData:(NSData *)data frame:(CGRect)rect maximumZoomScale:(CGFloat)zoom;
+/**
+ *  Get the size (in pixels) of a level
+ *
+ *  @param level The level (0 is the full size image)
+ *
+ *  @return The size of the level
+ */
+-(CGSize)pixelSizeForLevel:(NSUInteger)level;
+/**
+ *  Get the smallest level with enough pixels to be drawn at a scale
+ *
+ *  @param scale The number of pixels per point of the view (the zoom
+ *  scale multiplied by the screen scale)
+ *
+ *  @return The level
+ */
+-(NSUInteger)levelForScale:(CGFloat)scale;
+/**
+ *  Decode a small version of the whole image on a background queue,
+ *  for placeholders or for sharing
+ *
+ *  @param pixelSize The maximum size (in pixels) of the image
+ *  @param call      A callback action to be called on the main thread with the image
+ */
+-(void)loadImageFittingSize:(CGSize)pixelSize onReady:(void (^)(UIImage *image))call;
+
+@end
\ No newline at end of file
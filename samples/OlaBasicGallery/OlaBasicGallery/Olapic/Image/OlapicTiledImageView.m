@@ -0,0 +1,494 @@
+//
+//  OlapicTiledImageView.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <QuartzCore/QuartzCore.h>
+#import <ImageIO/ImageIO.h>
+#import "OlapicTiledImageView.h"
+
+const CGFloat OlapicTiledImageViewTileLength = 256.0;
+
+@interface OlapicTiledImageView()
+/**
+ *  Decode a level of the image, with its orientation applied
+ *
+ *  @param level The level (0 is the full size image)
+ *
+ *  @return The decoded image (it must be released) or NULL
+ */
+-(CGImageRef)newImageForLevel:(NSUInteger)level CF_RETURNS_RETAINED;
+/**
+ *  Check if a level is small enough to be decoded whole and cut
+ *
+ *  @param level The level
+ *
+ *  @return YES if it fits in a few tiles
+ */
+-(BOOL)isSmallLevel:(NSUInteger)level;
+/**
+ *  Get a tile, cutting it from its level (or cutting the whole level, if
+ *  it's a small one) if it's not in the cache. It can be called from any
+ *  thread
+ *
+ *  @param level  The level
+ *  @param column The column of the tile
+ *  @param row    The row of the tile
+ *
+ *  @return The tile or nil if the level can't be decoded
+ */
+-(UIImage *)tileForLevel:(NSUInteger)level column:(NSUInteger)column row:(NSUInteger)row;
+/**
+ *  Get a decoded level from the cache, decoding it if it's not there
+ *
+ *  @param level The level
+ *
+ *  @return The decoded level or nil if it can't be decoded
+ */
+-(UIImage *)levelImageForLevel:(NSUInteger)level;
+/**
+ *  Cut a tile from a decoded level and put it in the cache
+ *
+ *  @param levelImage The decoded level
+ *  @param level      The level
+ *  @param column     The column of the tile
+ *  @param row        The row of the tile
+ *
+ *  @return The tile or nil if it's outside of the level
+ */
+-(UIImage *)cutTileFromImage:(CGImageRef)levelImage level:(NSUInteger)level column:(NSUInteger)column row:(NSUInteger)row;
+/**
+ *  Decode a small level and put all its tiles in the cache. The decoded
+ *  level is released after that, so only the tiles use memory
+ *
+ *  @param level The level
+ */
+-(void)cutLevel:(NSUInteger)level;
+/**
+ *  Put a tile in the cache, counting its cost
+ *
+ *  @param tileImage The decoded tile
+ *  @param key       The tile key
+ *
+ *  @return The tile
+ */
+-(UIImage *)cacheTile:(CGImageRef)tileImage forKey:(NSString *)key;
+/**
+ *  Get the cache key of a tile
+ *
+ *  @param level  The level
+ *  @param column The column of the tile
+ *  @param row    The row of the tile
+ *
+ *  @return The key
+ */
++(NSString *)keyForLevel:(NSUInteger)level column:(NSUInteger)column row:(NSUInteger)row;
+/**
+ *  Add bytes to (or remove them from) the cost of the tiles and levels
+ *  and report it to the memory manager
+ *
+ *  @param cost   The number of bytes
+ *  @param adding NO to remove them
+ */
+-(void)changeTilesCost:(NSUInteger)cost adding:(BOOL)adding;
+
+@end
+
+@implementation OlapicTiledImageView
+@synthesize imageSize,levels;
+/**
+ *  Use a tiled layer, so the view is drawn by tiles, on background
+ *  threads, and only where it's visible
+ *
+ *  @return The CATiledLayer class
+ */
++(Class)layerClass{
+    return [CATiledLayer class];
+}
+/**
+ *  Class constructor
+ *
+ *  @param data The compressed image
+ *  @param rect The view frame, with the proportions of the image
+ *  @param zoom The maximum zoom scale that will be used with the view
+ *
+ *  @return An instance of this object (OlapicTiledImageView) or nil if
+ *  the data is not a valid image
+ */
+-(id)initWithImageData:(NSData *)data frame:(CGRect)rect maximumZoomScale:(CGFloat)zoom{
+    CGImageSourceRef imageSource = data ? CGImageSourceCreateWithData((__bridge CFDataRef)data, NULL) : NULL;
+    NSDictionary *properties = imageSource ? (__bridge_transfer NSDictionary *)CGImageSourceCopyPropertiesAtIndex(imageSource, 0, NULL) : nil;
+    CGFloat width = [properties[(id)kCGImagePropertyPixelWidth] floatValue];
+    CGFloat height = [properties[(id)kCGImagePropertyPixelHeight] floatValue];
+    if(width < 1 || height < 1){
+        if(imageSource) CFRelease(imageSource);
+        return nil;
+    }
+    self = [super initWithFrame:rect];
+    if(self){
+        imageData = data;
+        source = imageSource;
+        // The orientations 5 to 8 are rotated 90 degrees
+        NSInteger orientation = [properties[(id)kCGImagePropertyOrientation] integerValue];
+        imageSize = orientation >= 5 ? CGSizeMake(height, width) : CGSizeMake(width, height);
+        // The smallest level is the first one that fits in a tile
+        levels = 1;
+        while(MAX(imageSize.width, imageSize.height) / (1 << levels) >= OlapicTiledImageViewTileLength && levels < 8){
+            levels++;
+        }
+        tiles = [[NSCache alloc] init];
+        tiles.delegate = self;
+        tiles.totalCostLimit = [OlapicImageMemoryManager sharedManager].budget / 4;
+        // Only the levels being drawn are kept; zooming in and out decodes
+        // the level again instead of holding every level
+        levelImages = [[NSCache alloc] init];
+        levelImages.delegate = self;
+        levelImages.countLimit = 2;
+        levelImages.totalCostLimit = [OlapicImageMemoryManager sharedManager].budget / 4;
+        tilesCost = 0;
+        self.backgroundColor = [UIColor clearColor];
+        self.opaque = NO;
+        // The tiled layer zooms out up to the smallest level, and magnifies
+        // the full size image until the maximum zoom scale
+        size_t bias = (size_t)ceil(log2(MAX(zoom, 1.0)));
+        CATiledLayer *tiledLayer = (CATiledLayer *)self.layer;
+        tiledLayer.tileSize = CGSizeMake(OlapicTiledImageViewTileLength, OlapicTiledImageViewTileLength);
+        tiledLayer.levelsOfDetail = levels + bias;
+        tiledLayer.levelsOfDetailBias = bias;
+        tiledLayer.needsDisplayOnBoundsChange = YES;
+    }else{
+        CFRelease(imageSource);
+    }
+    return self;
+}
+/**
+ *  Get the size (in pixels) of a level
+ *
+ *  @param level The level (0 is the full size image)
+ *
+ *  @return The size of the level
+ */
+-(CGSize)pixelSizeForLevel:(NSUInteger)level{
+    CGFloat divisor = (CGFloat)(1 << MIN(level, levels - 1));
+    return CGSizeMake(ceil(imageSize.width / divisor), ceil(imageSize.height / divisor));
+}
+/**
+ *  Get the smallest level with enough pixels to be drawn at a scale
+ *
+ *  @param scale The number of pixels per point of the view (the zoom
+ *  scale multiplied by the screen scale)
+ *
+ *  @return The level
+ */
+-(NSUInteger)levelForScale:(CGFloat)scale{
+    CGFloat needed = self.bounds.size.width * scale;
+    NSUInteger level = 0;
+    while(level + 1 < levels && [self pixelSizeForLevel:level + 1].width >= needed){
+        level++;
+    }
+    return level;
+}
+/**
+ *  Decode a small version of the whole image on a background queue,
+ *  for placeholders or for sharing
+ *
+ *  @param pixelSize The maximum size (in pixels) of the image
+ *  @param call      A callback action to be called on the main thread with the image
+ */
+-(void)loadImageFittingSize:(CGSize)pixelSize onReady:(void (^)(UIImage *image))call{
+    CGFloat ratio = MIN(1.0, MIN(pixelSize.width / imageSize.width, pixelSize.height / imageSize.height));
+    CGFloat maxPixelSize = ceil(MAX(imageSize.width, imageSize.height) * ratio);
+    CGFloat screenScale = [UIScreen mainScreen].scale;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSDictionary *options = @{(id)kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+                                  (id)kCGImageSourceCreateThumbnailWithTransform: @YES,
+                                  (id)kCGImageSourceShouldCacheImmediately: @YES,
+                                  (id)kCGImageSourceThumbnailMaxPixelSize: @(maxPixelSize)};
+        CGImageRef decoded = NULL;
+        @synchronized(self){
+            decoded = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+        }
+        UIImage *result = decoded ? [UIImage imageWithCGImage:decoded scale:screenScale orientation:UIImageOrientationUp] : nil;
+        if(decoded) CGImageRelease(decoded);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if(call) call(result);
+        });
+    });
+}
+/**
+ *  Decode a level of the image, with its orientation applied
+ *
+ *  @param level The level (0 is the full size image)
+ *
+ *  @return The decoded image (it must be released) or NULL
+ */
+-(CGImageRef)newImageForLevel:(NSUInteger)level{
+    CGSize size = [self pixelSizeForLevel:level];
+    NSDictionary *options = @{(id)kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+                              (id)kCGImageSourceCreateThumbnailWithTransform: @YES,
+                              (id)kCGImageSourceShouldCacheImmediately: @YES,
+                              (id)kCGImageSourceThumbnailMaxPixelSize: @(MAX(size.width, size.height))};
+    return CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+}
+/**
+ *  Get a tile, cutting it from its level (or cutting the whole level, if
+ *  it's a small one) if it's not in the cache. It can be called from any
+ *  thread
+ *
+ *  @param level  The level
+ *  @param column The column of the tile
+ *  @param row    The row of the tile
+ *
+ *  @return The tile or nil if the level can't be decoded
+ */
+-(UIImage *)tileForLevel:(NSUInteger)level column:(NSUInteger)column row:(NSUInteger)row{
+    NSString *key = [OlapicTiledImageView keyForLevel:level column:column row:row];
+    UIImage *tile = [tiles objectForKey:key];
+    if(tile) return tile;
+    // The tiled layer draws several tiles at once; only one of them decodes
+    // the level, and the others wait here and then find the level (or
+    // their tile) in the cache
+    @synchronized(self){
+        tile = [tiles objectForKey:key];
+        if(!tile){
+            if([self isSmallLevel:level]){
+                [self cutLevel:level];
+                tile = [tiles objectForKey:key];
+            }else{
+                UIImage *levelImage = [self levelImageForLevel:level];
+                if(levelImage) tile = [self cutTileFromImage:levelImage.CGImage level:level column:column row:row];
+            }
+        }
+    }
+    return tile;
+}
+/**
+ *  Check if a level is small enough to be decoded whole and cut
+ *
+ *  @param level The level
+ *
+ *  @return YES if it fits in a few tiles
+ */
+-(BOOL)isSmallLevel:(NSUInteger)level{
+    CGSize size = [self pixelSizeForLevel:level];
+    // Up to 2x2 tiles (1MB), all the tiles are cut at once and the level
+    // is not kept
+    return MAX(size.width, size.height) <= OlapicTiledImageViewTileLength * 2;
+}
+/**
+ *  Get a decoded level from the cache, decoding it if it's not there
+ *
+ *  @param level The level
+ *
+ *  @return The decoded level or nil if it can't be decoded
+ */
+-(UIImage *)levelImageForLevel:(NSUInteger)level{
+    NSNumber *key = @(level);
+    UIImage *levelImage = [levelImages objectForKey:key];
+    if(levelImage) return levelImage;
+    CGImageRef decoded = [self newImageForLevel:level];
+    if(!decoded) return nil;
+    levelImage = [UIImage imageWithCGImage:decoded];
+    CGImageRelease(decoded);
+    NSUInteger levelCost = [OlapicImageMemoryManager costForImage:levelImage];
+    [levelImages setObject:levelImage forKey:key cost:levelCost];
+    [self changeTilesCost:levelCost adding:YES];
+    return levelImage;
+}
+/**
+ *  Cut a tile from a decoded level and put it in the cache
+ *
+ *  @param levelImage The decoded level
+ *  @param level      The level
+ *  @param column     The column of the tile
+ *  @param row        The row of the tile
+ *
+ *  @return The tile or nil if it's outside of the level
+ */
+-(UIImage *)cutTileFromImage:(CGImageRef)levelImage level:(NSUInteger)level column:(NSUInteger)column row:(NSUInteger)row{
+    size_t width = CGImageGetWidth(levelImage);
+    size_t height = CGImageGetHeight(levelImage);
+    size_t length = (size_t)OlapicTiledImageViewTileLength;
+    size_t x = column * length, y = row * length;
+    if(x >= width || y >= height) return nil;
+    size_t tileWidth = MIN(length, width - x);
+    size_t tileHeight = MIN(length, height - y);
+    CGImageRef crop = CGImageCreateWithImageInRect(levelImage, CGRectMake(x, y, tileWidth, tileHeight));
+    // A crop shares the pixels of the level, so it's drawn on its own
+    // bitmap to let the level go
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, tileWidth, tileHeight, 8, 0, colorSpace, kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Little);
+    CGColorSpaceRelease(colorSpace);
+    UIImage *tile = nil;
+    if(crop && context){
+        CGContextDrawImage(context, CGRectMake(0, 0, tileWidth, tileHeight), crop);
+        CGImageRef tileImage = CGBitmapContextCreateImage(context);
+        if(tileImage){
+            tile = [self cacheTile:tileImage forKey:[OlapicTiledImageView keyForLevel:level column:column row:row]];
+            CGImageRelease(tileImage);
+        }
+    }
+    if(context) CGContextRelease(context);
+    if(crop) CGImageRelease(crop);
+    return tile;
+}
+/**
+ *  Put a tile in the cache, counting its cost
+ *
+ *  @param tileImage The decoded tile
+ *  @param key       The tile key
+ *
+ *  @return The tile
+ */
+-(UIImage *)cacheTile:(CGImageRef)tileImage forKey:(NSString *)key{
+    UIImage *tile = [UIImage imageWithCGImage:tileImage];
+    NSUInteger tileCost = [OlapicImageMemoryManager costForImage:tile];
+    [tiles setObject:tile forKey:key cost:tileCost];
+    [self changeTilesCost:tileCost adding:YES];
+    return tile;
+}
+/**
+ *  Decode a small level and put all its tiles in the cache. The decoded
+ *  level is released after that, so only the tiles use memory
+ *
+ *  @param level The level
+ */
+-(void)cutLevel:(NSUInteger)level{
+    CGImageRef levelImage = [self newImageForLevel:level];
+    if(!levelImage) return;
+    size_t length = (size_t)OlapicTiledImageViewTileLength;
+    NSUInteger columns = (CGImageGetWidth(levelImage) + length - 1) / length;
+    NSUInteger rows = (CGImageGetHeight(levelImage) + length - 1) / length;
+    for(NSUInteger row = 0; row < rows; row++){
+        for(NSUInteger column = 0; column < columns; column++){
+            [self cutTileFromImage:levelImage level:level column:column row:row];
+        }
+    }
+    CGImageRelease(levelImage);
+}
+/**
+ *  Get the cache key of a tile
+ *
+ *  @param level  The level
+ *  @param column The column of the tile
+ *  @param row    The row of the tile
+ *
+ *  @return The key
+ */
++(NSString *)keyForLevel:(NSUInteger)level column:(NSUInteger)column row:(NSUInteger)row{
+    return [NSString stringWithFormat:@"%lu/%lu/%lu", (unsigned long)level, (unsigned long)column, (unsigned long)row];
+}
+/**
+ *  Add bytes to (or remove them from) the cost of the tiles and levels
+ *  and report it to the memory manager
+ *
+ *  @param cost   The number of bytes
+ *  @param adding NO to remove them
+ */
+-(void)changeTilesCost:(NSUInteger)cost adding:(BOOL)adding{
+    NSUInteger total;
+    @synchronized(tiles){
+        tilesCost = adding ? tilesCost + cost : (tilesCost > cost ? tilesCost - cost : 0);
+        total = tilesCost;
+    }
+    __weak OlapicTiledImageView *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        OlapicTiledImageView *strongSelf = weakSelf;
+        if(strongSelf) [[OlapicImageMemoryManager sharedManager] setCost:total forOwner:strongSelf];
+    });
+}
+/**
+ *  Release the decoded tiles and levels. The tiled layer keeps what it
+ *  already drew, and the tiles are decoded again if they are needed
+ */
+-(void)evictDecodedImages{
+    [tiles removeAllObjects];
+    [levelImages removeAllObjects];
+    @synchronized(tiles){
+        tilesCost = 0;
+    }
+    // Queued after the updates of the evicted tiles, so it's the last one
+    [self changeTilesCost:0 adding:YES];
+}
+#pragma mark - Cache delegate
+/**
+ *  Stop counting a tile or a level when its cache lets it go
+ *
+ *  @param cache The cache
+ *  @param obj   The tile or the level
+ */
+-(void)cache:(NSCache *)cache willEvictObject:(id)obj{
+    [self changeTilesCost:[OlapicImageMemoryManager costForImage:obj] adding:NO];
+}
+#pragma mark - Default cycle
+/**
+ *  Draw the tiles of the best level for the current scale. The tiled
+ *  layer calls this method on background threads, once for each of its
+ *  tiles, with a context already scaled for the zoom
+ *
+ *  @param rect The part of the view to draw
+ */
+-(void)drawRect:(CGRect)rect{
+    CGContextRef context = UIGraphicsGetCurrentContext();
+    CGFloat scale = fabs(CGContextGetCTM(context).a);
+    NSUInteger level = [self levelForScale:scale];
+    CGSize levelSize = [self pixelSizeForLevel:level];
+    CGSize viewSize = self.bounds.size;
+    if(viewSize.width < 1 || viewSize.height < 1) return;
+    // The level pixels for each point of the view
+    CGFloat factorX = levelSize.width / viewSize.width;
+    CGFloat factorY = levelSize.height / viewSize.height;
+    CGFloat length = OlapicTiledImageViewTileLength;
+    NSUInteger columns = (NSUInteger)ceil(levelSize.width / length);
+    NSUInteger rows = (NSUInteger)ceil(levelSize.height / length);
+    NSUInteger firstColumn = (NSUInteger)MAX(0, floor(CGRectGetMinX(rect) * factorX / length));
+    NSUInteger lastColumn = MIN(columns, (NSUInteger)MAX(0, ceil(CGRectGetMaxX(rect) * factorX / length)));
+    NSUInteger firstRow = (NSUInteger)MAX(0, floor(CGRectGetMinY(rect) * factorY / length));
+    NSUInteger lastRow = MIN(rows, (NSUInteger)MAX(0, ceil(CGRectGetMaxY(rect) * factorY / length)));
+    for(NSUInteger row = firstRow; row < lastRow; row++){
+        for(NSUInteger column = firstColumn; column < lastColumn; column++){
+            UIImage *tile = [self tileForLevel:level column:column row:row];
+            if(!tile) continue;
+            CGRect tileRect = CGRectMake(column * length / factorX, row * length / factorY, tile.size.width / factorX, tile.size.height / factorY);
+            [tile drawInRect:tileRect];
+        }
+    }
+}
+/**
+ *  Stop counting the tiles and release the image source
+ */
+-(void)dealloc{
+    tiles.delegate = nil;
+    levelImages.delegate = nil;
+    [[OlapicImageMemoryManager sharedManager] removeOwner:self];
+    if(source) CFRelease(source);
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,95 @@
+//
+//  OlapicMediaCollection.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+/**
+ *  A read only array that shows the media of all the pages of a list
+ *  as a single list, without copying them. It reads the list pages
+ *  directly, so it's always up to date:
+ *
+ *  - count is O(1)
+ *  - objectAtIndex: is O(1) when all the pages (but the last one)
+ *    have the same size, which is what the API returns, and
+ *    O(log pages) otherwise
+ *  - Fast enumeration (for...in) walks the pages without copying them
+ *
+ *  The page offsets are cached and rebuilt when the owner of the pages
+ *  calls pagesDidChange, which also makes the for...in loops that are
+ *  walking the pages fail. It should only be used from the thread that
+ *  changes the pages.
+ */
+@interface OlapicMediaCollection : NSArray{
+    /**
+     *  The list pages, each one a dictionary with a 'media' array
+     */
+    NSArray *pages;
+    /**
+     *  Bumped each time the pages change
+     */
+    unsigned long mutations;
+    /**
+     *  The value of mutations when the cache was built
+     */
+    unsigned long cachedMutations;
+    /**
+     *  The number of pages when the cache was built
+     */
+    NSUInteger cachedPageCount;
+    /**
+     *  The total number of media
+     */
+    NSUInteger cachedCount;
+    /**
+     *  The size of the pages, if all of them have the same size (the
+     *  last one can be shorter), or 0 if they don't
+     */
+    NSUInteger uniformPageSize;
+    /**
+     *  The offset of the first media of each page
+     */
+    NSUInteger *pageOffsets;
+}
+/**
+ *  Class constructor
+ *
+ *  @param listPages The list pages (usually OlapicMediaList's pages), it's not copied
+ *
+ *  @return An instance of this object (OlapicMediaCollection)
+ */
+-(id)initWithPages:(NSArray *)listPages;
+/**
+ *  Tell the collection that pages were added, removed or replaced. It
+ *  must be called after every change of the pages
+ */
+-(void)pagesDidChange;
+
+@end
\ No newline at end of file
@@ -0,0 +1,187 @@
+//
+//  OlapicMediaCollection.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicMediaCollection.h"
+
+@interface OlapicMediaCollection()
+/**
+ *  Rebuild the page offsets if the pages changed
+ */
+-(void)updateCache;
+/**
+ *  Get the media of a page
+ *
+ *  @param pageIndex The page index
+ *
+ *  @return The page media
+ */
+-(NSArray *)mediaForPage:(NSUInteger)pageIndex;
+
+@end
+
+@implementation OlapicMediaCollection
+/**
+ *  Class constructor
+ *
+ *  @param listPages The list pages (usually OlapicMediaList's pages), it's not copied
+ *
+ *  @return An instance of this object (OlapicMediaCollection)
+ */
+-(id)initWithPages:(NSArray *)listPages{
+    self = [super init];
+    if(self){
+        pages = listPages;
+        // Different, so the first use builds the cache
+        mutations = 1;
+        cachedMutations = 0;
+        cachedPageCount = 0;
+    }
+    return self;
+}
+/**
+ *  Tell the collection that pages were added, removed or replaced. It
+ *  must be called after every change of the pages
+ */
+-(void)pagesDidChange{
+    mutations++;
+}
+/**
+ *  Get the media of a page
+ *
+ *  @param pageIndex The page index
+ *
+ *  @return The page media
+ */
+-(NSArray *)mediaForPage:(NSUInteger)pageIndex{
+    return [[pages objectAtIndex:pageIndex] objectForKey:@"media"];
+}
+/**
+ *  Rebuild the page offsets if the pages changed
+ */
+-(void)updateCache{
+    if(cachedMutations == mutations) return;
+    NSUInteger pageCount = [pages count];
+    cachedMutations = mutations;
+    cachedPageCount = pageCount;
+    free(pageOffsets);
+    pageOffsets = pageCount ? malloc(sizeof(NSUInteger) * pageCount) : NULL;
+    cachedCount = 0;
+    uniformPageSize = pageCount ? [[self mediaForPage:0] count] : 0;
+    for(NSUInteger i = 0; i < pageCount; i++){
+        NSUInteger size = [[self mediaForPage:i] count];
+        pageOffsets[i] = cachedCount;
+        cachedCount += size;
+        // The last page can be shorter, but not longer: its extra
+        // media would be looked up on a page that doesn't exist
+        if(i < pageCount - 1 ? size != uniformPageSize : size > uniformPageSize){
+            uniformPageSize = 0;
+        }
+    }
+}
+/**
+ *  Get the number of media in all the pages
+ *
+ *  @return The number of media
+ */
+-(NSUInteger)count{
+    [self updateCache];
+    return cachedCount;
+}
+/**
+ *  Get a media
+ *
+ *  @param index The media index
+ *
+ *  @return The media entity
+ */
+-(id)objectAtIndex:(NSUInteger)index{
+    [self updateCache];
+    if(index >= cachedCount){
+        [NSException raise:NSRangeException format:@"Index %lu beyond bounds [0 .. %ld]", (unsigned long)index, (long)cachedCount - 1];
+    }
+    if(uniformPageSize){
+        return [[self mediaForPage:index / uniformPageSize] objectAtIndex:index % uniformPageSize];
+    }
+    // Binary search for the last page that starts before the index
+    NSUInteger low = 0, high = cachedPageCount - 1;
+    while(low < high){
+        NSUInteger middle = (low + high + 1) / 2;
+        if(pageOffsets[middle] <= index){
+            low = middle;
+        }else{
+            high = middle - 1;
+        }
+    }
+    return [[self mediaForPage:low] objectAtIndex:index - pageOffsets[low]];
+}
+/**
+ *  Walk the pages for the for...in loops. Each call returns the
+ *  media of a page (or as much of it as fits on the buffer)
+ *
+ *  @param state  The enumeration state: extra[0] is the page, extra[1] the index in that page. A call to pagesDidChange during the loop makes it fail
+ *  @param buffer A buffer to put the objects
+ *  @param len    The buffer size
+ *
+ *  @return The number of objects returned
+ */
+-(NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len{
+    if(state->state == 0){
+        state->state = 1;
+        state->extra[0] = 0;
+        state->extra[1] = 0;
+        state->mutationsPtr = &mutations;
+    }
+    while(state->extra[0] < [pages count]){
+        NSArray *media = [self mediaForPage:state->extra[0]];
+        NSUInteger start = state->extra[1];
+        NSUInteger available = [media count] - start;
+        if(available == 0){
+            state->extra[0]++;
+            state->extra[1] = 0;
+            continue;
+        }
+        NSUInteger length = MIN(available, len);
+        [media getObjects:buffer range:NSMakeRange(start, length)];
+        state->extra[1] += length;
+        state->itemsPtr = buffer;
+        return length;
+    }
+    return 0;
+}
+/**
+ *  Free the page offsets
+ */
+-(void)dealloc{
+    free(pageOffsets);
+}
+
+@end
\ No newline at end of file
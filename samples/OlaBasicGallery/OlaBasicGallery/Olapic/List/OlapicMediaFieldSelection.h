@@ -0,0 +1,98 @@
+//
+//  OlapicMediaFieldSelection.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+/**
+ *  The fields and embedded resources a list needs from each media
+ *  (for example, only the square image, the ID and the location for
+ *  a map). The rest of the media JSON is removed when the page is
+ *  parsed, before the entities are created.
+ *
+ *  The paths use slashes, like OlapicEntity's get: ('images/square').
+ *  The 'id' and '_links' fields are always kept.
+ */
+@interface OlapicMediaFieldSelection : NSObject{
+    /**
+     *  The field paths to keep
+     */
+    NSArray *fields;
+    /**
+     *  The names of the '_embedded' resources to keep
+     */
+    NSArray *embeds;
+    /**
+     *  If the selection should also be sent to the API, as the 'fields'
+     *  and 'embed' parameters, so it can skip the rest of the payload
+     */
+    BOOL sendsParameters;
+    /**
+     *  The paths split in components, as a tree
+     */
+    NSDictionary *tree;
+}
+
+@property (nonatomic,strong,readonly) NSArray *fields;
+@property (nonatomic,strong,readonly) NSArray *embeds;
+@property (nonatomic) BOOL sendsParameters;
+/**
+ *  Class constructor
+ *
+ *  @param fieldPaths     The field paths to keep
+ *  @param embeddedNames  The names of the '_embedded' resources to keep
+ *
+ *  @return An instance of this object (OlapicMediaFieldSelection)
+ */
+-(id)initWithFields:(NSArray *)fieldPaths embeds:(NSArray *)embeddedNames;
+/**
+ *  Get the query string parameters for the selection
+ *
+ *  @return The parameters, or an empty dictionary if they're not sent
+ */
+-(NSDictionary *)parameters;
+/**
+ *  Remove the fields that are not selected from a media JSON object
+ *
+ *  @param JSON The media JSON object
+ *
+ *  @return A new JSON object with only the selected fields
+ */
+-(NSDictionary *)pruneJSON:(NSDictionary *)JSON;
+/**
+ *  Remove the fields that are not selected from a list of media JSON objects
+ *
+ *  @param items The media JSON objects
+ *
+ *  @return The pruned JSON objects
+ */
+-(NSArray *)pruneItems:(NSArray *)items;
+
+@end
\ No newline at end of file
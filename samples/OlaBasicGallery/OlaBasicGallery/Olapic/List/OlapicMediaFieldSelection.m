@@ -0,0 +1,149 @@
+//
+//  OlapicMediaFieldSelection.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicMediaFieldSelection.h"
+
+@interface OlapicMediaFieldSelection()
+/**
+ *  Copy the values of a JSON object that are on a tree of paths
+ *
+ *  @param JSON   The JSON object
+ *  @param branch The paths tree (an empty dictionary means 'everything')
+ *
+ *  @return The pruned JSON object
+ */
++(id)pruneValue:(id)JSON withTree:(NSDictionary *)branch;
+
+@end
+
+@implementation OlapicMediaFieldSelection
+
+@synthesize fields,embeds,sendsParameters;
+/**
+ *  Class constructor
+ *
+ *  @param fieldPaths     The field paths to keep
+ *  @param embeddedNames  The names of the '_embedded' resources to keep
+ *
+ *  @return An instance of this object (OlapicMediaFieldSelection)
+ */
+-(id)initWithFields:(NSArray *)fieldPaths embeds:(NSArray *)embeddedNames{
+    self = [super init];
+    if(self){
+        fields = [fieldPaths copy] ?: @[];
+        embeds = [embeddedNames copy] ?: @[];
+        sendsParameters = NO;
+        NSMutableArray *paths = [NSMutableArray arrayWithArray:fields];
+        [paths addObject:@"id"];
+        [paths addObject:@"_links"];
+        for(NSString *name in embeds){
+            [paths addObject:[@"_embedded/" stringByAppendingString:name]];
+        }
+        // Build the tree: each node is a dictionary of its children,
+        // and a selected path ends on an empty dictionary
+        NSMutableDictionary *root = [[NSMutableDictionary alloc] init];
+        for(NSString *path in paths){
+            NSMutableDictionary *node = root;
+            NSArray *components = [path componentsSeparatedByString:@"/"];
+            for(NSUInteger i = 0; i < [components count]; i++){
+                NSString *component = [components objectAtIndex:i];
+                if(![component length]) continue;
+                NSMutableDictionary *child = [node objectForKey:component];
+                if(child && ![child count]) break;
+                if(!child || i == [components count] - 1){
+                    child = [[NSMutableDictionary alloc] init];
+                    [node setObject:child forKey:component];
+                }
+                node = child;
+            }
+        }
+        tree = root;
+    }
+    return self;
+}
+/**
+ *  Get the query string parameters for the selection
+ *
+ *  @return The parameters, or an empty dictionary if they're not sent
+ */
+-(NSDictionary *)parameters{
+    if(!sendsParameters) return @{};
+    NSMutableDictionary *parameters = [[NSMutableDictionary alloc] init];
+    NSMutableArray *names = [NSMutableArray arrayWithArray:fields];
+    [names addObject:@"id"];
+    [parameters setValue:[[names componentsJoinedByString:@","] stringByReplacingOccurrencesOfString:@"/" withString:@"."] forKey:@"fields"];
+    [parameters setValue:[embeds count] ? [embeds componentsJoinedByString:@","] : @"none" forKey:@"embed"];
+    return parameters;
+}
+/**
+ *  Remove the fields that are not selected from a media JSON object
+ *
+ *  @param JSON The media JSON object
+ *
+ *  @return A new JSON object with only the selected fields
+ */
+-(NSDictionary *)pruneJSON:(NSDictionary *)JSON{
+    return [OlapicMediaFieldSelection pruneValue:JSON withTree:tree];
+}
+/**
+ *  Remove the fields that are not selected from a list of media JSON objects
+ *
+ *  @param items The media JSON objects
+ *
+ *  @return The pruned JSON objects
+ */
+-(NSArray *)pruneItems:(NSArray *)items{
+    NSMutableArray *pruned = [[NSMutableArray alloc] initWithCapacity:[items count]];
+    for(id item in items){
+        [pruned addObject:[self pruneJSON:item]];
+    }
+    return pruned;
+}
+/**
+ *  Copy the values of a JSON object that are on a tree of paths
+ *
+ *  @param JSON   The JSON object
+ *  @param branch The paths tree (an empty dictionary means 'everything')
+ *
+ *  @return The pruned JSON object
+ */
++(id)pruneValue:(id)JSON withTree:(NSDictionary *)branch{
+    if(![branch count] || ![JSON isKindOfClass:[NSDictionary class]]) return JSON;
+    NSMutableDictionary *pruned = [[NSMutableDictionary alloc] initWithCapacity:[branch count]];
+    for(NSString *key in branch){
+        id value = [JSON objectForKey:key];
+        if(value) [pruned setObject:[self pruneValue:value withTree:[branch objectForKey:key]] forKey:key];
+    }
+    return pruned;
+}
+
+@end
\ No newline at end of file
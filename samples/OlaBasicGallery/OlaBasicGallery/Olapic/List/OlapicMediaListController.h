@@ -0,0 +1,393 @@
+//
+//  OlapicMediaListController.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+#import "OlapicNetworkTask.h"
+#import "OlapicMediaCollection.h"
+#import "OlapicMediaCache.h"
+#import "OlapicMediaFieldSelection.h"
+#import "OlapicMediaShuffle.h"
+
+@protocol OlapicMediaListControllerDelegate;
+/**
+ *  Pages with this many media (or more) intern their JSON in parallel
+ */
+static NSUInteger const OlapicMediaListParallelParsingThreshold = 16;
+/**
+ *  The direction of a page request
+ */
+typedef NS_ENUM(NSInteger, OlapicMediaListDirection){
+    /**
+     *  The first page of the list
+     */
+    OlapicMediaListDirectionInitial = 0,
+    /**
+     *  The page after the last loaded one
+     */
+    OlapicMediaListDirectionNext = 1,
+    /**
+     *  The page before the first loaded one
+     */
+    OlapicMediaListDirectionPrevious = 2,
+    /**
+     *  The media added since the list was loaded, before the first
+     *  loaded one (only for lists sorted by date)
+     */
+    OlapicMediaListDirectionNewer = 3
+};
+/**
+ *  Drives the pagination of an OlapicMediaList using the sample's
+ *  network client, so the requests the list makes can be cancelled,
+ *  suspended and resumed. The list keeps its URLs, pages, offset and
+ *  delegate, this object just takes care of the requests.
+ *
+ *  The image requests started for the list media can be registered
+ *  as dependent tasks, so they go away with the list.
+ *
+ *  Every cancel or suspend cancels the page request, so its JSON isn't
+ *  parsed, and starts a new 'generation' (only read on the main thread):
+ *  a response from a previous generation that was already parsed is
+ *  dropped before it reaches the delegate.
+ *
+ *  The JSON parsing and the entities creation run on the network
+ *  client's processingQueue (the interning in parallel for big pages), and only the
+ *  delegate methods are called on the main thread.
+ *
+ *  If a cachePath is set, the first page is saved there as an
+ *  OlapicMediaCache, so the next launch can show it right away.
+ *
+ *  A fieldSelection limits the media fields the list keeps (and asks
+ *  for, if the selection sends its parameters).
+ *
+ *  A list sorted by date (OlapicMediaListSortingTypeRecent) can be
+ *  refreshed with loadNewerMedia: it requests the first pages until it
+ *  finds the newest media it already has, keeps only what's newer and
+ *  puts it before the rest. The controller's own delegate is always told
+ *  when it's done (even when nothing is new), with
+ *  OlapicMediaListController:didLoadNewerMedia:. Since the offsets of
+ *  the next pages move, the media they repeat is skipped.
+ *
+ *  With a shuffle, every page of a shuffled list is put in the stable
+ *  order of its seed (see OlapicMediaShuffle) before it's added. The
+ *  media that was already loaded is never added again.
+ */
+@interface OlapicMediaListController : NSObject{
+    /**
+     *  The delegate for the events of the controller itself (the
+     *  list events go to the list delegate)
+     */
+    id <OlapicMediaListControllerDelegate>__weak delegate;
+    /**
+     *  The list this object loads
+     */
+    OlapicMediaList *list;
+    /**
+     *  The page request currently running
+     */
+    OlapicNetworkTask *pageTask;
+    /**
+     *  The direction of the page request currently running
+     */
+    OlapicMediaListDirection pageDirection;
+    /**
+     *  The image requests (or any other) started for this list
+     */
+    NSHashTable *dependentTasks;
+    /**
+     *  Incremented every time the running requests become obsolete
+     */
+    NSUInteger generation;
+    /**
+     *  If the list is suspended
+     */
+    BOOL suspended;
+    /**
+     *  If the list was cancelled
+     */
+    BOOL cancelled;
+    /**
+     *  If the page request should be sent again when the list resumes
+     */
+    BOOL resumesPageRequest;
+    /**
+     *  If the first page was already loaded
+     */
+    BOOL loadedFirstPage;
+    /**
+     *  A read only view of all the list media
+     */
+    OlapicMediaCollection *media;
+    /**
+     *  The last page that was loaded
+     */
+    NSDictionary *currentPage;
+    /**
+     *  Where to save the first page (optional)
+     */
+    NSString *cachePath;
+    /**
+     *  The media fields the list needs (optional, all of them by default)
+     */
+    OlapicMediaFieldSelection *fieldSelection;
+    /**
+     *  The maximum number of pages loadNewerMedia requests before
+     *  giving up on finding the media it already has
+     */
+    NSUInteger newerPagesLimit;
+    /**
+     *  How many media were added before the first page, which moved
+     *  the offsets of the next pages
+     */
+    NSUInteger newerMediaCount;
+    /**
+     *  Shuffles the pages on the device (optional)
+     */
+    OlapicMediaShuffle *shuffle;
+    /**
+     *  The callback for when the first page is loaded (optional)
+     */
+    void (^firstPageCallback)(NSDictionary *page);
+    /**
+     *  The callback for when the first page fails (optional)
+     */
+    void (^firstPageFailureCallback)(NSError *error);
+}
+
+@property (nonatomic,weak) id <OlapicMediaListControllerDelegate>__weak delegate;
+@property (nonatomic,strong,readonly) OlapicMediaList *list;
+@property (nonatomic,readonly) BOOL suspended;
+@property (nonatomic,readonly) BOOL cancelled;
+@property (nonatomic,copy) NSString *cachePath;
+@property (nonatomic,strong) OlapicMediaFieldSelection *fieldSelection;
+@property (nonatomic,readonly) OlapicMediaListDirection pageDirection;
+@property (nonatomic) NSUInteger newerPagesLimit;
+@property (nonatomic,strong) OlapicMediaShuffle *shuffle;
+/**
+ *  Class constructor
+ *
+ *  @param mediaList The list to load. Its delegate will receive the events
+ *
+ *  @return An instance of this object (OlapicMediaListController)
+ */
+-(id)initWithList:(OlapicMediaList *)mediaList;
+/**
+ *  Start downloading media objects
+ */
+-(void)startFetching;
+/**
+ *  Start downloading media objects, and get the first page (or its
+ *  error) before the list delegate does. The page is requested like
+ *  startFetching does, with the fieldSelection and the cachePath
+ *
+ *  @param loaded  A callback for when the first page is loaded, called on the main thread just before the page is added to the list
+ *  @param failure A callback for when the first page fails, called on the main thread before the list delegate is informed
+ */
+-(void)startFetchingOnFirstPage:(void (^)(NSDictionary *page))loaded onFailure:(void (^)(NSError *error))failure;
+/**
+ *  Start the list with a first page that was already loaded, instead
+ *  of requesting it
+ *
+ *  @param page The page, with the 'links' and 'media' keys
+ */
+-(void)startWithPage:(NSDictionary *)page;
+/**
+ *  Check if there's a previous page that can be loaded
+ *
+ *  @return If a previous page exists
+ */
+-(BOOL)canLoadPreviousPage;
+/**
+ *  Load the previous page
+ */
+-(void)loadPreviousPage;
+/**
+ *  Check if there's a new page that can be loaded
+ *
+ *  @return If a new page can be loaded
+ */
+-(BOOL)canLoadNextPage;
+/**
+ *  Load a new page
+ */
+-(void)loadNextPage;
+/**
+ *  Check if the list can load the media added since it was loaded
+ *
+ *  @return If the list is sorted by date (and not shuffled) and has its first page
+ */
+-(BOOL)canLoadNewerMedia;
+/**
+ *  Load the media added since the newest one on the list, using it as
+ *  a cursor, and put it before the rest
+ */
+-(void)loadNewerMedia;
+/**
+ *  Check if the list is currenly downloading media
+ *
+ *  @return If the list is downloading
+ */
+-(BOOL)fetching;
+/**
+ *  Get all the media currently saved on the list. Unlike OlapicMediaList's
+ *  getMedia, it doesn't create a new array: it's always the same read
+ *  only view over the list pages
+ *
+ *  @return An array of OlapicMediaEntity objects
+ */
+-(NSArray *)getMedia;
+/**
+ *  Get the media of the last page that was loaded, without copying it
+ *
+ *  @return An array of OlapicMediaEntity objects
+ */
+-(NSArray *)getCurrentPageMedia;
+/**
+ *  Get the media saved on the cachePath by a previous session. The
+ *  file is memory mapped and the entities are read when they're used
+ *
+ *  @return An array of OlapicMediaEntity objects, or nil if there's no cache
+ */
+-(NSArray *)getCachedMedia;
+/**
+ *  Register a request that depends on the list (like a thumbnail),
+ *  so it gets cancelled with it
+ *
+ *  @param task The request task
+ */
+-(void)addDependentTask:(OlapicNetworkTask *)task;
+/**
+ *  Read a page response and create the media entities. It can be
+ *  called from any thread
+ *
+ *  @param responseData The response data
+ *  @param error        A reference to save the error, if the response is not valid
+ *
+ *  @return A dictionary with the 'links' and 'media' keys
+ */
++(NSDictionary *)pageFromResponseData:(NSData *)responseData error:(NSError **)error;
+/**
+ *  Add the list field selection parameters to the parameters of a request
+ *
+ *  @param parameters The request parameters
+ *  @param selection  The field selection (or nil)
+ *
+ *  @return The parameters for the request
+ */
++(NSDictionary *)parameters:(NSDictionary *)parameters withSelection:(OlapicMediaFieldSelection *)selection;
+/**
+ *  Read a page response and create the media entities with only the
+ *  selected fields. It can be called from any thread
+ *
+ *  @param responseData The response data
+ *  @param selection    The fields to keep (nil to keep all of them)
+ *  @param error        A reference to save the error, if the response is not valid
+ *
+ *  @return A dictionary with the 'links' and 'media' keys
+ */
++(NSDictionary *)pageFromResponseData:(NSData *)responseData selection:(OlapicMediaFieldSelection *)selection error:(NSError **)error;
+/**
+ *  Read a page response and create the media entities that are newer
+ *  than the ones already loaded. The items are read in order until the
+ *  first one that is known (by ID) or older than a date. It can be
+ *  called from any thread
+ *
+ *  @param responseData The response data
+ *  @param selection    The fields to keep (nil to keep all of them)
+ *  @param identifiers  The IDs of the media already loaded
+ *  @param date         The date of the newest media already loaded (or nil)
+ *  @param error        A reference to save the error, if the response is not valid
+ *
+ *  @return A dictionary with the 'links' and 'media' keys, and 'overlaps'
+ *  (YES if it found a known media)
+ */
++(NSDictionary *)pageFromResponseData:(NSData *)responseData selection:(OlapicMediaFieldSelection *)selection newerThanIdentifiers:(NSSet *)identifiers date:(NSDate *)date error:(NSError **)error;
+/**
+ *  Read a date of the API (ISO 8601, like '2014-06-11T16:43:42+00:00').
+ *  It can be called from any thread
+ *
+ *  @param value The date string
+ *
+ *  @return The date, or nil if it's not a valid date
+ */
++(NSDate *)dateFromString:(NSString *)value;
+/**
+ *  Create the media entities for a page, sharing the repeated content
+ *  between them. The JSON of big pages is interned on all the available
+ *  cores, and the entities are created after that. It can be called
+ *  from any thread
+ *
+ *  @param items The media JSON objects
+ *
+ *  @return An array of OlapicMediaEntity objects, in the same order
+ */
++(NSArray *)entitiesFromJSONItems:(NSArray *)items;
+/**
+ *  Cancel the page request and all the dependent requests. The
+ *  list won't load anything else and no more delegate methods will
+ *  be called
+ */
+-(void)cancel;
+/**
+ *  Stop the page request, to be sent again on resume. The responses
+ *  that arrive while the list is suspended are ignored
+ */
+-(void)suspend;
+/**
+ *  Resume a suspended list, sending again the page request that was
+ *  running when it was suspended
+ */
+-(void)resume;
+
+@end
+/**
+ *  The protocol that handles the events of the controller
+ */
+@protocol OlapicMediaListControllerDelegate <NSObject>
+/**
+ *  A loadNewerMedia request finished. The media is already before
+ *  the rest on the list
+ *
+ *  @param controller The controller object that generated the event
+ *  @param media      The new media, the newest first (empty if there's nothing new)
+ */
+-(void)OlapicMediaListController:(OlapicMediaListController *)controller didLoadNewerMedia:(NSArray *)media;
+@optional
+/**
+ *  A loadNewerMedia request failed. The list delegate also receives the error
+ *
+ *  @param controller The controller object that generated the event
+ *  @param error      The error containing the reason why the request failed
+ */
+-(void)OlapicMediaListController:(OlapicMediaListController *)controller didFailToLoadNewerMediaWithError:(NSError *)error;
+
+@end
\ No newline at end of file
@@ -0,0 +1,745 @@
+//
+//  OlapicMediaListController.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicMediaListController.h"
+#import "OlapicNetworkClient.h"
+#import "OlapicIdentityMap.h"
+#import "OlapicPayloadDecoder.h"
+#import "OlapicMediaStore.h"
+#import "OlapicSearchIndex.h"
+#import "OlapicEntityInterner.h"
+
+@interface OlapicMediaListController()
+/**
+ *  Request a page
+ *
+ *  @param URL        The page URL
+ *  @param parameters The parameters for the query string
+ *  @param direction  Where the page goes on the list
+ */
+-(void)loadPageFromURL:(NSString *)URL parameters:(NSDictionary *)parameters direction:(OlapicMediaListDirection)direction;
+/**
+ *  Add a page to the list and inform the delegate
+ *
+ *  @param page      The page, with the 'links' and 'media' keys
+ *  @param direction Where the page goes on the list
+ */
+-(void)addPage:(NSDictionary *)page direction:(OlapicMediaListDirection)direction;
+/**
+ *  Inform the delegate about an error
+ *
+ *  @param error     The error
+ *  @param direction The direction of the failed request
+ */
+-(void)failWithError:(NSError *)error direction:(OlapicMediaListDirection)direction;
+/**
+ *  Get the URL of a pagination link
+ *
+ *  @param name  The link name ('next', 'prev')
+ *  @param links The API pagination links
+ *
+ *  @return The URL, or nil if the link doesn't exist
+ */
+-(NSString *)URLForLink:(NSString *)name inLinks:(NSDictionary *)links;
+/**
+ *  Request a page of the media newer than the loaded ones
+ *
+ *  @param URL        The page URL
+ *  @param parameters The parameters for the query string
+ *  @param collected  The newer media found on the previous pages
+ *  @param pagesLeft  How many pages can still be requested
+ */
+-(void)loadNewerMediaFromURL:(NSString *)URL parameters:(NSDictionary *)parameters collected:(NSArray *)collected pagesLeft:(NSUInteger)pagesLeft;
+/**
+ *  Put the newer media before the rest and inform the delegate
+ *
+ *  @param newer The media, the newest first
+ */
+-(void)addNewerMedia:(NSArray *)newer;
+/**
+ *  Remove the media that is already on the list from a page
+ *
+ *  @param page The page, with the 'links' and 'media' keys
+ *
+ *  @return A page with only the media that is not loaded
+ */
+-(NSDictionary *)pageWithoutLoadedMedia:(NSDictionary *)page;
+/**
+ *  Call (and forget) the first page callbacks
+ *
+ *  @param page  The first page, or nil if it failed
+ *  @param error The error, if it failed
+ */
+-(void)firstPageDidLoad:(NSDictionary *)page error:(NSError *)error;
+
+@end
+
+@implementation OlapicMediaListController
+@synthesize delegate,list,suspended,cancelled,cachePath,fieldSelection,pageDirection,newerPagesLimit,shuffle;
+/**
+ *  Class constructor
+ *
+ *  @param mediaList The list to load. Its delegate will receive the events
+ *
+ *  @return An instance of this object (OlapicMediaListController)
+ */
+-(id)initWithList:(OlapicMediaList *)mediaList{
+    self = [super init];
+    if(self){
+        list = mediaList;
+        dependentTasks = [NSHashTable weakObjectsHashTable];
+        generation = 0;
+        suspended = NO;
+        cancelled = NO;
+        resumesPageRequest = NO;
+        loadedFirstPage = NO;
+        newerPagesLimit = 5;
+        newerMediaCount = 0;
+        if(!list.pages) list.pages = [[NSMutableArray alloc] init];
+        media = [[OlapicMediaCollection alloc] initWithPages:list.pages];
+    }
+    return self;
+}
+/**
+ *  Start downloading media objects
+ */
+-(void)startFetching{
+    if(loadedFirstPage || [self fetching]) return;
+    NSMutableDictionary *parameters = [[NSMutableDictionary alloc] init];
+    [parameters setValue:[NSString stringWithFormat:@"%ld",(long)list.mediaPerPage] forKey:@"count"];
+    if(list.currentOffset > 0){
+        [parameters setValue:[NSString stringWithFormat:@"%ld",(long)list.currentOffset] forKey:@"offset"];
+    }
+    [self loadPageFromURL:list.initialURL parameters:parameters direction:OlapicMediaListDirectionInitial];
+}
+/**
+ *  Start downloading media objects, and get the first page (or its
+ *  error) before the list delegate does. The page is requested like
+ *  startFetching does, with the fieldSelection and the cachePath
+ *
+ *  @param loaded  A callback for when the first page is loaded, called on the main thread just before the page is added to the list
+ *  @param failure A callback for when the first page fails, called on the main thread before the list delegate is informed
+ */
+-(void)startFetchingOnFirstPage:(void (^)(NSDictionary *page))loaded onFailure:(void (^)(NSError *error))failure{
+    if(loadedFirstPage || [self fetching] || cancelled) return;
+    firstPageCallback = loaded;
+    firstPageFailureCallback = failure;
+    [self startFetching];
+}
+/**
+ *  Call (and forget) the first page callbacks
+ *
+ *  @param page  The first page, or nil if it failed
+ *  @param error The error, if it failed
+ */
+-(void)firstPageDidLoad:(NSDictionary *)page error:(NSError *)error{
+    void (^loaded)(NSDictionary *page) = firstPageCallback;
+    void (^failure)(NSError *error) = firstPageFailureCallback;
+    firstPageCallback = nil;
+    firstPageFailureCallback = nil;
+    if(page){
+        if(loaded) loaded(page);
+    }else if(failure){
+        failure(error);
+    }
+}
+/**
+ *  Start the list with a first page that was already loaded, instead
+ *  of requesting it
+ *
+ *  @param page The page, with the 'links' and 'media' keys
+ */
+-(void)startWithPage:(NSDictionary *)page{
+    if(loadedFirstPage || [self fetching] || cancelled || !page) return;
+    [self addPage:page direction:OlapicMediaListDirectionInitial];
+}
+/**
+ *  Check if there's a previous page that can be loaded
+ *
+ *  @return If a previous page exists
+ */
+-(BOOL)canLoadPreviousPage{
+    return [list.prevURL length] > 0;
+}
+/**
+ *  Load the previous page
+ */
+-(void)loadPreviousPage{
+    if(![self canLoadPreviousPage] || [self fetching]) return;
+    [self loadPageFromURL:[list.prevURL copy] parameters:nil direction:OlapicMediaListDirectionPrevious];
+}
+/**
+ *  Check if there's a new page that can be loaded
+ *
+ *  @return If a new page can be loaded
+ */
+-(BOOL)canLoadNextPage{
+    return [list.nextURL length] > 0;
+}
+/**
+ *  Load a new page
+ */
+-(void)loadNextPage{
+    if(![self canLoadNextPage] || [self fetching]) return;
+    [self loadPageFromURL:[list.nextURL copy] parameters:nil direction:OlapicMediaListDirectionNext];
+}
+/**
+ *  Check if the list can load the media added since it was loaded
+ *
+ *  @return If the list is sorted by date (and not shuffled) and has its first page
+ */
+-(BOOL)canLoadNewerMedia{
+    return loadedFirstPage && !shuffle && list.sorting == OlapicMediaListSortingTypeRecent && [list.initialURL length] > 0;
+}
+/**
+ *  Load the media added since the newest one on the list, using it as
+ *  a cursor, and put it before the rest
+ */
+-(void)loadNewerMedia{
+    if(![self canLoadNewerMedia] || [self fetching]) return;
+    // The media endpoints only page by count and offset (there's no
+    // 'since' ID or date parameter), so the cursor is applied here,
+    // on the first pages of the list
+    NSMutableDictionary *parameters = [[NSMutableDictionary alloc] init];
+    [parameters setValue:[NSString stringWithFormat:@"%ld",(long)list.mediaPerPage] forKey:@"count"];
+    [self loadNewerMediaFromURL:list.initialURL parameters:parameters collected:@[] pagesLeft:MAX(newerPagesLimit, (NSUInteger)1)];
+}
+/**
+ *  Request a page of the media newer than the loaded ones
+ *
+ *  @param URL        The page URL
+ *  @param parameters The parameters for the query string
+ *  @param collected  The newer media found on the previous pages
+ *  @param pagesLeft  How many pages can still be requested
+ */
+-(void)loadNewerMediaFromURL:(NSString *)URL parameters:(NSDictionary *)parameters collected:(NSArray *)collected pagesLeft:(NSUInteger)pagesLeft{
+    if(cancelled || !URL) return;
+    pageDirection = OlapicMediaListDirectionNewer;
+    if(suspended){
+        // It starts again from the first page on resume
+        resumesPageRequest = YES;
+        return;
+    }
+    NSUInteger requestGeneration = generation;
+    OlapicMediaFieldSelection *selection = fieldSelection;
+    parameters = [OlapicMediaListController parameters:parameters withSelection:selection];
+    // The cursor: the media already loaded, and the date of the newest one
+    NSMutableSet *identifiers = [[NSMutableSet alloc] initWithCapacity:[media count] + [collected count]];
+    for(OlapicMediaEntity *entity in [collected arrayByAddingObjectsFromArray:media]){
+        NSString *identifier = [OlapicEntityInterner identifierForJSON:entity.data];
+        if(identifier) [identifiers addObject:identifier];
+    }
+    id newestDateValue = [[[media firstObject] data] valueForKey:OlapicMediaStoreDateKey];
+    NSDate *newestDate = [newestDateValue isKindOfClass:[NSString class]] ? [OlapicMediaListController dateFromString:newestDateValue] : nil;
+    // The task doesn't keep the controller alive, so dealloc can cancel it
+    __weak OlapicMediaListController *weakSelf = self;
+    pageTask = [[OlapicNetworkClient sharedClient] getObject:URL parameters:parameters priority:OlapicRequestPriorityHigh processing:^id(NSData *responseData, NSError **error){
+        // On the processing queue, a suspended or cancelled list
+        // cancels the task and the client skips this
+        return [OlapicMediaListController pageFromResponseData:responseData selection:selection newerThanIdentifiers:identifiers date:newestDate error:error];
+    } onSuccess:^(NSDictionary *page){
+        OlapicMediaListController *controller = weakSelf;
+        if(!controller || requestGeneration != controller->generation) return;
+        controller->pageTask = nil;
+        NSArray *newer = [collected arrayByAddingObjectsFromArray:[page valueForKey:@"media"]];
+        NSString *next = [controller URLForLink:@"next" inLinks:[page valueForKey:@"links"]];
+        if(![[page valueForKey:@"overlaps"] boolValue] && next && pagesLeft > 1){
+            // Everything on the page is new, there may be more
+            [controller loadNewerMediaFromURL:next parameters:nil collected:newer pagesLeft:pagesLeft - 1];
+            return;
+        }
+        [controller addNewerMedia:newer];
+    } onFailure:^(NSError *error){
+        OlapicMediaListController *controller = weakSelf;
+        if(!controller || requestGeneration != controller->generation) return;
+        controller->pageTask = nil;
+        [controller failWithError:error direction:OlapicMediaListDirectionNewer];
+        id<OlapicMediaListControllerDelegate> controllerDelegate = controller->delegate;
+        if([controllerDelegate respondsToSelector:@selector(OlapicMediaListController:didFailToLoadNewerMediaWithError:)]){
+            [controllerDelegate OlapicMediaListController:controller didFailToLoadNewerMediaWithError:error];
+        }
+    }];
+}
+/**
+ *  Put the newer media before the rest and inform the delegate
+ *
+ *  @param newer The media, the newest first
+ */
+-(void)addNewerMedia:(NSArray *)newer{
+    if([newer count]){
+        NSMutableDictionary *page = [[NSMutableDictionary alloc] init];
+        [page setValue:newer forKey:@"media"];
+        [list.pages insertObject:page atIndex:0];
+        [media pagesDidChange];
+        newerMediaCount += [newer count];
+        [[OlapicMediaStore sharedStore] addMedia:newer];
+        [[OlapicSearchIndex sharedIndex] addEntities:newer];
+    }
+    // Even with nothing new, so a refresh can always finish
+    [delegate OlapicMediaListController:self didLoadNewerMedia:newer];
+}
+/**
+ *  Check if the list is currenly downloading media
+ *
+ *  @return If the list is downloading
+ */
+-(BOOL)fetching{
+    return pageTask != nil;
+}
+/**
+ *  Request a page
+ *
+ *  @param URL        The page URL
+ *  @param parameters The parameters for the query string
+ *  @param direction  Where the page goes on the list
+ */
+-(void)loadPageFromURL:(NSString *)URL parameters:(NSDictionary *)parameters direction:(OlapicMediaListDirection)direction{
+    if(cancelled || !URL) return;
+    pageDirection = direction;
+    if(suspended){
+        // Keep it for later
+        resumesPageRequest = YES;
+        return;
+    }
+    NSUInteger requestGeneration = generation;
+    OlapicMediaFieldSelection *selection = fieldSelection;
+    parameters = [OlapicMediaListController parameters:parameters withSelection:selection];
+    NSString *pageCachePath = direction == OlapicMediaListDirectionInitial ? cachePath : nil;
+    list.currentURL = [NSMutableString stringWithString:URL];
+    // The task doesn't keep the controller alive, so dealloc can cancel it
+    __weak OlapicMediaListController *weakSelf = self;
+    pageTask = [[OlapicNetworkClient sharedClient] getObject:URL parameters:parameters priority:OlapicRequestPriorityHigh processing:^id(NSData *responseData, NSError **error){
+        // On the processing queue, a suspended or cancelled list
+        // cancels the task and the client skips this
+        NSDictionary *page = [OlapicMediaListController pageFromResponseData:responseData selection:selection error:error];
+        if(page && pageCachePath){
+            NSError *cacheError = nil;
+            if(![OlapicMediaCache writeMedia:[page valueForKey:@"media"] toFile:pageCachePath error:&cacheError]){
+                NSLog(@"MEDIA CACHE ERROR : %@",cacheError);
+            }
+        }
+        return page;
+    } onSuccess:^(NSDictionary *page){
+        // Back on the main thread
+        OlapicMediaListController *controller = weakSelf;
+        if(!controller || requestGeneration != controller->generation) return;
+        controller->pageTask = nil;
+        if(direction == OlapicMediaListDirectionInitial) [controller firstPageDidLoad:page error:nil];
+        // The callback can cancel the list
+        if(controller->cancelled) return;
+        [controller addPage:page direction:direction];
+    } onFailure:^(NSError *error){
+        OlapicMediaListController *controller = weakSelf;
+        if(!controller || requestGeneration != controller->generation) return;
+        controller->pageTask = nil;
+        if(direction == OlapicMediaListDirectionInitial) [controller firstPageDidLoad:nil error:error];
+        if(controller->cancelled) return;
+        [controller failWithError:error direction:direction];
+    }];
+}
+/**
+ *  Read a page response and create the media entities
+ *
+ *  @param responseData The response data
+ *  @param error        A reference to save the error, if the response is not valid
+ *
+ *  @return A dictionary with the 'links' and 'media' keys
+ */
++(NSDictionary *)pageFromResponseData:(NSData *)responseData error:(NSError **)error{
+    return [OlapicMediaListController pageFromResponseData:responseData selection:nil error:error];
+}
+/**
+ *  Read a page response and create the media entities with only the
+ *  selected fields. It can be called from any thread
+ *
+ *  @param responseData The response data
+ *  @param selection    The fields to keep (nil to keep all of them)
+ *  @param error        A reference to save the error, if the response is not valid
+ *
+ *  @return A dictionary with the 'links' and 'media' keys
+ */
++(NSDictionary *)pageFromResponseData:(NSData *)responseData selection:(OlapicMediaFieldSelection *)selection error:(NSError **)error{
+    return [OlapicMediaListController pageFromResponseData:responseData selection:selection newerThanIdentifiers:nil date:nil error:error];
+}
+/**
+ *  Read a page response and create the media entities that are newer
+ *  than the ones already loaded. The items are read in order until the
+ *  first one that is known (by ID) or older than a date. It can be
+ *  called from any thread
+ *
+ *  @param responseData The response data
+ *  @param selection    The fields to keep (nil to keep all of them)
+ *  @param identifiers  The IDs of the media already loaded
+ *  @param date         The date of the newest media already loaded (or nil)
+ *  @param error        A reference to save the error, if the response is not valid
+ *
+ *  @return A dictionary with the 'links' and 'media' keys, and 'overlaps'
+ *  (YES if it found a known media)
+ */
++(NSDictionary *)pageFromResponseData:(NSData *)responseData selection:(OlapicMediaFieldSelection *)selection newerThanIdentifiers:(NSSet *)identifiers date:(NSDate *)date error:(NSError **)error{
+    OlapicSDK *olapic = [OlapicSDK sharedOlapicSDK];
+    id JSON = [OlapicPayloadDecoder objectWithData:responseData error:error];
+    if(![JSON isKindOfClass:[NSDictionary class]] || ![[olapic rest] isValid:JSON]){
+        if(error && !*error){
+            *error = [NSError errorWithDomain:OlapicNetworkErrorDomain code:OlapicNetworkErrorInvalidResponse userInfo:@{NSLocalizedDescriptionKey: @"The API response is not valid"}];
+        }
+        return nil;
+    }
+    NSDictionary *data = [JSON valueForKey:@"data"];
+    id items = [data valueForKeyPath:@"_embedded.media"];
+    if([items isKindOfClass:[NSDictionary class]]){
+        items = [NSArray arrayWithObject:items];
+    }
+    BOOL overlaps = NO;
+    if(identifiers){
+        // Only the items before the first known one
+        NSUInteger newerCount = 0;
+        for(id item in items){
+            NSString *identifier = [item isKindOfClass:[NSDictionary class]] ? [OlapicEntityInterner identifierForJSON:item] : nil;
+            id itemDateValue = [item isKindOfClass:[NSDictionary class]] ? [item valueForKey:OlapicMediaStoreDateKey] : nil;
+            NSDate *itemDate = (date && [itemDateValue isKindOfClass:[NSString class]]) ? [OlapicMediaListController dateFromString:itemDateValue] : nil;
+            BOOL older = itemDate && [itemDate compare:date] == NSOrderedAscending;
+            if((identifier && [identifiers containsObject:identifier]) || older){
+                overlaps = YES;
+                break;
+            }
+            newerCount++;
+        }
+        items = [items subarrayWithRange:NSMakeRange(0, newerCount)];
+    }
+    if(selection){
+        items = [selection pruneItems:items];
+    }
+    NSArray *media = [OlapicMediaListController entitiesFromJSONItems:items];
+    NSMutableDictionary *page = [[NSMutableDictionary alloc] init];
+    [page setValue:media forKey:@"media"];
+    [page setValue:[data valueForKey:@"_links"] forKey:@"links"];
+    if(identifiers) [page setValue:[NSNumber numberWithBool:overlaps] forKey:@"overlaps"];
+    return page;
+}
+/**
+ *  Read a date of the API (ISO 8601, like '2014-06-11T16:43:42+00:00').
+ *  It can be called from any thread
+ *
+ *  @param value The date string
+ *
+ *  @return The date, or nil if it's not a valid date
+ */
++(NSDate *)dateFromString:(NSString *)value{
+    if(![value length]) return nil;
+    static NSDateFormatter *formatter = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        formatter = [[NSDateFormatter alloc] init];
+        formatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+        formatter.timeZone = [NSTimeZone timeZoneWithAbbreviation:@"GMT"];
+        formatter.dateFormat = @"yyyy-MM-dd'T'HH':'mm':'ssZZZZZ";
+    });
+    // NSDateFormatter is thread safe since iOS 7
+    return [formatter dateFromString:value];
+}
+/**
+ *  Create the media entities for a page, sharing the repeated content
+ *  between them. The JSON of big pages is interned on all the available
+ *  cores, and the entities are created after that. It can be called
+ *  from any thread
+ *
+ *  @param items The media JSON objects
+ *
+ *  @return An array of OlapicMediaEntity objects, in the same order
+ */
++(NSArray *)entitiesFromJSONItems:(NSArray *)items{
+    OlapicMediaHandler *handler = [[OlapicSDK sharedOlapicSDK] media];
+    OlapicIdentityMap *identityMap = [OlapicIdentityMap sharedMap];
+    NSUInteger count = [items count];
+    if(count < OlapicMediaListParallelParsingThreshold){
+        NSMutableArray *media = [[NSMutableArray alloc] initWithCapacity:count];
+        for(NSDictionary *item in items){
+            OlapicMediaEntity *entity = [identityMap entityFromJSON:item withHandler:handler];
+            if(entity) [media addObject:entity];
+        }
+        return media;
+    }
+    // Copying and interning the JSON is the heavy part and only touches
+    // Foundation objects, so it's split between the cores. Each iteration
+    // writes its own slot, so there's no need to lock
+    __strong id *values = (__strong id *)calloc(count, sizeof(id));
+    OlapicEntityInterner *interner = [OlapicEntityInterner sharedInterner];
+    dispatch_apply(count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i){
+        values[i] = [interner internJSON:[items objectAtIndex:i]];
+    });
+    // The entities are created (or found and updated) one at a time, so
+    // two items with the same ID end up as the same entity
+    NSMutableArray *media = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSUInteger i = 0; i < count; i++){
+        OlapicMediaEntity *entity = [values[i] isKindOfClass:[NSMutableDictionary class]] ? [identityMap entityFromInternedJSON:values[i] withHandler:handler] : nil;
+        if(entity) [media addObject:entity];
+        values[i] = nil;
+    }
+    free(values);
+    return media;
+}
+/**
+ *  Add a page to the list and inform the delegate
+ *
+ *  @param page      The page, with the 'links' and 'media' keys
+ *  @param direction Where the page goes on the list
+ */
+-(void)addPage:(NSDictionary *)page direction:(OlapicMediaListDirection)direction{
+    if(shuffle){
+        NSMutableDictionary *shuffledPage = [page mutableCopy];
+        [shuffledPage setValue:[shuffle shuffleMedia:[page valueForKey:@"media"]] forKey:@"media"];
+        page = [self pageWithoutLoadedMedia:shuffledPage];
+    }else if(direction == OlapicMediaListDirectionNext && newerMediaCount > 0){
+        // The newer media moved the offsets, so the next page repeats some
+        page = [self pageWithoutLoadedMedia:page];
+    }
+    NSArray *pageMedia = [page valueForKey:@"media"];
+    NSDictionary *links = [page valueForKey:@"links"];
+    currentPage = page;
+    NSInteger previousOffset = list.currentOffset;
+    NSString *next = [self URLForLink:@"next" inLinks:links];
+    NSString *prev = [self URLForLink:@"prev" inLinks:links];
+    switch(direction){
+        case OlapicMediaListDirectionPrevious:
+            [list.pages insertObject:page atIndex:0];
+            list.prevURL = prev ? [NSMutableString stringWithString:prev] : nil;
+            list.currentOffset = MAX(previousOffset - list.mediaPerPage, 0);
+            break;
+        case OlapicMediaListDirectionNext:
+            [list.pages addObject:page];
+            list.nextURL = next ? [NSMutableString stringWithString:next] : nil;
+            list.currentOffset = previousOffset + list.mediaPerPage;
+            break;
+        default:
+            [list.pages addObject:page];
+            list.nextURL = next ? [NSMutableString stringWithString:next] : nil;
+            list.prevURL = prev ? [NSMutableString stringWithString:prev] : nil;
+            break;
+    }
+    [media pagesDidChange];
+    // Keep it for the local re-sorts, filters and searches
+    [[OlapicMediaStore sharedStore] addMedia:pageMedia];
+    [[OlapicSearchIndex sharedIndex] addEntities:pageMedia];
+    id<OlapicMediaListDelegate> listDelegate = list.delegate;
+    if(!loadedFirstPage){
+        loadedFirstPage = YES;
+        if([listDelegate respondsToSelector:@selector(OlapicMediaList:didLoadMediaForTheFirstTime:withLinks:)]){
+            [listDelegate OlapicMediaList:list didLoadMediaForTheFirstTime:pageMedia withLinks:links];
+        }
+    }else if(direction == OlapicMediaListDirectionNext && [listDelegate respondsToSelector:@selector(OlapicMediaList:didLoadNewMedia:withLinks:)]){
+        [listDelegate OlapicMediaList:list didLoadNewMedia:pageMedia withLinks:links];
+    }
+    [listDelegate OlapicMediaList:list didLoadMedia:pageMedia withLinks:links];
+    if(previousOffset != list.currentOffset && [listDelegate respondsToSelector:@selector(OlapicMediaList:didChangeOffset:fromPreviousOffset:)]){
+        [listDelegate OlapicMediaList:list didChangeOffset:[NSNumber numberWithInteger:list.currentOffset] fromPreviousOffset:[NSNumber numberWithInteger:previousOffset]];
+    }
+}
+/**
+ *  Remove the media that is already on the list from a page
+ *
+ *  @param page The page, with the 'links' and 'media' keys
+ *
+ *  @return A page with only the media that is not loaded
+ */
+-(NSDictionary *)pageWithoutLoadedMedia:(NSDictionary *)page{
+    if(![media count]) return page;
+    NSMutableSet *loaded = [[NSMutableSet alloc] initWithCapacity:[media count]];
+    for(OlapicMediaEntity *entity in media){
+        NSString *identifier = [OlapicEntityInterner identifierForJSON:entity.data];
+        if(identifier) [loaded addObject:identifier];
+    }
+    NSMutableArray *unique = [[NSMutableArray alloc] init];
+    for(OlapicMediaEntity *entity in [page valueForKey:@"media"]){
+        NSString *identifier = [OlapicEntityInterner identifierForJSON:entity.data];
+        if(!identifier || ![loaded containsObject:identifier]) [unique addObject:entity];
+    }
+    NSMutableDictionary *uniquePage = [page mutableCopy];
+    [uniquePage setValue:unique forKey:@"media"];
+    return uniquePage;
+}
+/**
+ *  Inform the delegate about an error
+ *
+ *  @param error     The error
+ *  @param direction The direction of the failed request
+ */
+-(void)failWithError:(NSError *)error direction:(OlapicMediaListDirection)direction{
+    id<OlapicMediaListDelegate> listDelegate = list.delegate;
+    if(!loadedFirstPage && [listDelegate respondsToSelector:@selector(OlapicMediaList:didReceiveAnErrorForTheFirstTime:)]){
+        [listDelegate OlapicMediaList:list didReceiveAnErrorForTheFirstTime:error];
+    }
+    [listDelegate OlapicMediaList:list didReceiveAnError:error];
+}
+/**
+ *  Add the list field selection parameters to the parameters of a request
+ *
+ *  @param parameters The request parameters
+ *  @param selection  The field selection (or nil)
+ *
+ *  @return The parameters for the request
+ */
++(NSDictionary *)parameters:(NSDictionary *)parameters withSelection:(OlapicMediaFieldSelection *)selection{
+    if(![[selection parameters] count]) return parameters;
+    NSMutableDictionary *selectionParameters = [NSMutableDictionary dictionaryWithDictionary:parameters];
+    [selectionParameters addEntriesFromDictionary:[selection parameters]];
+    return selectionParameters;
+}
+/**
+ *  Get the URL of a pagination link
+ *
+ *  @param name  The link name ('next', 'prev')
+ *  @param links The API pagination links
+ *
+ *  @return The URL, or nil if the link doesn't exist
+ */
+-(NSString *)URLForLink:(NSString *)name inLinks:(NSDictionary *)links{
+    id link = [links valueForKey:name];
+    if([link isKindOfClass:[NSDictionary class]]){
+        link = [link valueForKey:@"href"];
+    }
+    return [link isKindOfClass:[NSString class]] && [link length] ? link : nil;
+}
+/**
+ *  Get all the media currently saved on the list. Unlike OlapicMediaList's
+ *  getMedia, it doesn't create a new array: it's always the same read
+ *  only view over the list pages
+ *
+ *  @return An array of OlapicMediaEntity objects
+ */
+-(NSArray *)getMedia{
+    return media;
+}
+/**
+ *  Get the media of the last page that was loaded, without copying it
+ *
+ *  @return An array of OlapicMediaEntity objects
+ */
+-(NSArray *)getCurrentPageMedia{
+    return [currentPage valueForKey:@"media"];
+}
+/**
+ *  Get the media saved on the cachePath by a previous session. The
+ *  file is memory mapped and the entities are read when they're used
+ *
+ *  @return An array of OlapicMediaEntity objects, or nil if there's no cache
+ */
+-(NSArray *)getCachedMedia{
+    if(!cachePath || ![[NSFileManager defaultManager] fileExistsAtPath:cachePath]) return nil;
+    OlapicMediaCache *cache = [[OlapicMediaCache alloc] initWithContentsOfFile:cachePath error:nil];
+    if(!cache){
+        // A broken file is ignored, and the next first page replaces it
+        [[NSFileManager defaultManager] removeItemAtPath:cachePath error:nil];
+        return nil;
+    }
+    // The page is saved in the stable order
+    return shuffle ? [shuffle shuffleMedia:[cache allMedia]] : [cache allMedia];
+}
+/**
+ *  Register a request that depends on the list (like a thumbnail),
+ *  so it gets cancelled with it
+ *
+ *  @param task The request task
+ */
+-(void)addDependentTask:(OlapicNetworkTask *)task{
+    if(!task) return;
+    if(cancelled){
+        [task cancel];
+        return;
+    }
+    [dependentTasks addObject:task];
+}
+/**
+ *  Cancel the page request and all the dependent requests. The
+ *  list won't load anything else and no more delegate methods will
+ *  be called
+ */
+-(void)cancel{
+    if(cancelled) return;
+    cancelled = YES;
+    generation++;
+    resumesPageRequest = NO;
+    [pageTask cancel];
+    pageTask = nil;
+    for(OlapicNetworkTask *task in [dependentTasks allObjects]){
+        [task cancel];
+    }
+    [dependentTasks removeAllObjects];
+    firstPageCallback = nil;
+    firstPageFailureCallback = nil;
+}
+/**
+ *  Stop the page request, to be sent again on resume. The responses
+ *  that arrive while the list is suspended are ignored
+ */
+-(void)suspend{
+    if(suspended || cancelled) return;
+    suspended = YES;
+    generation++;
+    if(pageTask){
+        [pageTask cancel];
+        pageTask = nil;
+        resumesPageRequest = YES;
+    }
+}
+/**
+ *  Resume a suspended list, sending again the page request that was
+ *  running when it was suspended
+ */
+-(void)resume{
+    if(!suspended || cancelled) return;
+    suspended = NO;
+    if(!resumesPageRequest) return;
+    resumesPageRequest = NO;
+    switch(pageDirection){
+        case OlapicMediaListDirectionNext:
+            [self loadNextPage];
+            break;
+        case OlapicMediaListDirectionPrevious:
+            [self loadPreviousPage];
+            break;
+        case OlapicMediaListDirectionNewer:
+            [self loadNewerMedia];
+            break;
+        default:
+            [self startFetching];
+            break;
+    }
+}
+/**
+ *  Cancel everything when the object goes away
+ */
+-(void)dealloc{
+    [self cancel];
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,182 @@
+//
+//  OlapicMediaListWindow.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+
+@class OlapicMediaListController;
+@protocol OlapicMediaListWindowDelegate;
+/**
+ *  A random access view of an OlapicMediaList. Instead of walking the
+ *  list page by page, it requests the page for any offset directly,
+ *  and keeps a sparse map of pages (page index => media). Only the
+ *  pages around the current offset stay in memory: when there are more
+ *  than maxResidentPages, the ones farther from the offset are evicted
+ *  and the requests for pages outside the window are cancelled.
+ *
+ *  Created from a list controller, the pages use its field selection
+ *  and their requests are cancelled with it. The current page is
+ *  requested with a high priority and its neighbours with the normal
+ *  one, so they also load on cellular.
+ *
+ *  All the methods should be called from the main thread.
+ */
+@interface OlapicMediaListWindow : NSObject{
+    /**
+     *  The delegate object
+     */
+    id <OlapicMediaListWindowDelegate>__weak delegate;
+    /**
+     *  The list to read the URL and the page size from
+     */
+    OlapicMediaList *list;
+    /**
+     *  The list controller the requests depend on, if there's one
+     */
+    OlapicMediaListController *__weak listController;
+    /**
+     *  The resident pages, by page index
+     */
+    NSMutableDictionary *pages;
+    /**
+     *  The running page requests, by page index
+     */
+    NSMutableDictionary *requests;
+    /**
+     *  The offset the user is looking at
+     */
+    NSInteger currentOffset;
+    /**
+     *  How many pages can stay in memory
+     */
+    NSUInteger maxResidentPages;
+    /**
+     *  How many pages are loaded before and after the current one
+     */
+    NSUInteger pagesAround;
+    /**
+     *  The index of the last page, once the API says there's no next page
+     */
+    NSInteger lastPageIndex;
+}
+
+@property (nonatomic,weak) id <OlapicMediaListWindowDelegate>__weak delegate;
+@property (nonatomic,strong,readonly) OlapicMediaList *list;
+@property (nonatomic,weak,readonly) OlapicMediaListController *__weak listController;
+@property (nonatomic,readonly) NSInteger currentOffset;
+@property (nonatomic) NSUInteger maxResidentPages;
+@property (nonatomic) NSUInteger pagesAround;
+/**
+ *  Class constructor
+ *
+ *  @param mediaList The list to read the URL and the page size from
+ *  @param maxPages  How many pages can stay in memory
+ *
+ *  @return An instance of this object (OlapicMediaListWindow)
+ */
+-(id)initWithList:(OlapicMediaList *)mediaList maxResidentPages:(NSUInteger)maxPages;
+/**
+ *  Class constructor for the list of a list controller. The pages use
+ *  its field selection, and the requests are cancelled with it
+ *
+ *  @param controller The list controller
+ *  @param maxPages   How many pages can stay in memory
+ *
+ *  @return An instance of this object (OlapicMediaListWindow)
+ */
+-(id)initWithListController:(OlapicMediaListController *)controller maxResidentPages:(NSUInteger)maxPages;
+/**
+ *  Move the window to an offset: load the page that contains it (and
+ *  the ones around it) and evict the pages that are too far
+ *
+ *  @param offset The media offset
+ */
+-(void)moveToOffset:(NSInteger)offset;
+/**
+ *  Get the media at a given offset, if its page is in memory
+ *
+ *  @param offset The media offset
+ *
+ *  @return The media entity, or nil if its page is not loaded
+ */
+-(OlapicMediaEntity *)mediaAtOffset:(NSInteger)offset;
+/**
+ *  Check if the page that contains an offset is in memory
+ *
+ *  @param offset The media offset
+ *
+ *  @return If the page is loaded
+ */
+-(BOOL)hasMediaAtOffset:(NSInteger)offset;
+/**
+ *  Get the number of pages in memory
+ *
+ *  @return The number of pages
+ */
+-(NSUInteger)residentPageCount;
+/**
+ *  Cancel all the requests and remove all the pages
+ */
+-(void)cancel;
+
+@end
+/**
+ *  The protocol that handles the window events
+ */
+@protocol OlapicMediaListWindowDelegate <NSObject>
+/**
+ *  A page was loaded
+ *
+ *  @param window The window object that generated the event
+ *  @param media  A list with the loaded media objects
+ *  @param offset The offset of the first media of the page
+ */
+-(void)OlapicMediaListWindow:(OlapicMediaListWindow *)window didLoadMedia:(NSArray *)media atOffset:(NSInteger)offset;
+/**
+ *  A page couldn't be loaded
+ *
+ *  @param window The window object that generated the event
+ *  @param error  The error containing the reason why the request failed
+ *  @param offset The offset of the first media of the page
+ */
+-(void)OlapicMediaListWindow:(OlapicMediaListWindow *)window didReceiveAnError:(NSError *)error atOffset:(NSInteger)offset;
+@optional
+/**
+ *  A page was removed from memory
+ *
+ *  @param window The window object that generated the event
+ *  @param offset The offset of the first media of the page
+ *  @param count  The number of media objects removed
+ */
+-(void)OlapicMediaListWindow:(OlapicMediaListWindow *)window didEvictMediaAtOffset:(NSInteger)offset count:(NSUInteger)count;
+
+@end
\ No newline at end of file
@@ -0,0 +1,242 @@
+//
+//  OlapicMediaListWindow.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicMediaListWindow.h"
+#import "OlapicMediaListController.h"
+#import "OlapicNetworkClient.h"
+
+@interface OlapicMediaListWindow()
+/**
+ *  Get the index of the page that contains an offset
+ *
+ *  @param offset The media offset
+ *
+ *  @return The page index
+ */
+-(NSInteger)pageIndexForOffset:(NSInteger)offset;
+/**
+ *  Request a page, unless it's already loaded or loading
+ *
+ *  @param pageIndex The page index
+ */
+-(void)loadPage:(NSInteger)pageIndex;
+/**
+ *  Cancel the requests outside the window and evict the
+ *  pages farther from the current offset
+ */
+-(void)trimToWindow;
+
+@end
+
+@implementation OlapicMediaListWindow
+@synthesize delegate,list,listController,currentOffset,maxResidentPages,pagesAround;
+/**
+ *  Class constructor
+ *
+ *  @param mediaList The list to read the URL and the page size from
+ *  @param maxPages  How many pages can stay in memory
+ *
+ *  @return An instance of this object (OlapicMediaListWindow)
+ */
+-(id)initWithList:(OlapicMediaList *)mediaList maxResidentPages:(NSUInteger)maxPages{
+    self = [super init];
+    if(self){
+        list = mediaList;
+        pages = [[NSMutableDictionary alloc] init];
+        requests = [[NSMutableDictionary alloc] init];
+        currentOffset = 0;
+        maxResidentPages = MAX(maxPages, 1);
+        pagesAround = 1;
+        lastPageIndex = NSIntegerMax;
+    }
+    return self;
+}
+/**
+ *  Class constructor for the list of a list controller. The pages use
+ *  its field selection, and the requests are cancelled with it
+ *
+ *  @param controller The list controller
+ *  @param maxPages   How many pages can stay in memory
+ *
+ *  @return An instance of this object (OlapicMediaListWindow)
+ */
+-(id)initWithListController:(OlapicMediaListController *)controller maxResidentPages:(NSUInteger)maxPages{
+    self = [self initWithList:controller.list maxResidentPages:maxPages];
+    if(self){
+        listController = controller;
+    }
+    return self;
+}
+/**
+ *  Get the index of the page that contains an offset
+ *
+ *  @param offset The media offset
+ *
+ *  @return The page index
+ */
+-(NSInteger)pageIndexForOffset:(NSInteger)offset{
+    return MAX(offset, 0) / MAX(list.mediaPerPage, 1);
+}
+/**
+ *  Move the window to an offset: load the page that contains it (and
+ *  the ones around it) and evict the pages that are too far
+ *
+ *  @param offset The media offset
+ */
+-(void)moveToOffset:(NSInteger)offset{
+    currentOffset = MAX(offset, 0);
+    NSInteger current = [self pageIndexForOffset:currentOffset];
+    // The current page first, then the neighbours from the closest
+    [self loadPage:current];
+    for(NSInteger distance = 1; distance <= (NSInteger)pagesAround; distance++){
+        [self loadPage:current + distance];
+        [self loadPage:current - distance];
+    }
+    [self trimToWindow];
+}
+/**
+ *  Request a page, unless it's already loaded or loading
+ *
+ *  @param pageIndex The page index
+ */
+-(void)loadPage:(NSInteger)pageIndex{
+    if(pageIndex < 0 || pageIndex > lastPageIndex) return;
+    NSNumber *key = [NSNumber numberWithInteger:pageIndex];
+    if([pages objectForKey:key] || [requests objectForKey:key]) return;
+    NSInteger offset = pageIndex * list.mediaPerPage;
+    NSMutableDictionary *parameters = [[NSMutableDictionary alloc] init];
+    [parameters setValue:[NSString stringWithFormat:@"%ld",(long)list.mediaPerPage] forKey:@"count"];
+    [parameters setValue:[NSString stringWithFormat:@"%ld",(long)offset] forKey:@"offset"];
+    // The neighbours are needed soon, not 'maybe': with the prefetch
+    // priority they would never be sent on cellular
+    OlapicRequestPriority priority = pageIndex == [self pageIndexForOffset:currentOffset] ? OlapicRequestPriorityHigh : OlapicRequestPriorityNormal;
+    OlapicMediaFieldSelection *selection = listController.fieldSelection;
+    __weak OlapicMediaListWindow *weakSelf = self;
+    OlapicNetworkTask *task = [[OlapicNetworkClient sharedClient] getObject:list.initialURL parameters:[OlapicMediaListController parameters:parameters withSelection:selection] priority:priority processing:^id(NSData *responseData, NSError **error){
+        return [OlapicMediaListController pageFromResponseData:responseData selection:selection error:error];
+    } onSuccess:^(NSDictionary *page){
+        OlapicMediaListWindow *window = weakSelf;
+        if(!window) return;
+        [window->requests removeObjectForKey:key];
+        NSArray *media = [page valueForKey:@"media"];
+        if([media count] < window.list.mediaPerPage || ![page valueForKeyPath:@"links.next"]){
+            window->lastPageIndex = pageIndex;
+        }
+        [window->pages setObject:media forKey:key];
+        [window trimToWindow];
+        if([window->pages objectForKey:key]){
+            [window.delegate OlapicMediaListWindow:window didLoadMedia:media atOffset:offset];
+        }
+    } onFailure:^(NSError *error){
+        OlapicMediaListWindow *window = weakSelf;
+        if(!window) return;
+        [window->requests removeObjectForKey:key];
+        [window.delegate OlapicMediaListWindow:window didReceiveAnError:error atOffset:offset];
+    }];
+    if(task){
+        [requests setObject:task forKey:key];
+        [listController addDependentTask:task];
+    }
+}
+/**
+ *  Cancel the requests outside the window and evict the
+ *  pages farther from the current offset
+ */
+-(void)trimToWindow{
+    NSInteger current = [self pageIndexForOffset:currentOffset];
+    for(NSNumber *key in [requests allKeys]){
+        if(labs([key integerValue] - current) > (NSInteger)pagesAround){
+            [[requests objectForKey:key] cancel];
+            [requests removeObjectForKey:key];
+        }
+    }
+    if([pages count] <= maxResidentPages) return;
+    NSArray *keys = [[pages allKeys] sortedArrayUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b){
+        NSInteger distanceA = labs([a integerValue] - current);
+        NSInteger distanceB = labs([b integerValue] - current);
+        if(distanceA == distanceB) return NSOrderedSame;
+        return distanceA > distanceB ? NSOrderedAscending : NSOrderedDescending;
+    }];
+    // The farthest pages go first
+    NSUInteger toEvict = [pages count] - maxResidentPages;
+    for(NSUInteger i = 0; i < toEvict; i++){
+        NSNumber *key = [keys objectAtIndex:i];
+        NSUInteger count = [[pages objectForKey:key] count];
+        [pages removeObjectForKey:key];
+        if([delegate respondsToSelector:@selector(OlapicMediaListWindow:didEvictMediaAtOffset:count:)]){
+            [delegate OlapicMediaListWindow:self didEvictMediaAtOffset:[key integerValue] * list.mediaPerPage count:count];
+        }
+    }
+}
+/**
+ *  Get the media at a given offset, if its page is in memory
+ *
+ *  @param offset The media offset
+ *
+ *  @return The media entity, or nil if its page is not loaded
+ */
+-(OlapicMediaEntity *)mediaAtOffset:(NSInteger)offset{
+    if(offset < 0) return nil;
+    NSArray *media = [pages objectForKey:[NSNumber numberWithInteger:[self pageIndexForOffset:offset]]];
+    NSUInteger index = offset % MAX(list.mediaPerPage, 1);
+    return index < [media count] ? [media objectAtIndex:index] : nil;
+}
+/**
+ *  Check if the page that contains an offset is in memory
+ *
+ *  @param offset The media offset
+ *
+ *  @return If the page is loaded
+ */
+-(BOOL)hasMediaAtOffset:(NSInteger)offset{
+    return [self mediaAtOffset:offset] != nil;
+}
+/**
+ *  Get the number of pages in memory
+ *
+ *  @return The number of pages
+ */
+-(NSUInteger)residentPageCount{
+    return [pages count];
+}
+/**
+ *  Cancel all the requests and remove all the pages
+ */
+-(void)cancel{
+    for(OlapicNetworkTask *task in [requests allValues]){
+        [task cancel];
+    }
+    [requests removeAllObjects];
+    [pages removeAllObjects];
+}
+
+@end
\ No newline at end of file
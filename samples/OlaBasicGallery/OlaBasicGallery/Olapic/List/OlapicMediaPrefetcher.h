@@ -0,0 +1,113 @@
+//
+//  OlapicMediaPrefetcher.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+#import "OlapicMediaListController.h"
+/**
+ *  Prefetches the media around the one shown in the detail screen, so
+ *  swiping to the next or previous one doesn't start cold. For each
+ *  media within the radius (in the order of the list) it downloads the
+ *  display size image and the uploader, with the prefetch priority, so
+ *  they never compete with what's on the screen.
+ *
+ *  When the radius reaches the end of the loaded media, it asks the
+ *  list controller for the next page.
+ */
+@interface OlapicMediaPrefetcher : NSObject{
+    /**
+     *  The object that loads the list the media comes from
+     */
+    OlapicMediaListController *__weak listController;
+    /**
+     *  How many media to prefetch on each side of the current one
+     */
+    NSUInteger radius;
+    /**
+     *  The downloaded images, by URL
+     */
+    NSCache *imageData;
+    /**
+     *  The running image requests, by URL
+     */
+    NSMutableDictionary *tasks;
+}
+
+@property (nonatomic,weak,readonly) OlapicMediaListController *__weak listController;
+@property (nonatomic) NSUInteger radius;
+/**
+ *  Class constructor. The default radius is 1 (the next and the previous media)
+ *
+ *  @param controller The object that loads the list
+ *
+ *  @return An instance of this object (OlapicMediaPrefetcher)
+ */
+-(id)initWithListController:(OlapicMediaListController *)controller;
+/**
+ *  Prefetch the media within the radius of a media, and cancel the
+ *  requests for the media that are no longer in it
+ *
+ *  @param media The media currently on the screen
+ */
+-(void)prefetchAroundMedia:(OlapicMediaEntity *)media;
+/**
+ *  Get the media next to another one in the list
+ *
+ *  @param media  The media
+ *  @param offset The distance (negative for the previous ones)
+ *
+ *  @return The media or nil if it's outside the loaded list
+ */
+-(OlapicMediaEntity *)mediaNextTo:(OlapicMediaEntity *)media offset:(NSInteger)offset;
+/**
+ *  Get the display size image of a media, if it was already prefetched
+ *
+ *  @param media The media
+ *
+ *  @return The compressed image or nil
+ */
+-(NSData *)imageDataForMedia:(OlapicMediaEntity *)media;
+/**
+ *  Get the URL of the image that fills the screen for a media, the
+ *  same one the detail screen shows
+ *
+ *  @param media The media
+ *
+ *  @return The URL
+ */
++(NSString *)displayImageURLForMedia:(OlapicMediaEntity *)media;
+/**
+ *  Cancel all the running requests
+ */
+-(void)cancel;
+
+@end
\ No newline at end of file
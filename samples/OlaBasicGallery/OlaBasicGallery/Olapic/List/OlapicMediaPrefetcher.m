@@ -0,0 +1,180 @@
+//
+//  OlapicMediaPrefetcher.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicMediaPrefetcher.h"
+#import "OlapicNetworkClient.h"
+#import "OlapicImageSizeSelector.h"
+#import "OlapicIdentityMap.h"
+
+@interface OlapicMediaPrefetcher()
+/**
+ *  Start downloading the display size image of a media, unless it's
+ *  already downloaded or running
+ *
+ *  @param media The media
+ */
+-(void)prefetchImageForMedia:(OlapicMediaEntity *)media;
+
+@end
+
+@implementation OlapicMediaPrefetcher
+@synthesize listController,radius;
+/**
+ *  Class constructor. The default radius is 1 (the next and the previous media)
+ *
+ *  @param controller The object that loads the list
+ *
+ *  @return An instance of this object (OlapicMediaPrefetcher)
+ */
+-(id)initWithListController:(OlapicMediaListController *)controller{
+    self = [super init];
+    if(self){
+        listController = controller;
+        radius = 1;
+        imageData = [[NSCache alloc] init];
+        imageData.totalCostLimit = 16 * 1024 * 1024;
+        tasks = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+/**
+ *  Prefetch the media within the radius of a media, and cancel the
+ *  requests for the media that are no longer in it
+ *
+ *  @param media The media currently on the screen
+ */
+-(void)prefetchAroundMedia:(OlapicMediaEntity *)media{
+    NSArray *list = [listController getMedia];
+    NSUInteger index = [list indexOfObjectIdenticalTo:media];
+    if(index == NSNotFound) return;
+    NSMutableSet *wanted = [[NSMutableSet alloc] init];
+    NSMutableArray *neighbours = [[NSMutableArray alloc] init];
+    // The closest ones first, so they're the first to start
+    for(NSInteger distance = 1; distance <= (NSInteger)radius; distance++){
+        for(NSNumber *offset in @[@(distance), @(-distance)]){
+            OlapicMediaEntity *neighbour = [self mediaNextTo:media offset:[offset integerValue]];
+            if(!neighbour) continue;
+            [neighbours addObject:neighbour];
+            // A media without images has nothing to download
+            NSString *URL = [OlapicMediaPrefetcher displayImageURLForMedia:neighbour];
+            if(URL) [wanted addObject:URL];
+        }
+    }
+    for(NSString *URL in [tasks allKeys]){
+        if(![wanted containsObject:URL]){
+            [[tasks objectForKey:URL] cancel];
+            [tasks removeObjectForKey:URL];
+        }
+    }
+    for(OlapicMediaEntity *neighbour in neighbours){
+        [self prefetchImageForMedia:neighbour];
+        // The identity map shares it with the detail screen, and joins
+        // the request if it's already running
+        if(!neighbour.uploader){
+            [[OlapicIdentityMap sharedMap] getUploaderForMedia:neighbour onSuccess:nil onFailure:nil];
+        }
+    }
+    if(index + radius >= [list count] && [listController canLoadNextPage]){
+        [listController loadNextPage];
+    }
+}
+/**
+ *  Get the media next to another one in the list
+ *
+ *  @param media  The media
+ *  @param offset The distance (negative for the previous ones)
+ *
+ *  @return The media or nil if it's outside the loaded list
+ */
+-(OlapicMediaEntity *)mediaNextTo:(OlapicMediaEntity *)media offset:(NSInteger)offset{
+    NSArray *list = [listController getMedia];
+    NSUInteger index = [list indexOfObjectIdenticalTo:media];
+    if(index == NSNotFound) return nil;
+    NSInteger target = (NSInteger)index + offset;
+    if(target < 0 || target >= (NSInteger)[list count]) return nil;
+    return [list objectAtIndex:target];
+}
+/**
+ *  Start downloading the display size image of a media, unless it's
+ *  already downloaded or running
+ *
+ *  @param media The media
+ */
+-(void)prefetchImageForMedia:(OlapicMediaEntity *)media{
+    NSString *URL = [OlapicMediaPrefetcher displayImageURLForMedia:media];
+    if(!URL || [imageData objectForKey:URL] || [tasks objectForKey:URL]) return;
+    OlapicNetworkTask *task = [[OlapicNetworkClient sharedClient] getData:URL parameters:nil priority:OlapicRequestPriorityPrefetch onSuccess:^(NSData *mediaData){
+        [tasks removeObjectForKey:URL];
+        [imageData setObject:mediaData forKey:URL cost:[mediaData length]];
+    } onFailure:^(NSError *error){
+        [tasks removeObjectForKey:URL];
+    }];
+    if(task) [tasks setObject:task forKey:URL];
+}
+/**
+ *  Get the display size image of a media, if it was already prefetched
+ *
+ *  @param media The media
+ *
+ *  @return The compressed image or nil
+ */
+-(NSData *)imageDataForMedia:(OlapicMediaEntity *)media{
+    NSString *URL = [OlapicMediaPrefetcher displayImageURLForMedia:media];
+    return URL ? [imageData objectForKey:URL] : nil;
+}
+/**
+ *  Get the URL of the image that fills the screen for a media, the
+ *  same one the detail screen shows
+ *
+ *  @param media The media
+ *
+ *  @return The URL
+ */
++(NSString *)displayImageURLForMedia:(OlapicMediaEntity *)media{
+    OlapicMediaImageSize size = [OlapicImageSizeSelector imageSizeForMedia:media fittingSize:[UIScreen mainScreen].bounds.size allowingCrop:NO];
+    return [media getMediaURLForImageSize:size];
+}
+/**
+ *  Cancel all the running requests
+ */
+-(void)cancel{
+    [[tasks allValues] makeObjectsPerformSelector:@selector(cancel)];
+    [tasks removeAllObjects];
+}
+/**
+ *  Cancel the requests when the object goes away
+ */
+-(void)dealloc{
+    [self cancel];
+}
+
+@end
\ No newline at end of file
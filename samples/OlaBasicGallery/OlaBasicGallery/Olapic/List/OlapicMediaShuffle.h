@@ -0,0 +1,87 @@
+//
+//  OlapicMediaShuffle.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+/**
+ *  A shuffled order that is the same every time for the same seed.
+ *
+ *  The list still requests the server's 'media/shuffled' resource, which
+ *  picks the media of each page, but the server returns them in a new
+ *  order on every request. This object puts each page in a stable order
+ *  on the device: every media gets a rank from its ID and the seed, and
+ *  the page is sorted by that rank, so the same media with the same seed
+ *  always gives the same order (a cached first page shows up as it did,
+ *  and a page requested again doesn't move on the screen).
+ *
+ *  The seed is usually the sessionSeed, so the order changes between
+ *  sessions but not while the app is running.
+ */
+@interface OlapicMediaShuffle : NSObject{
+    /**
+     *  The seed of the order
+     */
+    uint32_t seed;
+}
+
+@property (nonatomic,readonly) uint32_t seed;
+/**
+ *  Class constructor
+ *
+ *  @param shuffleSeed The seed of the order
+ *
+ *  @return An instance of this object (OlapicMediaShuffle)
+ */
+-(id)initWithSeed:(uint32_t)shuffleSeed;
+/**
+ *  Get a random seed, created once per session
+ *
+ *  @return The seed
+ */
++(uint32_t)sessionSeed;
+/**
+ *  Get the rank of a media ID in this order
+ *
+ *  @param identifier The media ID
+ *
+ *  @return The rank (the lowest one goes first)
+ */
+-(uint64_t)rankForIdentifier:(NSString *)identifier;
+/**
+ *  Put a page of media in the shuffled order
+ *
+ *  @param media An array of OlapicMediaEntity objects
+ *
+ *  @return A new array with the same media
+ */
+-(NSArray *)shuffleMedia:(NSArray *)media;
+
+@end
\ No newline at end of file
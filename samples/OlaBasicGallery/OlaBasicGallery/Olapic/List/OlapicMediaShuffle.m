@@ -0,0 +1,118 @@
+//
+//  OlapicMediaShuffle.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicMediaShuffle.h"
+#import <OlapicSDK/OlapicSDK.h>
+#import "OlapicEntityInterner.h"
+
+@implementation OlapicMediaShuffle
+@synthesize seed;
+/**
+ *  Class constructor
+ *
+ *  @param shuffleSeed The seed of the order
+ *
+ *  @return An instance of this object (OlapicMediaShuffle)
+ */
+-(id)initWithSeed:(uint32_t)shuffleSeed{
+    self = [super init];
+    if(self){
+        seed = shuffleSeed;
+    }
+    return self;
+}
+/**
+ *  Get a random seed, created once per session
+ *
+ *  @return The seed
+ */
++(uint32_t)sessionSeed{
+    static uint32_t sessionSeed;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sessionSeed = arc4random();
+    });
+    return sessionSeed;
+}
+/**
+ *  Get the rank of a media ID in this order
+ *
+ *  @param identifier The media ID
+ *
+ *  @return The rank (the lowest one goes first)
+ */
+-(uint64_t)rankForIdentifier:(NSString *)identifier{
+    // FNV-1a of the ID (NSString's hash is not stable between OS versions)
+    uint64_t hash = 14695981039346656037ULL ^ seed;
+    const char *bytes = [identifier UTF8String];
+    for(; bytes && *bytes; bytes++){
+        hash ^= (uint8_t)*bytes;
+        hash *= 1099511628211ULL;
+    }
+    // And a final mix, so similar IDs don't get similar ranks
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+/**
+ *  Put a page of media in the shuffled order
+ *
+ *  @param media An array of OlapicMediaEntity objects
+ *
+ *  @return A new array with the same media
+ */
+-(NSArray *)shuffleMedia:(NSArray *)media{
+    NSUInteger count = [media count];
+    if(count < 2) return [NSArray arrayWithArray:media];
+    NSMutableArray *ranked = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSUInteger i = 0; i < count; i++){
+        OlapicMediaEntity *entity = [media objectAtIndex:i];
+        NSString *identifier = [OlapicEntityInterner identifierForJSON:entity.data];
+        // The media without an ID keeps its position in the stable order
+        uint64_t rank = identifier ? [self rankForIdentifier:identifier] : (uint64_t)i;
+        [ranked addObject:@[[NSNumber numberWithUnsignedLongLong:rank], identifier ?: @"", entity]];
+    }
+    [ranked sortUsingComparator:^NSComparisonResult(NSArray *a, NSArray *b){
+        NSComparisonResult result = [[a objectAtIndex:0] compare:[b objectAtIndex:0]];
+        return result != NSOrderedSame ? result : [[a objectAtIndex:1] compare:[b objectAtIndex:1]];
+    }];
+    NSMutableArray *shuffled = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSArray *item in ranked){
+        [shuffled addObject:[item lastObject]];
+    }
+    return shuffled;
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,180 @@
+//
+//  OlapicMediaStore.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+/**
+ *  The sorted indexes of the OlapicMediaStore
+ */
+typedef NS_ENUM(NSInteger, OlapicMediaStoreIndex){
+    /**
+     *  By submission date, the newer first
+     */
+    OlapicMediaStoreIndexDate = 0,
+    /**
+     *  By photorank, the higher first
+     */
+    OlapicMediaStoreIndexPhotorank = 1,
+    /**
+     *  By rating, the higher first
+     */
+    OlapicMediaStoreIndexRating = 2
+};
+/**
+ *  The media fields used by the indexes
+ */
+extern NSString *const OlapicMediaStoreDateKey;
+extern NSString *const OlapicMediaStorePhotorankKey;
+extern NSString *const OlapicMediaStoreRatingKey;
+extern NSString *const OlapicMediaStoreSourceKey;
+extern NSString *const OlapicMediaStoreLocationKey;
+/**
+ *  Keeps all the media loaded during the session, indexed, so the app
+ *  can re-sort and filter what it already downloaded without waiting
+ *  for the API:
+ *
+ *  - A sorted index (of IDs) by date, photorank and rating. Adding a
+ *    media is a binary search and an insert on each one
+ *  - A set of IDs for each source, and one for the media with a location
+ *
+ *  Every page the OlapicMediaListController loads is added, and a media
+ *  that comes again (with new values) is moved in the indexes. The dates
+ *  are parsed (like the list controller does), so the ones with another
+ *  time zone offset are still in order.
+ *
+ *  It keeps up to maxMediaCount media: when there are more, the ones
+ *  that were added (or updated) the longest ago are removed. A memory
+ *  warning removes all of them.
+ *
+ *  All the methods should be called from the main thread.
+ */
+@interface OlapicMediaStore : NSObject{
+    /**
+     *  The media, by ID
+     */
+    NSMutableDictionary *media;
+    /**
+     *  The values used by the indexes for each media (the date, photorank,
+     *  rating, source and location flag; NSNull if it doesn't have one), by ID
+     */
+    NSMutableDictionary *indexValues;
+    /**
+     *  The IDs sorted by each index, one array per OlapicMediaStoreIndex
+     */
+    NSArray *sortedIndexes;
+    /**
+     *  The IDs of the media from each source, by source
+     */
+    NSMutableDictionary *sources;
+    /**
+     *  The IDs of the media with a location
+     */
+    NSMutableSet *located;
+    /**
+     *  The IDs, from the least to the most recently added
+     */
+    NSMutableOrderedSet *recent;
+    /**
+     *  How many media the store keeps
+     */
+    NSUInteger maxMediaCount;
+}
+
+@property (nonatomic) NSUInteger maxMediaCount;
+/**
+ *  Get the shared instance
+ *
+ *  @return The shared instance
+ */
++(OlapicMediaStore *)sharedStore;
+/**
+ *  Add media to the store, or update the indexes of the ones it
+ *  already has
+ *
+ *  @param mediaList An array of OlapicMediaEntity objects
+ */
+-(void)addMedia:(NSArray *)mediaList;
+/**
+ *  Remove all the media
+ */
+-(void)removeAllMedia;
+/**
+ *  Get the number of media in the store
+ *
+ *  @return The number of media
+ */
+-(NSUInteger)count;
+/**
+ *  Get a media by its ID
+ *
+ *  @param identifier The media ID
+ *
+ *  @return The media or nil
+ */
+-(OlapicMediaEntity *)mediaWithIdentifier:(NSString *)identifier;
+/**
+ *  Get the sources of the media in the store
+ *
+ *  @return An array of strings, sorted alphabetically
+ */
+-(NSArray *)sources;
+/**
+ *  Get the media sorted by an index, and filtered
+ *
+ *  @param index    The index to sort by
+ *  @param source   Only the media from this source (nil for all of them)
+ *  @param location If YES, only the media with a location
+ *
+ *  @return An array of OlapicMediaEntity objects
+ */
+-(NSArray *)mediaSortedBy:(OlapicMediaStoreIndex)index source:(NSString *)source requiringLocation:(BOOL)location;
+/**
+ *  Get the media in the same order a list with a sorting type would
+ *  have it
+ *
+ *  @param sorting The list sorting type
+ *
+ *  @return An array of OlapicMediaEntity objects, or nil if the sorting
+ *  can't be done locally (OlapicMediaListSortingTypeShuffled)
+ */
+-(NSArray *)mediaSortedLike:(OlapicMediaListSortingType)sorting;
+/**
+ *  Get the media store index that matches a list sorting type
+ *
+ *  @param sorting The list sorting type
+ *  @param index   A reference to save the index
+ *
+ *  @return NO if there's no index for the sorting type
+ */
++(BOOL)index:(OlapicMediaStoreIndex *)index forSortingType:(OlapicMediaListSortingType)sorting;
+
+@end
\ No newline at end of file
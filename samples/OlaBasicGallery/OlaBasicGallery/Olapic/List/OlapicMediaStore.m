@@ -0,0 +1,399 @@
+//
+//  OlapicMediaStore.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+#import "OlapicMediaStore.h"
+#import "OlapicEntityInterner.h"
+#import "OlapicMediaListController.h"
+
+NSString *const OlapicMediaStoreDateKey = @"date_submitted";
+NSString *const OlapicMediaStorePhotorankKey = @"photorank";
+NSString *const OlapicMediaStoreRatingKey = @"rating";
+NSString *const OlapicMediaStoreSourceKey = @"source";
+NSString *const OlapicMediaStoreLocationKey = @"location";
+
+@interface OlapicMediaStore()
+/**
+ *  Get the values used by the indexes for a media: the date, photorank
+ *  and rating (in the OlapicMediaStoreIndex order), the source and
+ *  the location flag
+ *
+ *  @param data The media data
+ *
+ *  @return An array of dates, strings, numbers or NSNull
+ */
++(NSArray *)indexValuesForData:(NSDictionary *)data;
+/**
+ *  Compare two sort values, the higher (or newer) first and the
+ *  missing ones at the end
+ *
+ *  @param value The first value
+ *  @param other The second value
+ *
+ *  @return The order of the values
+ */
++(NSComparisonResult)compareValue:(id)value toValue:(id)other;
+/**
+ *  Get the comparator of the IDs of an index, using the current index
+ *  values. The ties are sorted by ID, so the order is stable
+ *
+ *  @param index The index
+ *
+ *  @return The comparator
+ */
+-(NSComparator)comparatorForIndex:(OlapicMediaStoreIndex)index;
+/**
+ *  Remove a media ID from all the indexes, using its current values
+ *
+ *  @param identifier The media ID
+ */
+-(void)unindexMedia:(NSString *)identifier;
+/**
+ *  Add a media ID to all the indexes
+ *
+ *  @param identifier The media ID
+ *  @param values     The values used by the indexes
+ */
+-(void)indexMedia:(NSString *)identifier withValues:(NSArray *)values;
+/**
+ *  Remove the least recently added media until there are no more
+ *  than maxMediaCount
+ */
+-(void)trimToMaxCount;
+/**
+ *  Free the memory after a memory warning
+ *
+ *  @param notification The notification
+ */
+-(void)didReceiveMemoryWarning:(NSNotification *)notification;
+
+@end
+
+@implementation OlapicMediaStore
+@synthesize maxMediaCount;
+/**
+ *  Get the shared instance
+ *
+ *  @return The shared instance
+ */
++(OlapicMediaStore *)sharedStore{
+    static OlapicMediaStore *sharedStore = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedStore = [[OlapicMediaStore alloc] init];
+    });
+    return sharedStore;
+}
+/**
+ *  Class constructor
+ *
+ *  @return An instance of this object (OlapicMediaStore)
+ */
+-(id)init{
+    self = [super init];
+    if(self){
+        media = [[NSMutableDictionary alloc] init];
+        indexValues = [[NSMutableDictionary alloc] init];
+        sortedIndexes = @[[[NSMutableArray alloc] init], [[NSMutableArray alloc] init], [[NSMutableArray alloc] init]];
+        sources = [[NSMutableDictionary alloc] init];
+        located = [[NSMutableSet alloc] init];
+        recent = [[NSMutableOrderedSet alloc] init];
+        maxMediaCount = 2000;
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    }
+    return self;
+}
+/**
+ *  Change how many media the store keeps, removing media if needed
+ *
+ *  @param count The number of media
+ */
+-(void)setMaxMediaCount:(NSUInteger)count{
+    maxMediaCount = count;
+    [self trimToMaxCount];
+}
+/**
+ *  Add media to the store, or update the indexes of the ones it
+ *  already has
+ *
+ *  @param mediaList An array of OlapicMediaEntity objects
+ */
+-(void)addMedia:(NSArray *)mediaList{
+    for(OlapicMediaEntity *entity in mediaList){
+        NSDictionary *data = entity.data;
+        NSString *identifier = [OlapicEntityInterner identifierForJSON:data];
+        if(!identifier) continue;
+        NSArray *values = [OlapicMediaStore indexValuesForData:data];
+        NSArray *previous = [indexValues objectForKey:identifier];
+        [media setObject:entity forKey:identifier];
+        [recent removeObject:identifier];
+        [recent addObject:identifier];
+        // Only move it if something the indexes use changed
+        if([previous isEqualToArray:values]) continue;
+        if(previous) [self unindexMedia:identifier];
+        [self indexMedia:identifier withValues:values];
+    }
+    [self trimToMaxCount];
+}
+/**
+ *  Remove the least recently added media until there are no more
+ *  than maxMediaCount
+ */
+-(void)trimToMaxCount{
+    while([recent count] > maxMediaCount){
+        NSString *identifier = [recent firstObject];
+        [recent removeObjectAtIndex:0];
+        [self unindexMedia:identifier];
+        [media removeObjectForKey:identifier];
+    }
+}
+/**
+ *  Free the memory after a memory warning
+ *
+ *  @param notification The notification
+ */
+-(void)didReceiveMemoryWarning:(NSNotification *)notification{
+    [self removeAllMedia];
+}
+/**
+ *  Remove all the media
+ */
+-(void)removeAllMedia{
+    [media removeAllObjects];
+    [indexValues removeAllObjects];
+    [sortedIndexes makeObjectsPerformSelector:@selector(removeAllObjects)];
+    [sources removeAllObjects];
+    [located removeAllObjects];
+    [recent removeAllObjects];
+}
+/**
+ *  Get the number of media in the store
+ *
+ *  @return The number of media
+ */
+-(NSUInteger)count{
+    return [media count];
+}
+/**
+ *  Get a media by its ID
+ *
+ *  @param identifier The media ID
+ *
+ *  @return The media or nil
+ */
+-(OlapicMediaEntity *)mediaWithIdentifier:(NSString *)identifier{
+    return identifier ? [media objectForKey:identifier] : nil;
+}
+/**
+ *  Get the sources of the media in the store
+ *
+ *  @return An array of strings, sorted alphabetically
+ */
+-(NSArray *)sources{
+    return [[sources allKeys] sortedArrayUsingSelector:@selector(compare:)];
+}
+/**
+ *  Get the media sorted by an index, and filtered
+ *
+ *  @param index    The index to sort by
+ *  @param source   Only the media from this source (nil for all of them)
+ *  @param location If YES, only the media with a location
+ *
+ *  @return An array of OlapicMediaEntity objects
+ */
+-(NSArray *)mediaSortedBy:(OlapicMediaStoreIndex)index source:(NSString *)source requiringLocation:(BOOL)location{
+    NSSet *sourceIDs = source ? ([sources objectForKey:source] ?: [NSSet set]) : nil;
+    NSArray *identifiers = [sortedIndexes objectAtIndex:index];
+    NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:[identifiers count]];
+    for(NSString *identifier in identifiers){
+        if(sourceIDs && ![sourceIDs containsObject:identifier]) continue;
+        if(location && ![located containsObject:identifier]) continue;
+        [result addObject:[media objectForKey:identifier]];
+    }
+    return result;
+}
+/**
+ *  Get the media in the same order a list with a sorting type would
+ *  have it
+ *
+ *  @param sorting The list sorting type
+ *
+ *  @return An array of OlapicMediaEntity objects, or nil if the sorting
+ *  can't be done locally (OlapicMediaListSortingTypeShuffled)
+ */
+-(NSArray *)mediaSortedLike:(OlapicMediaListSortingType)sorting{
+    OlapicMediaStoreIndex index;
+    if(![OlapicMediaStore index:&index forSortingType:sorting]) return nil;
+    return [self mediaSortedBy:index source:nil requiringLocation:NO];
+}
+/**
+ *  Get the media store index that matches a list sorting type
+ *
+ *  @param sorting The list sorting type
+ *  @param index   A reference to save the index
+ *
+ *  @return NO if there's no index for the sorting type
+ */
++(BOOL)index:(OlapicMediaStoreIndex *)index forSortingType:(OlapicMediaListSortingType)sorting{
+    OlapicMediaStoreIndex found;
+    switch(sorting){
+        case OlapicMediaListSortingTypeRecent:
+            found = OlapicMediaStoreIndexDate;
+            break;
+        case OlapicMediaListSortingTypePhotorank:
+            found = OlapicMediaStoreIndexPhotorank;
+            break;
+        case OlapicMediaListSortingTypeRated:
+            found = OlapicMediaStoreIndexRating;
+            break;
+        default:
+            return NO;
+    }
+    if(index) *index = found;
+    return YES;
+}
+/**
+ *  Remove a media ID from all the indexes, using its current values
+ *
+ *  @param identifier The media ID
+ */
+-(void)unindexMedia:(NSString *)identifier{
+    NSArray *values = [indexValues objectForKey:identifier];
+    if(!values) return;
+    for(OlapicMediaStoreIndex index = OlapicMediaStoreIndexDate; index <= OlapicMediaStoreIndexRating; index++){
+        NSMutableArray *identifiers = [sortedIndexes objectAtIndex:index];
+        NSUInteger position = [identifiers indexOfObject:identifier inSortedRange:NSMakeRange(0, [identifiers count]) options:NSBinarySearchingFirstEqual usingComparator:[self comparatorForIndex:index]];
+        if(position != NSNotFound) [identifiers removeObjectAtIndex:position];
+    }
+    id source = [values objectAtIndex:3];
+    if(source != [NSNull null]){
+        NSMutableSet *sourceIDs = [sources objectForKey:source];
+        [sourceIDs removeObject:identifier];
+        if(![sourceIDs count]) [sources removeObjectForKey:source];
+    }
+    [located removeObject:identifier];
+    [indexValues removeObjectForKey:identifier];
+}
+/**
+ *  Add a media ID to all the indexes
+ *
+ *  @param identifier The media ID
+ *  @param values     The values used by the indexes
+ */
+-(void)indexMedia:(NSString *)identifier withValues:(NSArray *)values{
+    [indexValues setObject:values forKey:identifier];
+    for(OlapicMediaStoreIndex index = OlapicMediaStoreIndexDate; index <= OlapicMediaStoreIndexRating; index++){
+        NSMutableArray *identifiers = [sortedIndexes objectAtIndex:index];
+        NSUInteger position = [identifiers indexOfObject:identifier inSortedRange:NSMakeRange(0, [identifiers count]) options:NSBinarySearchingInsertionIndex usingComparator:[self comparatorForIndex:index]];
+        [identifiers insertObject:identifier atIndex:position];
+    }
+    id source = [values objectAtIndex:3];
+    if(source != [NSNull null]){
+        NSMutableSet *sourceIDs = [sources objectForKey:source];
+        if(!sourceIDs){
+            sourceIDs = [[NSMutableSet alloc] init];
+            [sources setObject:sourceIDs forKey:source];
+        }
+        [sourceIDs addObject:identifier];
+    }
+    if([[values objectAtIndex:4] boolValue]){
+        [located addObject:identifier];
+    }
+}
+/**
+ *  Get the comparator of the IDs of an index, using the current index
+ *  values. The ties are sorted by ID, so the order is stable
+ *
+ *  @param index The index
+ *
+ *  @return The comparator
+ */
+-(NSComparator)comparatorForIndex:(OlapicMediaStoreIndex)index{
+    NSDictionary *values = indexValues;
+    return ^NSComparisonResult(NSString *identifier, NSString *other){
+        NSComparisonResult result = [OlapicMediaStore compareValue:[[values objectForKey:identifier] objectAtIndex:index] toValue:[[values objectForKey:other] objectAtIndex:index]];
+        return result != NSOrderedSame ? result : [identifier compare:other];
+    };
+}
+/**
+ *  Compare two sort values, the higher (or newer) first and the
+ *  missing ones at the end
+ *
+ *  @param value The first value
+ *  @param other The second value
+ *
+ *  @return The order of the values
+ */
++(NSComparisonResult)compareValue:(id)value toValue:(id)other{
+    BOOL missing = !value || value == [NSNull null];
+    BOOL otherMissing = !other || other == [NSNull null];
+    if(missing || otherMissing){
+        if(missing == otherMissing) return NSOrderedSame;
+        return missing ? NSOrderedDescending : NSOrderedAscending;
+    }
+    return [other compare:value];
+}
+/**
+ *  Get the values used by the indexes for a media: the date, photorank
+ *  and rating (in the OlapicMediaStoreIndex order), the source and
+ *  the location flag
+ *
+ *  @param data The media data
+ *
+ *  @return An array of dates, strings, numbers or NSNull
+ */
++(NSArray *)indexValuesForData:(NSDictionary *)data{
+    id date = [data valueForKey:OlapicMediaStoreDateKey];
+    // The strings only sort right with the same offset and format
+    date = [date isKindOfClass:[NSString class]] ? [OlapicMediaListController dateFromString:date] : nil;
+    id photorank = [data valueForKey:OlapicMediaStorePhotorankKey];
+    id rating = [data valueForKey:OlapicMediaStoreRatingKey];
+    id source = [data valueForKey:OlapicMediaStoreSourceKey];
+    id location = [data valueForKey:OlapicMediaStoreLocationKey];
+    // The numbers can come as strings
+    if([photorank isKindOfClass:[NSString class]]) photorank = [NSNumber numberWithDouble:[photorank doubleValue]];
+    if([rating isKindOfClass:[NSString class]]) rating = [NSNumber numberWithDouble:[rating doubleValue]];
+    BOOL hasLocation = location && location != [NSNull null] && (![location respondsToSelector:@selector(count)] || [location count] > 0);
+    return @[date ? date : [NSNull null],
+             [photorank isKindOfClass:[NSNumber class]] ? photorank : [NSNull null],
+             [rating isKindOfClass:[NSNumber class]] ? rating : [NSNull null],
+             [source isKindOfClass:[NSString class]] && [source length] ? source : [NSNull null],
+             [NSNumber numberWithBool:hasLocation]];
+}
+/**
+ *  Stop observing the notifications
+ */
+-(void)dealloc{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+@end
\ No newline at end of file
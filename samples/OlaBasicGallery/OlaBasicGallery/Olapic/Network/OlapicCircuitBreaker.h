@@ -0,0 +1,146 @@
+//
+//  OlapicCircuitBreaker.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+/**
+ *  The error domain for the requests the network client rejects
+ */
+extern NSString * const OlapicNetworkErrorDomain;
+/**
+ *  The error code used when a request is rejected because
+ *  the circuit of its endpoint is open
+ */
+extern NSInteger const OlapicNetworkErrorCircuitOpen;
+/**
+ *  The error code used when the API response can't be read
+ */
+extern NSInteger const OlapicNetworkErrorInvalidResponse;
+/**
+ *  The states of a circuit breaker
+ */
+typedef NS_ENUM(NSInteger, OlapicCircuitState){
+    /**
+     *  Everything is fine, the requests go through
+     */
+    OlapicCircuitStateClosed = 0,
+    /**
+     *  The endpoint is failing, the requests are rejected
+     */
+    OlapicCircuitStateOpen = 1,
+    /**
+     *  The wait is over, a single request goes through to
+     *  check if the endpoint is back
+     */
+    OlapicCircuitStateHalfOpen = 2
+};
+/**
+ *  A circuit breaker for an endpoint type (like 'the media list' or
+ *  'the images CDN'). After failureThreshold consecutive failures the
+ *  circuit opens and the requests to the endpoint fail right away,
+ *  instead of hammering an API that is already in trouble. After
+ *  resetTimeout a single request is let through, and its result
+ *  closes or opens the circuit again.
+ */
+@interface OlapicCircuitBreaker : NSObject{
+    /**
+     *  The endpoint type this breaker protects
+     */
+    NSString *endpoint;
+    /**
+     *  The current state
+     */
+    OlapicCircuitState state;
+    /**
+     *  How many consecutive failures open the circuit
+     */
+    NSInteger failureThreshold;
+    /**
+     *  How long the circuit stays open, in seconds
+     */
+    NSTimeInterval resetTimeout;
+    /**
+     *  The current count of consecutive failures
+     */
+    NSInteger failures;
+    /**
+     *  When the circuit can be half opened
+     */
+    NSDate *retryDate;
+    /**
+     *  If there's a request checking the endpoint while the circuit is half open
+     */
+    BOOL probing;
+}
+
+@property (nonatomic,strong,readonly) NSString *endpoint;
+@property (nonatomic,readonly) OlapicCircuitState state;
+@property (nonatomic) NSInteger failureThreshold;
+@property (nonatomic) NSTimeInterval resetTimeout;
+/**
+ *  Class constructor
+ *
+ *  @param name The endpoint type this breaker protects
+ *
+ *  @return An instance of this object (OlapicCircuitBreaker)
+ */
+-(id)initWithEndpoint:(NSString *)name;
+/**
+ *  Check if a request can be sent to the endpoint. If the circuit
+ *  was open and the wait is over, this switches to half open and
+ *  lets that request through
+ *
+ *  @return YES if the request can be sent
+ */
+-(BOOL)allowsRequest;
+/**
+ *  Tell the breaker a request was successful
+ */
+-(void)recordSuccess;
+/**
+ *  Tell the breaker a request failed
+ */
+-(void)recordFailure;
+/**
+ *  Tell the breaker a request ended without saying anything about
+ *  the endpoint (it was cancelled, or the server asked to wait). If
+ *  it was the request checking the endpoint, the circuit stays half
+ *  open and the next request checks it instead
+ */
+-(void)recordInconclusive;
+/**
+ *  Create the error used for the rejected requests
+ *
+ *  @return The error
+ */
+-(NSError *)openCircuitError;
+
+@end
\ No newline at end of file
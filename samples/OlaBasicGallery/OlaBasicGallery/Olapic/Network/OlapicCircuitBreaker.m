@@ -0,0 +1,144 @@
+//
+//  OlapicCircuitBreaker.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicCircuitBreaker.h"
+
+NSString * const OlapicNetworkErrorDomain = @"OlapicNetworkErrorDomain";
+NSInteger const OlapicNetworkErrorCircuitOpen = 1;
+NSInteger const OlapicNetworkErrorInvalidResponse = 2;
+
+@interface OlapicCircuitBreaker()
+/**
+ *  Open the circuit
+ *
+ *  @param timeout For how long, in seconds
+ */
+-(void)openFor:(NSTimeInterval)timeout;
+
+@end
+
+@implementation OlapicCircuitBreaker
+@synthesize endpoint,state,failureThreshold,resetTimeout;
+/**
+ *  Class constructor
+ *
+ *  @param name The endpoint type this breaker protects
+ *
+ *  @return An instance of this object (OlapicCircuitBreaker)
+ */
+-(id)initWithEndpoint:(NSString *)name{
+    self = [super init];
+    if(self){
+        endpoint = name;
+        state = OlapicCircuitStateClosed;
+        failureThreshold = 5;
+        resetTimeout = 30;
+        failures = 0;
+        probing = NO;
+    }
+    return self;
+}
+/**
+ *  Check if a request can be sent to the endpoint. If the circuit
+ *  was open and the wait is over, this switches to half open and
+ *  lets that request through
+ *
+ *  @return YES if the request can be sent
+ */
+-(BOOL)allowsRequest{
+    switch(state){
+        case OlapicCircuitStateClosed:
+            return YES;
+        case OlapicCircuitStateOpen:
+            if([retryDate timeIntervalSinceNow] > 0){
+                return NO;
+            }
+            state = OlapicCircuitStateHalfOpen;
+            probing = YES;
+            return YES;
+        default:
+            // Only one request at a time checks the endpoint
+            if(probing){
+                return NO;
+            }
+            probing = YES;
+            return YES;
+    }
+}
+/**
+ *  Tell the breaker a request was successful
+ */
+-(void)recordSuccess{
+    failures = 0;
+    state = OlapicCircuitStateClosed;
+    retryDate = nil;
+    probing = NO;
+}
+/**
+ *  Tell the breaker a request failed
+ */
+-(void)recordFailure{
+    failures++;
+    if(state == OlapicCircuitStateHalfOpen || failures >= failureThreshold){
+        [self openFor:resetTimeout];
+    }
+}
+/**
+ *  Tell the breaker a request ended without saying anything about
+ *  the endpoint (it was cancelled, or the server asked to wait). If
+ *  it was the request checking the endpoint, the circuit stays half
+ *  open and the next request checks it instead
+ */
+-(void)recordInconclusive{
+    probing = NO;
+}
+/**
+ *  Open the circuit
+ *
+ *  @param timeout For how long, in seconds
+ */
+-(void)openFor:(NSTimeInterval)timeout{
+    state = OlapicCircuitStateOpen;
+    retryDate = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    probing = NO;
+}
+/**
+ *  Create the error used for the rejected requests
+ *
+ *  @return The error
+ */
+-(NSError *)openCircuitError{
+    NSString *description = [NSString stringWithFormat:@"The '%@' endpoint is failing, the request wasn't sent", endpoint];
+    return [NSError errorWithDomain:OlapicNetworkErrorDomain code:OlapicNetworkErrorCircuitOpen userInfo:@{NSLocalizedDescriptionKey: description}];
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,140 @@
+//
+//  OlapicFixtureTransport.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "OlapicNetworkTransport.h"
+/**
+ *  What the fixture transport does with the requests
+ */
+typedef NS_ENUM(NSInteger, OlapicFixtureTransportMode){
+    /**
+     *  Send them with the wrapped transport
+     */
+    OlapicFixtureTransportModePassthrough = 0,
+    /**
+     *  Send them with the wrapped transport and save the responses
+     */
+    OlapicFixtureTransportModeRecord = 1,
+    /**
+     *  Answer them with the saved responses, without using the network
+     */
+    OlapicFixtureTransportModeReplay = 2
+};
+/**
+ *  A transport for repeatable performance tests. It wraps another
+ *  transport and can record the real API responses as fixtures, or
+ *  replay them later (with an optional latency) without the network.
+ *
+ *  Each fixture is a pair of files on the fixturesPath: '<key>.json',
+ *  with the method, URL, status and headers, and '<key>.body'. The key
+ *  comes from the method and the URL, without the 'auth_token' (it's
+ *  never saved) and with the query parameters sorted.
+ *
+ *  The same fixtures can be served by tools/olapic_mock_server.py, the
+ *  local stand-in for the API. Set a serverURL to send every request
+ *  (API and images) to it instead of their hosts.
+ */
+@interface OlapicFixtureTransport : NSObject <OlapicNetworkTransport>{
+    /**
+     *  The transport that sends the requests when not replaying
+     */
+    id<OlapicNetworkTransport> transport;
+    /**
+     *  What to do with the requests
+     */
+    OlapicFixtureTransportMode mode;
+    /**
+     *  The directory with the fixtures
+     */
+    NSString *fixturesPath;
+    /**
+     *  The server that gets the requests instead of their hosts (optional)
+     */
+    NSURL *serverURL;
+    /**
+     *  How long each replayed response takes, in seconds
+     */
+    NSTimeInterval replayLatency;
+    /**
+     *  The queue where the completion blocks are called
+     */
+    dispatch_queue_t completionQueue;
+    /**
+     *  The group the completion blocks are associated with
+     */
+    dispatch_group_t completionGroup;
+    /**
+     *  The queue that reads and writes the fixtures
+     */
+    dispatch_queue_t fixturesQueue;
+    /**
+     *  The metrics of the replayed responses
+     */
+    OlapicTransportMetrics *replayMetrics;
+}
+
+@property (nonatomic,strong,readonly) id<OlapicNetworkTransport> transport;
+@property (nonatomic) OlapicFixtureTransportMode mode;
+@property (nonatomic,copy,readonly) NSString *fixturesPath;
+@property (nonatomic,strong) NSURL *serverURL;
+@property (nonatomic) NSTimeInterval replayLatency;
+@property (nonatomic,strong) dispatch_queue_t completionQueue;
+@property (nonatomic,strong) dispatch_group_t completionGroup;
+/**
+ *  Class constructor
+ *
+ *  @param wrapped The transport that sends the requests when not replaying
+ *  @param path    The directory with the fixtures (created if it doesn't exist)
+ *  @param fixtureMode What to do with the requests
+ *
+ *  @return An instance of this object (OlapicFixtureTransport)
+ */
+-(id)initWithTransport:(id<OlapicNetworkTransport>)wrapped fixturesPath:(NSString *)path mode:(OlapicFixtureTransportMode)fixtureMode;
+/**
+ *  Get the key of the fixture for a request
+ *
+ *  @param request The request
+ *
+ *  @return The key (the fixture file name, without the extension)
+ */
++(NSString *)fixtureKeyForRequest:(NSURLRequest *)request;
+/**
+ *  Get a URL without the 'auth_token' parameter and with the query
+ *  parameters sorted
+ *
+ *  @param URL The URL
+ *
+ *  @return The canonical URL
+ */
++(NSString *)canonicalURL:(NSURL *)URL;
+
+@end
\ No newline at end of file
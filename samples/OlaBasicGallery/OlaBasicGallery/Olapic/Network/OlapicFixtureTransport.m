@@ -0,0 +1,271 @@
+//
+//  OlapicFixtureTransport.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicFixtureTransport.h"
+
+@interface OlapicFixtureTransport()
+/**
+ *  Send the request to the serverURL instead of its host
+ *
+ *  @param request The request
+ *
+ *  @return The request for the server, or the same one if there's no serverURL
+ */
+-(NSURLRequest *)requestForServer:(NSURLRequest *)request;
+/**
+ *  Save a response as the fixture of a request
+ *
+ *  @param responseData The response data
+ *  @param response     The HTTP response
+ *  @param request      The original request
+ */
+-(void)recordResponseData:(NSData *)responseData response:(NSHTTPURLResponse *)response forRequest:(NSURLRequest *)request;
+/**
+ *  Answer a request with its fixture
+ *
+ *  @param request    The request
+ *  @param completion The completion block
+ *
+ *  @return An object that responds to 'cancel'
+ */
+-(id)replayRequest:(NSURLRequest *)request onCompletion:(void (^)(NSData *responseData, NSHTTPURLResponse *response, NSError *error))completion;
+
+@end
+
+@implementation OlapicFixtureTransport
+@synthesize transport,mode,fixturesPath,serverURL,replayLatency,completionQueue,completionGroup;
+/**
+ *  Class constructor
+ *
+ *  @param wrapped The transport that sends the requests when not replaying
+ *  @param path    The directory with the fixtures (created if it doesn't exist)
+ *  @param fixtureMode What to do with the requests
+ *
+ *  @return An instance of this object (OlapicFixtureTransport)
+ */
+-(id)initWithTransport:(id<OlapicNetworkTransport>)wrapped fixturesPath:(NSString *)path mode:(OlapicFixtureTransportMode)fixtureMode{
+    self = [super init];
+    if(self){
+        transport = wrapped;
+        fixturesPath = [path copy];
+        mode = fixtureMode;
+        replayLatency = 0;
+        fixturesQueue = dispatch_queue_create("com.olapic.network.fixtures", DISPATCH_QUEUE_SERIAL);
+        replayMetrics = [[OlapicTransportMetrics alloc] init];
+        [[NSFileManager defaultManager] createDirectoryAtPath:fixturesPath withIntermediateDirectories:YES attributes:nil error:nil];
+    }
+    return self;
+}
+/**
+ *  Set the queue where the completion blocks are called, on this
+ *  transport and the wrapped one
+ *
+ *  @param queue The queue
+ */
+-(void)setCompletionQueue:(dispatch_queue_t)queue{
+    completionQueue = queue;
+    transport.completionQueue = queue;
+}
+/**
+ *  Set the group the completion blocks are associated with, on this
+ *  transport and the wrapped one
+ *
+ *  @param group The group
+ */
+-(void)setCompletionGroup:(dispatch_group_t)group{
+    completionGroup = group;
+    transport.completionGroup = group;
+}
+/**
+ *  Send a request
+ *
+ *  @param request    The request
+ *  @param completion A callback block, called on the completionQueue, with the response data, the HTTP response and an error if the request failed
+ *
+ *  @return An object that responds to 'cancel'
+ */
+-(id)startRequest:(NSURLRequest *)request onCompletion:(void (^)(NSData *responseData, NSHTTPURLResponse *response, NSError *error))completion{
+    if(mode == OlapicFixtureTransportModeReplay){
+        return [self replayRequest:request onCompletion:completion];
+    }
+    BOOL records = mode == OlapicFixtureTransportModeRecord;
+    return [transport startRequest:[self requestForServer:request] onCompletion:^(NSData *responseData, NSHTTPURLResponse *response, NSError *error){
+        // The network errors have no response, there's nothing to replay
+        if(records && response) [self recordResponseData:responseData response:response forRequest:request];
+        if(completion) completion(responseData, response, error);
+    }];
+}
+/**
+ *  Get the transport metrics (the wrapped transport ones, unless
+ *  it's replaying)
+ *
+ *  @return The metrics
+ */
+-(OlapicTransportMetrics *)metrics{
+    return mode == OlapicFixtureTransportModeReplay ? replayMetrics : [transport metrics];
+}
+/**
+ *  Send the request to the serverURL instead of its host
+ *
+ *  @param request The request
+ *
+ *  @return The request for the server, or the same one if there's no serverURL
+ */
+-(NSURLRequest *)requestForServer:(NSURLRequest *)request{
+    if(!serverURL || !request.URL.host) return request;
+    NSString *URL = [request.URL absoluteString];
+    NSRange path = [URL rangeOfString:@"/" options:0 range:NSMakeRange([request.URL.scheme length] + 3, [URL length] - [request.URL.scheme length] - 3)];
+    NSString *server = [[serverURL absoluteString] stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"/"]];
+    NSString *serverRequestURL = path.location == NSNotFound ? server : [server stringByAppendingString:[URL substringFromIndex:path.location]];
+    NSMutableURLRequest *serverRequest = [request mutableCopy];
+    serverRequest.URL = [NSURL URLWithString:serverRequestURL];
+    return serverRequest;
+}
+/**
+ *  Get a URL without the 'auth_token' parameter and with the query
+ *  parameters sorted
+ *
+ *  @param URL The URL
+ *
+ *  @return The canonical URL
+ */
++(NSString *)canonicalURL:(NSURL *)URL{
+    NSString *absolute = [URL absoluteString];
+    NSRange query = [absolute rangeOfString:@"?"];
+    if(query.location == NSNotFound) return absolute;
+    NSMutableArray *parameters = [[NSMutableArray alloc] init];
+    for(NSString *parameter in [[absolute substringFromIndex:query.location + 1] componentsSeparatedByString:@"&"]){
+        if(![parameter length] || [parameter hasPrefix:@"auth_token="]) continue;
+        [parameters addObject:parameter];
+    }
+    [parameters sortUsingSelector:@selector(compare:)];
+    NSString *base = [absolute substringToIndex:query.location];
+    return [parameters count] ? [NSString stringWithFormat:@"%@?%@", base, [parameters componentsJoinedByString:@"&"]] : base;
+}
+/**
+ *  Get the key of the fixture for a request
+ *
+ *  @param request The request
+ *
+ *  @return The key (the fixture file name, without the extension)
+ */
++(NSString *)fixtureKeyForRequest:(NSURLRequest *)request{
+    NSString *method = request.HTTPMethod ?: @"GET";
+    NSString *canonical = [NSString stringWithFormat:@"%@ %@", method, [OlapicFixtureTransport canonicalURL:request.URL]];
+    // FNV-1a, it only needs to be stable
+    uint64_t hash = 14695981039346656037ULL;
+    for(const char *bytes = [canonical UTF8String]; bytes && *bytes; bytes++){
+        hash ^= (uint8_t)*bytes;
+        hash *= 1099511628211ULL;
+    }
+    return [NSString stringWithFormat:@"%@-%016llx", [method lowercaseString], hash];
+}
+/**
+ *  Save a response as the fixture of a request
+ *
+ *  @param responseData The response data
+ *  @param response     The HTTP response
+ *  @param request      The original request
+ */
+-(void)recordResponseData:(NSData *)responseData response:(NSHTTPURLResponse *)response forRequest:(NSURLRequest *)request{
+    NSString *key = [OlapicFixtureTransport fixtureKeyForRequest:request];
+    NSURL *URL = request.URL;
+    NSString *canonical = [OlapicFixtureTransport canonicalURL:URL];
+    NSRange query = [canonical rangeOfString:@"?"];
+    // The body was already decompressed, and its length can change
+    NSMutableDictionary *headers = [[response allHeaderFields] mutableCopy];
+    for(NSString *name in [headers allKeys]){
+        NSString *lowercase = [name lowercaseString];
+        if([lowercase isEqualToString:@"content-encoding"] || [lowercase isEqualToString:@"content-length"] || [lowercase isEqualToString:@"transfer-encoding"] || [lowercase isEqualToString:@"set-cookie"]){
+            [headers removeObjectForKey:name];
+        }
+    }
+    NSDictionary *fixture = @{@"method": request.HTTPMethod ?: @"GET",
+                              @"url": canonical,
+                              @"host": URL.host ?: @"",
+                              @"path": [URL path] ?: @"/",
+                              @"query": query.location == NSNotFound ? @"" : [canonical substringFromIndex:query.location + 1],
+                              @"status": [NSNumber numberWithInteger:response.statusCode],
+                              @"headers": headers,
+                              @"body": [key stringByAppendingPathExtension:@"body"]};
+    NSData *data = responseData ?: [NSData data];
+    NSString *directory = fixturesPath;
+    dispatch_async(fixturesQueue, ^{
+        NSData *JSON = [NSJSONSerialization dataWithJSONObject:fixture options:NSJSONWritingPrettyPrinted error:nil];
+        [data writeToFile:[directory stringByAppendingPathComponent:[key stringByAppendingPathExtension:@"body"]] atomically:YES];
+        [JSON writeToFile:[directory stringByAppendingPathComponent:[key stringByAppendingPathExtension:@"json"]] atomically:YES];
+    });
+}
+/**
+ *  Answer a request with its fixture
+ *
+ *  @param request    The request
+ *  @param completion The completion block
+ *
+ *  @return An object that responds to 'cancel'
+ */
+-(id)replayRequest:(NSURLRequest *)request onCompletion:(void (^)(NSData *responseData, NSHTTPURLResponse *response, NSError *error))completion{
+    NSBlockOperation *operation = [[NSBlockOperation alloc] init];
+    NSString *key = [OlapicFixtureTransport fixtureKeyForRequest:request];
+    NSString *directory = fixturesPath;
+    NSURL *URL = request.URL;
+    dispatch_queue_t queue = completionQueue ?: dispatch_get_main_queue();
+    dispatch_group_t group = completionGroup;
+    OlapicTransportMetrics *metrics = replayMetrics;
+    if(group) dispatch_group_enter(group);
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(replayLatency * NSEC_PER_SEC)), fixturesQueue, ^{
+        NSData *JSON = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:[key stringByAppendingPathExtension:@"json"]]];
+        NSDictionary *fixture = JSON ? [NSJSONSerialization JSONObjectWithData:JSON options:0 error:nil] : nil;
+        NSData *data = nil;
+        NSHTTPURLResponse *response = nil;
+        NSError *error = nil;
+        if([fixture isKindOfClass:[NSDictionary class]]){
+            data = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:[key stringByAppendingPathExtension:@"body"]]];
+            NSInteger status = [[fixture valueForKey:@"status"] integerValue];
+            response = [[NSHTTPURLResponse alloc] initWithURL:URL statusCode:status HTTPVersion:@"HTTP/1.1" headerFields:[fixture valueForKey:@"headers"]];
+            if(status >= 400){
+                error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadServerResponse userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Recorded status %ld", (long)status], NSURLErrorFailingURLErrorKey: URL}];
+            }
+        }else{
+            response = [[NSHTTPURLResponse alloc] initWithURL:URL statusCode:404 HTTPVersion:@"HTTP/1.1" headerFields:nil];
+            error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorResourceUnavailable userInfo:@{NSLocalizedDescriptionKey: @"There's no fixture for the request", NSURLErrorFailingURLErrorKey: URL}];
+        }
+        [metrics addRequestWithBytes:[data length] reusedConnection:YES protocol:@"replay"];
+        dispatch_async(queue, ^{
+            if(completion && ![operation isCancelled]) completion(data, response, error);
+            if(group) dispatch_group_leave(group);
+        });
+    });
+    return operation;
+}
+
+@end
\ No newline at end of file
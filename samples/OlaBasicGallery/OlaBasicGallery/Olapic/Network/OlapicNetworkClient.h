@@ -0,0 +1,226 @@
+//
+//  OlapicNetworkClient.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "OlapicNetworkTask.h"
+#import "OlapicRetryPolicy.h"
+#import "OlapicCircuitBreaker.h"
+#import "OlapicNetworkTransport.h"
+#import "OlapicTransferStats.h"
+/**
+ *  The type of connection the device is using
+ */
+typedef NS_ENUM(NSInteger, OlapicNetworkClass){
+    /**
+     *  There's no connection
+     */
+    OlapicNetworkClassOffline = 0,
+    /**
+     *  Connected using a cellular (WWAN) network
+     */
+    OlapicNetworkClassCellular = 1,
+    /**
+     *  Connected using WiFi (or the status is still unknown)
+     */
+    OlapicNetworkClassWiFi = 2
+};
+/**
+ *  The policy layer between the sample and the API. It watches the
+ *  network reachability and decides when each request can start:
+ *
+ *  - On WiFi it runs up to maxConcurrentRequestsOnWiFi requests
+ *  - On cellular it runs up to maxConcurrentRequestsOnCellular requests,
+ *    original images wait for everything else and prefetches wait for WiFi
+ *  - When offline nothing starts, and requests that failed because the
+ *    connection was lost go back to the queue. Everything resumes
+ *    automatically when the connection comes back
+ *  - Failed requests are retried following the retryPolicy, and each
+ *    endpoint type has a circuit breaker, so a failing API doesn't get
+ *    a retry from every thumbnail on the screen
+ *  - The responses are requested compressed (gzip, deflate and, when the
+ *    system can decode it, brotli). The transport decompresses them, and
+ *    transferStats counts the bytes before and after, by endpoint type
+ *
+ *  All the methods should be called from the main thread, and the
+ *  callbacks are called on the main thread. The transport delivers the
+ *  responses on the processingQueue, where the tasks' processing blocks
+ *  (like the JSON parsing) run, so the main thread only gets the final
+ *  result.
+ */
+@interface OlapicNetworkClient : NSObject{
+    /**
+     *  The tasks waiting to be started, sorted by priority
+     */
+    NSMutableArray *pending;
+    /**
+     *  The tasks currently running
+     */
+    NSMutableArray *running;
+    /**
+     *  The current connection type
+     */
+    OlapicNetworkClass networkClass;
+    /**
+     *  How many requests can run at the same time on WiFi
+     */
+    NSInteger maxConcurrentRequestsOnWiFi;
+    /**
+     *  How many requests can run at the same time on cellular
+     */
+    NSInteger maxConcurrentRequestsOnCellular;
+    /**
+     *  If YES, prefetch requests won't start on cellular
+     */
+    BOOL defersPrefetchOnCellular;
+    /**
+     *  If YES, original images only start on cellular when
+     *  nothing else is waiting
+     */
+    BOOL defersOriginalsOnCellular;
+    /**
+     *  The API key, added as 'auth_token' to API requests that
+     *  don't have one
+     */
+    NSString *authKey;
+    /**
+     *  The policy used to retry the failed requests
+     */
+    OlapicRetryPolicy *retryPolicy;
+    /**
+     *  The circuit breakers, by endpoint type
+     */
+    NSMutableDictionary *breakers;
+    /**
+     *  The transport used to send the requests. By default it's an
+     *  OlapicOperationTransport, set an OlapicSessionTransport to
+     *  share (and multiplex) the connections
+     */
+    id<OlapicNetworkTransport> transport;
+    /**
+     *  The background queue where the responses are processed
+     */
+    dispatch_queue_t processingQueue;
+    /**
+     *  The group every response is associated with, until its
+     *  callback is called
+     */
+    dispatch_group_t completionGroup;
+    /**
+     *  If YES, the API requests accept the compact (MessagePack) format.
+     *  Read the responses with OlapicPayloadDecoder
+     */
+    BOOL acceptsCompactPayloads;
+    /**
+     *  The compressed and uncompressed bytes, by endpoint type
+     */
+    OlapicTransferStats *transferStats;
+}
+
+@property (nonatomic,readonly) OlapicNetworkClass networkClass;
+@property (nonatomic) NSInteger maxConcurrentRequestsOnWiFi;
+@property (nonatomic) NSInteger maxConcurrentRequestsOnCellular;
+@property (nonatomic) BOOL defersPrefetchOnCellular;
+@property (nonatomic) BOOL defersOriginalsOnCellular;
+@property (nonatomic,strong) NSString *authKey;
+@property (nonatomic,strong) OlapicRetryPolicy *retryPolicy;
+@property (nonatomic,strong) id<OlapicNetworkTransport> transport;
+@property (nonatomic,strong) dispatch_queue_t processingQueue;
+@property (nonatomic,strong,readonly) dispatch_group_t completionGroup;
+@property (nonatomic) BOOL acceptsCompactPayloads;
+@property (nonatomic,strong,readonly) OlapicTransferStats *transferStats;
+/**
+ *  Get the singleton shared instance
+ *
+ *  @return The shared instance
+ */
++(instancetype)sharedClient;
+/**
+ *  Queue a GET request for the NSData information
+ *
+ *  @param URL        The URL to request
+ *  @param parameters The parameters for the query string
+ *  @param priority   The request priority
+ *  @param success    A callback block for when the request is successfully done
+ *  @param failure    A callback block for when the request fails (always called on the main thread, after this method returns)
+ *
+ *  @return The task, so it can be cancelled
+ */
+-(OlapicNetworkTask *)getData:(NSString *)URL parameters:(NSDictionary *)parameters priority:(OlapicRequestPriority)priority onSuccess:(void (^)(NSData *responseData))success onFailure:(void (^)(NSError *error))failure;
+/**
+ *  Queue a GET request and process the response on the processingQueue
+ *
+ *  @param URL        The URL to request
+ *  @param parameters The parameters for the query string
+ *  @param priority   The request priority
+ *  @param processing A block to turn the response data into the object for the success callback. It runs on the processingQueue, and if it returns nil and sets the error, the failure callback is called
+ *  @param success    A callback block for when the request is successfully done
+ *  @param failure    A callback block for when the request fails (always called on the main thread, after this method returns)
+ *
+ *  @return The task, so it can be cancelled
+ */
+-(OlapicNetworkTask *)getObject:(NSString *)URL parameters:(NSDictionary *)parameters priority:(OlapicRequestPriority)priority processing:(id (^)(NSData *responseData, NSError **error))processing onSuccess:(void (^)(id responseObject))success onFailure:(void (^)(NSError *error))failure;
+/**
+ *  Check if a request with a given priority would start right
+ *  now using the current network
+ *
+ *  @param priority The request priority
+ *
+ *  @return If the request can start
+ */
+-(BOOL)allowsRequestsWithPriority:(OlapicRequestPriority)priority;
+/**
+ *  Get the endpoint type of a URL, used to group the requests
+ *  that share a circuit breaker. API requests are grouped by
+ *  resource path (without the IDs) and images by host
+ *
+ *  @param URL The URL
+ *
+ *  @return The endpoint type (like 'api/customers/media/recent')
+ */
+-(NSString *)endpointForURL:(NSString *)URL;
+/**
+ *  Get the circuit breaker for an endpoint type
+ *
+ *  @param endpoint The endpoint type
+ *
+ *  @return The circuit breaker
+ */
+-(OlapicCircuitBreaker *)circuitBreakerForEndpoint:(NSString *)endpoint;
+/**
+ *  Remove a cancelled task from the queues. This is called
+ *  by the task itself
+ *
+ *  @param task The cancelled task
+ */
+-(void)taskDidCancel:(OlapicNetworkTask *)task;
+
+@end
\ No newline at end of file
@@ -0,0 +1,605 @@
+//
+//  OlapicNetworkClient.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicNetworkClient.h"
+#import <OlapicSDK/OlapicSDK.h>
+#import "OlapicAFURLRequestSerialization.h"
+#import "OlapicAFNetworkReachabilityManager.h"
+#import "OlapicOperationTransport.h"
+#import "OlapicPayloadDecoder.h"
+
+@interface OlapicNetworkClient(){
+    /**
+     *  The serializer used to create the requests
+     */
+    OlapicAFHTTPRequestSerializer *requestSerializer;
+}
+/**
+ *  Read the reachability status and update the network class
+ *
+ *  @param status The new reachability status
+ */
+-(void)updateNetworkClass:(OlapicAFNetworkReachabilityStatus)status;
+/**
+ *  Start as many pending tasks as the current network allows
+ */
+-(void)startPendingTasks;
+/**
+ *  Start a task
+ *
+ *  @param task The task to start
+ */
+-(void)startTask:(OlapicNetworkTask *)task;
+/**
+ *  Add a task to the pending queue, after the tasks with the
+ *  same priority (or before them, if it's a task being retried)
+ *
+ *  @param task  The task to add
+ *  @param first If YES, the task goes before the ones with the same priority
+ */
+-(void)enqueueTask:(OlapicNetworkTask *)task first:(BOOL)first;
+/**
+ *  Handle a failed request: wait for the connection, retry it
+ *  or call the failure callback
+ *
+ *  @param task      The task
+ *  @param error     The request error
+ *  @param response  The HTTP response, if there was one
+ *  @param breaker   The circuit breaker of the task endpoint
+ */
+-(void)task:(OlapicNetworkTask *)task didFailWithError:(NSError *)error response:(NSHTTPURLResponse *)response breaker:(OlapicCircuitBreaker *)breaker;
+/**
+ *  Call the failure callback of a task that couldn't be started. It's
+ *  called on the next turn of the main queue, so the caller always has
+ *  the task (and can forget it) before its callbacks run
+ *
+ *  @param task  The task
+ *  @param error The error
+ */
+-(void)task:(OlapicNetworkTask *)task didNotStartWithError:(NSError *)error;
+/**
+ *  Call the failure callback of a task that couldn't be started. It's
+ *  called on the next turn of the main queue, so the caller always has
+ *  the task (and can forget it) before its callbacks run
+ *
+ *  @param task  The task
+ *  @param error The error
+ */
+-(void)task:(OlapicNetworkTask *)task didNotStartWithError:(NSError *)error{
+    dispatch_group_enter(completionGroup);
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if(!task.cancelled && task.failure) task.failure(error);
+        dispatch_group_leave(completionGroup);
+    });
+}
+/**
+ *  Check if a failure means the endpoint is in trouble (and
+ *  not just that the request was wrong)
+ *
+ *  @param error    The request error
+ *  @param response The HTTP response, if there was one
+ *
+ *  @return YES if the failure counts for the circuit breaker
+ */
+-(BOOL)isEndpointFailure:(NSError *)error response:(NSHTTPURLResponse *)response;
+/**
+ *  Check if an error was caused by the lack of connection
+ *
+ *  @param error The error
+ *
+ *  @return YES if the request can be retried once the device is back online
+ */
+-(BOOL)isConnectionError:(NSError *)error;
+/**
+ *  Prepare a URL to be used by NSURLRequest (the API uses
+ *  protocol relative URLs)
+ *
+ *  @param URL The URL
+ *
+ *  @return The absolute URL
+ */
+-(NSString *)absoluteURL:(NSString *)URL;
+/**
+ *  Add the auth_token to the parameters of an API request
+ *
+ *  @param parameters The original parameters
+ *  @param URL        The request URL
+ *
+ *  @return The parameters for the request
+ */
+-(NSDictionary *)parameters:(NSDictionary *)parameters forURL:(NSString *)URL;
+/**
+ *  Get the value for the 'Accept-Encoding' header. Brotli is only
+ *  accepted when the system can decode it (iOS 11)
+ *
+ *  @return The header value
+ */
++(NSString *)acceptedEncodings;
+/**
+ *  Get the number of bytes a response used on the network
+ *
+ *  @param response     The HTTP response
+ *  @param responseData The (already decompressed) response data
+ *
+ *  @return The compressed size, the data size if the response was not compressed, or -1 if it was compressed without a Content-Length (chunked)
+ */
++(long long)compressedLengthOfResponse:(NSHTTPURLResponse *)response data:(NSData *)responseData;
+
+@end
+
+@implementation OlapicNetworkClient
+@synthesize networkClass,maxConcurrentRequestsOnWiFi,maxConcurrentRequestsOnCellular,defersPrefetchOnCellular,defersOriginalsOnCellular,authKey,retryPolicy,transport,processingQueue,completionGroup,acceptsCompactPayloads,transferStats;
+/**
+ *  Get the singleton shared instance
+ *
+ *  @return The shared instance
+ */
++(instancetype)sharedClient{
+    static OlapicNetworkClient *sharedClient = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedClient = [[OlapicNetworkClient alloc] init];
+    });
+    return sharedClient;
+}
+/**
+ *  Class constructor
+ *
+ *  @return An instance of this object (OlapicNetworkClient)
+ */
+-(id)init{
+    self = [super init];
+    if(self){
+        pending = [[NSMutableArray alloc] init];
+        running = [[NSMutableArray alloc] init];
+        maxConcurrentRequestsOnWiFi = 6;
+        maxConcurrentRequestsOnCellular = 2;
+        defersPrefetchOnCellular = YES;
+        defersOriginalsOnCellular = YES;
+        networkClass = OlapicNetworkClassWiFi;
+        retryPolicy = [OlapicRetryPolicy defaultPolicy];
+        breakers = [[NSMutableDictionary alloc] init];
+        requestSerializer = [OlapicAFHTTPRequestSerializer serializer];
+        [requestSerializer setValue:[OlapicNetworkClient acceptedEncodings] forHTTPHeaderField:@"Accept-Encoding"];
+        acceptsCompactPayloads = NO;
+        transferStats = [[OlapicTransferStats alloc] init];
+        processingQueue = dispatch_queue_create("com.olapic.network.processing", DISPATCH_QUEUE_CONCURRENT);
+        completionGroup = dispatch_group_create();
+        self.transport = [[OlapicOperationTransport alloc] init];
+        __weak OlapicNetworkClient *weakSelf = self;
+        OlapicAFNetworkReachabilityManager *reachability = [OlapicAFNetworkReachabilityManager sharedManager];
+        [reachability setReachabilityStatusChangeBlock:^(OlapicAFNetworkReachabilityStatus status){
+            [weakSelf updateNetworkClass:status];
+        }];
+        [reachability startMonitoring];
+    }
+    return self;
+}
+/**
+ *  Read the reachability status and update the network class
+ *
+ *  @param status The new reachability status
+ */
+-(void)updateNetworkClass:(OlapicAFNetworkReachabilityStatus)status{
+    switch(status){
+        case OlapicAFNetworkReachabilityStatusNotReachable:
+            networkClass = OlapicNetworkClassOffline;
+            break;
+        case OlapicAFNetworkReachabilityStatusReachableViaWWAN:
+            networkClass = OlapicNetworkClassCellular;
+            break;
+        default:
+            networkClass = OlapicNetworkClassWiFi;
+            break;
+    }
+    [self startPendingTasks];
+}
+/**
+ *  Queue a GET request for the NSData information
+ *
+ *  @param URL        The URL to request
+ *  @param parameters The parameters for the query string
+ *  @param priority   The request priority
+ *  @param success    A callback block for when the request is successfully done
+ *  @param failure    A callback block for when the request fails (always called on the main thread, after this method returns)
+ *
+ *  @return The task, so it can be cancelled
+ */
+-(OlapicNetworkTask *)getData:(NSString *)URL parameters:(NSDictionary *)parameters priority:(OlapicRequestPriority)priority onSuccess:(void (^)(NSData *responseData))success onFailure:(void (^)(NSError *error))failure{
+    return [self getObject:URL parameters:parameters priority:priority processing:nil onSuccess:success onFailure:failure];
+}
+/**
+ *  Queue a GET request and process the response on the processingQueue
+ *
+ *  @param URL        The URL to request
+ *  @param parameters The parameters for the query string
+ *  @param priority   The request priority
+ *  @param processing A block to turn the response data into the object for the success callback. It runs on the processingQueue, and if it returns nil and sets the error, the failure callback is called
+ *  @param success    A callback block for when the request is successfully done
+ *  @param failure    A callback block for when the request fails (always called on the main thread, after this method returns)
+ *
+ *  @return The task, so it can be cancelled
+ */
+-(OlapicNetworkTask *)getObject:(NSString *)URL parameters:(NSDictionary *)parameters priority:(OlapicRequestPriority)priority processing:(id (^)(NSData *responseData, NSError **error))processing onSuccess:(void (^)(id responseObject))success onFailure:(void (^)(NSError *error))failure{
+    OlapicNetworkTask *task = [[OlapicNetworkTask alloc] initWithURL:URL parameters:parameters priority:priority];
+    task.processing = processing;
+    task.success = success;
+    task.failure = failure;
+    [self enqueueTask:task first:NO];
+    [self startPendingTasks];
+    return task;
+}
+/**
+ *  Set the transport used to send the requests, and make it
+ *  deliver the responses on the processingQueue
+ *
+ *  @param newTransport The transport
+ */
+-(void)setTransport:(id<OlapicNetworkTransport>)newTransport{
+    transport = newTransport;
+    transport.completionQueue = processingQueue;
+    transport.completionGroup = completionGroup;
+}
+/**
+ *  Set the queue where the responses are processed
+ *
+ *  @param queue The queue, it shouldn't be the main one
+ */
+-(void)setProcessingQueue:(dispatch_queue_t)queue{
+    processingQueue = queue;
+    transport.completionQueue = queue;
+}
+/**
+ *  Check if a request with a given priority would start right
+ *  now using the current network
+ *
+ *  @param priority The request priority
+ *
+ *  @return If the request can start
+ */
+-(BOOL)allowsRequestsWithPriority:(OlapicRequestPriority)priority{
+    if(networkClass == OlapicNetworkClassOffline){
+        return NO;
+    }
+    if(networkClass == OlapicNetworkClassCellular){
+        if([running count] >= maxConcurrentRequestsOnCellular){
+            return NO;
+        }
+        if(priority == OlapicRequestPriorityPrefetch && defersPrefetchOnCellular){
+            return NO;
+        }
+        if(priority == OlapicRequestPriorityOriginal && defersOriginalsOnCellular){
+            // Only if nothing more important is waiting or running
+            for(OlapicNetworkTask *task in running){
+                if(task.priority < OlapicRequestPriorityOriginal) return NO;
+            }
+            for(OlapicNetworkTask *task in pending){
+                if(task.priority < OlapicRequestPriorityOriginal) return NO;
+            }
+        }
+        return YES;
+    }
+    return [running count] < maxConcurrentRequestsOnWiFi;
+}
+/**
+ *  Start as many pending tasks as the current network allows
+ */
+-(void)startPendingTasks{
+    NSUInteger i = 0;
+    while(i < [pending count]){
+        OlapicNetworkTask *task = [pending objectAtIndex:i];
+        if(![self allowsRequestsWithPriority:task.priority]){
+            // The queue is sorted, but a deferred priority shouldn't
+            // block the ones after it
+            i++;
+            continue;
+        }
+        [pending removeObjectAtIndex:i];
+        [self startTask:task];
+    }
+}
+/**
+ *  Start a task
+ *
+ *  @param task The task to start
+ */
+-(void)startTask:(OlapicNetworkTask *)task{
+    NSString *URLString = [self absoluteURL:task.URL];
+    NSDictionary *parameters = [self parameters:task.parameters forURL:URLString];
+    NSError *requestError = nil;
+    NSMutableURLRequest *request = [requestSerializer requestWithMethod:@"GET" URLString:URLString parameters:parameters error:&requestError];
+    if(!request){
+        [self task:task didNotStartWithError:requestError];
+        return;
+    }
+    NSString *endpoint = [self endpointForURL:URLString];
+    if(acceptsCompactPayloads && [endpoint hasPrefix:@"api"]){
+        [request setValue:[OlapicPayloadDecoder acceptHeaderAllowingCompactPayloads:YES] forHTTPHeaderField:@"Accept"];
+    }
+    OlapicCircuitBreaker *breaker = [self circuitBreakerForEndpoint:endpoint];
+    if(![breaker allowsRequest]){
+        [self task:task didNotStartWithError:[breaker openCircuitError]];
+        return;
+    }
+    [running addObject:task];
+    // Cancelling the task clears its blocks on the main thread, so
+    // the processing queue gets its own reference
+    id (^processing)(NSData *responseData, NSError **error) = task.processing;
+    task.operation = [transport startRequest:request onCompletion:^(NSData *responseData, NSHTTPURLResponse *response, NSError *error){
+        // This runs on the processingQueue, the heavy work goes here
+        if(responseData){
+            [transferStats addResponseForEndpoint:endpoint compressedBytes:[OlapicNetworkClient compressedLengthOfResponse:response data:responseData] uncompressedBytes:[responseData length]];
+        }
+        id responseObject = responseData;
+        NSError *processingError = nil;
+        if(!error && processing && !task.cancelled){
+            responseObject = processing(responseData, &processingError);
+        }
+        dispatch_group_enter(completionGroup);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [running removeObject:task];
+            task.operation = nil;
+            if(error){
+                [self task:task didFailWithError:error response:response breaker:breaker];
+            }else{
+                [breaker recordSuccess];
+                if(task.cancelled){
+                    // Nothing to do
+                }else if(!responseObject && processingError){
+                    if(task.failure) task.failure(processingError);
+                }else if(task.success){
+                    task.success(responseObject);
+                }
+            }
+            [self startPendingTasks];
+            dispatch_group_leave(completionGroup);
+        });
+    }];
+}
+/**
+ *  Handle a failed request: wait for the connection, retry it
+ *  or call the failure callback
+ *
+ *  @param task      The task
+ *  @param error     The request error
+ *  @param response  The HTTP response, if there was one
+ *  @param breaker   The circuit breaker of the task endpoint
+ */
+-(void)task:(OlapicNetworkTask *)task didFailWithError:(NSError *)error response:(NSHTTPURLResponse *)response breaker:(OlapicCircuitBreaker *)breaker{
+    if(task.cancelled){
+        // A cancelled request says nothing about the endpoint
+        [breaker recordInconclusive];
+        return;
+    }
+    if([self isConnectionError:error] && networkClass == OlapicNetworkClassOffline){
+        // Wait for the connection to come back
+        [self enqueueTask:task first:YES];
+        return;
+    }
+    NSTimeInterval retryAfter = -1;
+    if(response.statusCode == 429 || response.statusCode == 503){
+        retryAfter = [OlapicRetryPolicy retryAfterForResponse:response];
+    }
+    if(retryAfter >= 0){
+        // The server is there and told us when to come back, that's
+        // a wait and not a reason to open the circuit
+        [breaker recordInconclusive];
+    }else if([self isEndpointFailure:error response:response]){
+        [breaker recordFailure];
+    }else{
+        [breaker recordSuccess];
+    }
+    if(![retryPolicy shouldRetryError:error response:response attempt:task.attempts] || breaker.state == OlapicCircuitStateOpen){
+        if(task.failure) task.failure(error);
+        return;
+    }
+    // A server asking for a long wait shouldn't hold the task longer than
+    // the policy would
+    NSTimeInterval delay = retryAfter >= 0 ? MIN(retryAfter, retryPolicy.maxDelay) : [retryPolicy delayForAttempt:task.attempts response:response];
+    task.attempts++;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        if(task.cancelled) return;
+        [self enqueueTask:task first:YES];
+        [self startPendingTasks];
+    });
+}
+/**
+ *  Check if a failure means the endpoint is in trouble (and
+ *  not just that the request was wrong)
+ *
+ *  @param error    The request error
+ *  @param response The HTTP response, if there was one
+ *
+ *  @return YES if the failure counts for the circuit breaker
+ */
+-(BOOL)isEndpointFailure:(NSError *)error response:(NSHTTPURLResponse *)response{
+    if(response.statusCode >= 400){
+        return response.statusCode == 408 || response.statusCode == 429 || response.statusCode >= 500;
+    }
+    if(![error.domain isEqualToString:NSURLErrorDomain]) return NO;
+    return error.code == NSURLErrorTimedOut || error.code == NSURLErrorCannotConnectToHost || error.code == NSURLErrorCannotFindHost;
+}
+/**
+ *  Add a task to the pending queue, after the tasks with the
+ *  same priority (or before them, if it's a task being retried)
+ *
+ *  @param task  The task to add
+ *  @param first If YES, the task goes before the ones with the same priority
+ */
+-(void)enqueueTask:(OlapicNetworkTask *)task first:(BOOL)first{
+    NSUInteger index = 0;
+    for(; index < [pending count]; index++){
+        OlapicNetworkTask *queued = [pending objectAtIndex:index];
+        if(first ? queued.priority >= task.priority : queued.priority > task.priority){
+            break;
+        }
+    }
+    [pending insertObject:task atIndex:index];
+}
+/**
+ *  Get the endpoint type of a URL, used to group the requests
+ *  that share a circuit breaker. API requests are grouped by
+ *  resource path (without the IDs) and images by host
+ *
+ *  @param URL The URL
+ *
+ *  @return The endpoint type (like 'api/customers/media/recent')
+ */
+-(NSString *)endpointForURL:(NSString *)URL{
+    NSURL *url = [NSURL URLWithString:[self absoluteURL:URL]];
+    if(!url.host){
+        return @"unknown";
+    }
+    if([url.host rangeOfString:@"photorankapi"].location == NSNotFound){
+        return [NSString stringWithFormat:@"images/%@",url.host];
+    }
+    NSMutableArray *components = [[NSMutableArray alloc] initWithObjects:@"api", nil];
+    NSCharacterSet *nonDigits = [[NSCharacterSet decimalDigitCharacterSet] invertedSet];
+    for(NSString *component in [url pathComponents]){
+        if([component isEqualToString:@"/"] || [component rangeOfCharacterFromSet:nonDigits].location == NSNotFound){
+            continue;
+        }
+        [components addObject:component];
+    }
+    return [components componentsJoinedByString:@"/"];
+}
+/**
+ *  Get the circuit breaker for an endpoint type
+ *
+ *  @param endpoint The endpoint type
+ *
+ *  @return The circuit breaker
+ */
+-(OlapicCircuitBreaker *)circuitBreakerForEndpoint:(NSString *)endpoint{
+    OlapicCircuitBreaker *breaker = [breakers objectForKey:endpoint];
+    if(!breaker){
+        breaker = [[OlapicCircuitBreaker alloc] initWithEndpoint:endpoint];
+        [breakers setObject:breaker forKey:endpoint];
+    }
+    return breaker;
+}
+/**
+ *  Remove a cancelled task from the queues. This is called
+ *  by the task itself
+ *
+ *  @param task The cancelled task
+ */
+-(void)taskDidCancel:(OlapicNetworkTask *)task{
+    [pending removeObject:task];
+    if([running containsObject:task]){
+        [running removeObject:task];
+        [self startPendingTasks];
+    }
+}
+/**
+ *  Check if an error was caused by the lack of connection
+ *
+ *  @param error The error
+ *
+ *  @return YES if the request can be retried once the device is back online
+ */
+-(BOOL)isConnectionError:(NSError *)error{
+    if(![error.domain isEqualToString:NSURLErrorDomain]) return NO;
+    return error.code == NSURLErrorNotConnectedToInternet || error.code == NSURLErrorNetworkConnectionLost;
+}
+/**
+ *  Prepare a URL to be used by NSURLRequest (the API uses
+ *  protocol relative URLs)
+ *
+ *  @param URL The URL
+ *
+ *  @return The absolute URL
+ */
+-(NSString *)absoluteURL:(NSString *)URL{
+    if([URL hasPrefix:@"//"]){
+        return [NSString stringWithFormat:@"https:%@",URL];
+    }
+    return URL;
+}
+/**
+ *  Add the auth_token to the parameters of an API request
+ *
+ *  @param parameters The original parameters
+ *  @param URL        The request URL
+ *
+ *  @return The parameters for the request
+ */
+-(NSDictionary *)parameters:(NSDictionary *)parameters forURL:(NSString *)URL{
+    if(!authKey || [URL rangeOfString:@"photorankapi"].location == NSNotFound || [URL rangeOfString:@"auth_token="].location != NSNotFound || [parameters valueForKey:@"auth_token"]){
+        return parameters;
+    }
+    NSMutableDictionary *result = [[NSMutableDictionary alloc] initWithDictionary:parameters];
+    [result setValue:authKey forKey:@"auth_token"];
+    return result;
+}
+/**
+ *  Get the value for the 'Accept-Encoding' header. Brotli is only
+ *  accepted when the system can decode it (iOS 11)
+ *
+ *  @return The header value
+ */
++(NSString *)acceptedEncodings{
+    NSProcessInfo *info = [NSProcessInfo processInfo];
+    NSOperatingSystemVersion iOS11 = {11, 0, 0};
+    if([info respondsToSelector:@selector(isOperatingSystemAtLeastVersion:)] && [info isOperatingSystemAtLeastVersion:iOS11]){
+        return @"br, gzip, deflate";
+    }
+    return @"gzip, deflate";
+}
+/**
+ *  Get the number of bytes a response used on the network
+ *
+ *  @param response     The HTTP response
+ *  @param responseData The (already decompressed) response data
+ *
+ *  @return The compressed size, the data size if the response was not compressed, or -1 if it was compressed without a Content-Length (chunked)
+ */
++(long long)compressedLengthOfResponse:(NSHTTPURLResponse *)response data:(NSData *)responseData{
+    // The header names are case insensitive, and HTTP/2 sends them in lowercase
+    NSString *encoding = nil;
+    NSDictionary *headers = [response allHeaderFields];
+    for(NSString *name in headers){
+        if([name caseInsensitiveCompare:@"Content-Encoding"] == NSOrderedSame){
+            encoding = [[headers objectForKey:name] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+            break;
+        }
+    }
+    if(![encoding length] || [encoding caseInsensitiveCompare:@"identity"] == NSOrderedSame){
+        return [responseData length];
+    }
+    // The Content-Length of a compressed response is the compressed size.
+    // Without it the size on the network is unknown, and the data size
+    // would count it as not compressed at all
+    return response.expectedContentLength > 0 ? response.expectedContentLength : -1;
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,132 @@
+//
+//  OlapicNetworkTask.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+/**
+ *  The different priorities for a request. Lower values
+ *  are started first
+ */
+typedef NS_ENUM(NSInteger, OlapicRequestPriority){
+    /**
+     *  API requests the user is waiting for (like a media page)
+     */
+    OlapicRequestPriorityHigh = 0,
+    /**
+     *  Images that are visible on the screen
+     */
+    OlapicRequestPriorityNormal = 1,
+    /**
+     *  Original size images. On cellular they wait until
+     *  everything else is done
+     */
+    OlapicRequestPriorityOriginal = 2,
+    /**
+     *  Resources that may be needed later. On cellular they
+     *  wait until the device is back on WiFi
+     */
+    OlapicRequestPriorityPrefetch = 3
+};
+/**
+ *  A single request handled by the OlapicNetworkClient. It
+ *  keeps the information needed to start (or restart) the
+ *  request and can be used to cancel it
+ */
+@interface OlapicNetworkTask : NSObject{
+    /**
+     *  The URL to request
+     */
+    NSString *URL;
+    /**
+     *  The parameters for the query string
+     */
+    NSDictionary *parameters;
+    /**
+     *  The task priority
+     */
+    OlapicRequestPriority priority;
+    /**
+     *  An optional block to turn the response data into another object
+     *  (like parsing the JSON). It runs on the client's processingQueue
+     */
+    id (^processing)(NSData *responseData, NSError **error);
+    /**
+     *  The callback for when the request is successfully done, with the
+     *  response data or the object returned by the processing block
+     */
+    void (^success)(id responseObject);
+    /**
+     *  The callback for when the request fails
+     */
+    void (^failure)(NSError *error);
+    /**
+     *  The underlying operation (an NSOperation or an
+     *  NSURLSessionTask, depending on the transport), while
+     *  the task is running
+     */
+    id operation;
+    /**
+     *  A flag to know if the task was cancelled
+     */
+    BOOL cancelled;
+    /**
+     *  How many times the request was retried
+     */
+    NSInteger attempts;
+}
+
+@property (nonatomic,strong) NSString *URL;
+@property (nonatomic,strong) NSDictionary *parameters;
+@property (nonatomic) OlapicRequestPriority priority;
+@property (nonatomic,copy) id (^processing)(NSData *responseData, NSError **error);
+@property (nonatomic,copy) void (^success)(id responseObject);
+@property (nonatomic,copy) void (^failure)(NSError *error);
+@property (nonatomic,strong) id operation;
+// Atomic, the network client checks it on the processing queue
+@property (atomic,readonly) BOOL cancelled;
+@property (nonatomic) NSInteger attempts;
+/**
+ *  Class constructor
+ *
+ *  @param url   The URL to request
+ *  @param param The parameters for the query string
+ *  @param prio  The task priority
+ *
+ *  @return An instance of this object (OlapicNetworkTask)
+ */
+-(id)initWithURL:(NSString *)url parameters:(NSDictionary *)param priority:(OlapicRequestPriority)prio;
+/**
+ *  Cancel the task. If it's running, the operation is cancelled,
+ *  and none of the callbacks will be called
+ */
+-(void)cancel;
+
+@end
\ No newline at end of file
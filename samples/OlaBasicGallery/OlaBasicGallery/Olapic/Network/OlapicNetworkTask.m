@@ -0,0 +1,72 @@
+//
+//  OlapicNetworkTask.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicNetworkTask.h"
+#import "OlapicNetworkClient.h"
+
+@implementation OlapicNetworkTask
+@synthesize URL,parameters,priority,processing,success,failure,operation,cancelled,attempts;
+/**
+ *  Class constructor
+ *
+ *  @param url   The URL to request
+ *  @param param The parameters for the query string
+ *  @param prio  The task priority
+ *
+ *  @return An instance of this object (OlapicNetworkTask)
+ */
+-(id)initWithURL:(NSString *)url parameters:(NSDictionary *)param priority:(OlapicRequestPriority)prio{
+    self = [super init];
+    if(self){
+        URL = url;
+        parameters = param;
+        priority = prio;
+        cancelled = NO;
+        attempts = 0;
+    }
+    return self;
+}
+/**
+ *  Cancel the task. If it's running, the operation is cancelled,
+ *  and none of the callbacks will be called
+ */
+-(void)cancel{
+    if(cancelled) return;
+    cancelled = YES;
+    processing = nil;
+    success = nil;
+    failure = nil;
+    [operation cancel];
+    [[OlapicNetworkClient sharedClient] taskDidCancel:self];
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,67 @@
+//
+//  OlapicNetworkTransport.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "OlapicTransportMetrics.h"
+/**
+ *  The object the OlapicNetworkClient uses to actually send the
+ *  requests, so the client policies (priorities, retries, circuit
+ *  breakers) don't depend on how the bytes travel
+ */
+@protocol OlapicNetworkTransport <NSObject>
+/**
+ *  The queue where the completion blocks are called. If it's NULL,
+ *  the main queue is used
+ */
+@property (nonatomic,strong) dispatch_queue_t completionQueue;
+/**
+ *  A group the completion blocks are associated with. If it's NULL,
+ *  a private group is used
+ */
+@property (nonatomic,strong) dispatch_group_t completionGroup;
+/**
+ *  Send a request
+ *
+ *  @param request    The request
+ *  @param completion A callback block, called on the completionQueue, with the response data, the HTTP response and an error if the request failed
+ *
+ *  @return An object that responds to 'cancel' (an NSOperation or an NSURLSessionTask)
+ */
+-(id)startRequest:(NSURLRequest *)request onCompletion:(void (^)(NSData *responseData, NSHTTPURLResponse *response, NSError *error))completion;
+/**
+ *  Get the transport metrics
+ *
+ *  @return The metrics
+ */
+-(OlapicTransportMetrics *)metrics;
+
+@end
\ No newline at end of file
@@ -0,0 +1,54 @@
+//
+//  OlapicOperationTransport.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "OlapicNetworkTransport.h"
+/**
+ *  A transport that uses NSURLConnection based operations, like the
+ *  SDK's OlapicRestClient does. Each running request takes its own
+ *  connection slot
+ */
+@interface OlapicOperationTransport : NSObject <OlapicNetworkTransport>{
+    /**
+     *  The queue where the completion blocks are called
+     */
+    dispatch_queue_t completionQueue;
+    /**
+     *  The group the completion blocks are associated with
+     */
+    dispatch_group_t completionGroup;
+}
+
+@property (nonatomic,strong) dispatch_queue_t completionQueue;
+@property (nonatomic,strong) dispatch_group_t completionGroup;
+
+@end
\ No newline at end of file
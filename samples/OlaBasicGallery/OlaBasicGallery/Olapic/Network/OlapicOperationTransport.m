@@ -0,0 +1,96 @@
+//
+//  OlapicOperationTransport.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicOperationTransport.h"
+#import "OlapicAFHTTPRequestOperationManager.h"
+
+@interface OlapicOperationTransport(){
+    /**
+     *  The AFNetworking manager used to create the operations
+     */
+    OlapicAFHTTPRequestOperationManager *manager;
+    /**
+     *  The transport metrics
+     */
+    OlapicTransportMetrics *metrics;
+}
+
+@end
+
+@implementation OlapicOperationTransport
+@synthesize completionQueue,completionGroup;
+/**
+ *  Class constructor
+ *
+ *  @return An instance of this object (OlapicOperationTransport)
+ */
+-(id)init{
+    self = [super init];
+    if(self){
+        manager = [[OlapicAFHTTPRequestOperationManager alloc] initWithBaseURL:nil];
+        manager.responseSerializer = [OlapicAFHTTPResponseSerializer serializer];
+        metrics = [[OlapicTransportMetrics alloc] init];
+    }
+    return self;
+}
+/**
+ *  Send a request
+ *
+ *  @param request    The request
+ *  @param completion A callback block, called on the completionQueue, with the response data, the HTTP response and an error if the request failed
+ *
+ *  @return The operation
+ */
+-(id)startRequest:(NSURLRequest *)request onCompletion:(void (^)(NSData *responseData, NSHTTPURLResponse *response, NSError *error))completion{
+    OlapicAFHTTPRequestOperation *operation = [manager HTTPRequestOperationWithRequest:request success:^(OlapicAFHTTPRequestOperation *op, id responseObject){
+        [metrics addRequestWithBytes:[op.responseData length]];
+        if(completion) completion(responseObject, op.response, nil);
+    } failure:^(OlapicAFHTTPRequestOperation *op, NSError *error){
+        [metrics addRequestWithBytes:[op.responseData length]];
+        if(completion) completion(op.responseData, op.response, error);
+    }];
+    operation.completionQueue = completionQueue;
+    operation.completionGroup = completionGroup;
+    [manager.operationQueue addOperation:operation];
+    return operation;
+}
+/**
+ *  Get the transport metrics. NSURLConnection doesn't say anything
+ *  about the connections, so only the requests and bytes are counted
+ *
+ *  @return The metrics
+ */
+-(OlapicTransportMetrics *)metrics{
+    return metrics;
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,84 @@
+//
+//  OlapicPayloadDecoder.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+/**
+ *  The MIME type of the compact (MessagePack) payloads
+ */
+extern NSString * const OlapicCompactPayloadMIMEType;
+/**
+ *  Reads the API responses, either JSON or the compact MessagePack
+ *  format the API can send instead when the request asks for it. Both
+ *  formats produce the same Foundation objects, so the rest of the
+ *  sample doesn't need to know which one was used.
+ *
+ *  The format is detected from the first byte: a JSON response is an
+ *  object (or whitespace), while a MessagePack response starts with a
+ *  map marker.
+ */
+@interface OlapicPayloadDecoder : NSObject
+/**
+ *  Read a response
+ *
+ *  @param data  The response data
+ *  @param error A reference to save the error, if the data can't be read
+ *
+ *  @return The response object
+ */
++(id)objectWithData:(NSData *)data error:(NSError **)error;
+/**
+ *  Check if a response uses the compact format
+ *
+ *  @param data The response data
+ *
+ *  @return YES if it's MessagePack
+ */
++(BOOL)isCompactPayload:(NSData *)data;
+/**
+ *  Read a MessagePack payload
+ *
+ *  @param data  The payload
+ *  @param error A reference to save the error, if the data is not valid
+ *
+ *  @return The payload object
+ */
++(id)objectWithMessagePackData:(NSData *)data error:(NSError **)error;
+/**
+ *  Get the value for the 'Accept' header
+ *
+ *  @param compact If the compact format is accepted
+ *
+ *  @return The header value
+ */
++(NSString *)acceptHeaderAllowingCompactPayloads:(BOOL)compact;
+
+@end
\ No newline at end of file
@@ -0,0 +1,307 @@
+//
+//  OlapicPayloadDecoder.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicPayloadDecoder.h"
+#import "OlapicCircuitBreaker.h"
+
+NSString * const OlapicCompactPayloadMIMEType = @"application/x-msgpack";
+/**
+ *  How deep the MessagePack containers can be nested
+ */
+static NSUInteger const OlapicPayloadDecoderMaxDepth = 64;
+/**
+ *  The state of a MessagePack read
+ */
+typedef struct {
+    const uint8_t *bytes;
+    NSUInteger length;
+    NSUInteger offset;
+} OlapicMessagePackReader;
+/**
+ *  Read a big endian unsigned integer
+ *
+ *  @param reader The reader
+ *  @param size   The number of bytes (1, 2, 4 or 8)
+ *  @param value  A reference to save the value
+ *
+ *  @return NO if there are not enough bytes
+ */
+static BOOL OlapicMessagePackReadUInt(OlapicMessagePackReader *reader, NSUInteger size, uint64_t *value){
+    if(reader->length - reader->offset < size) return NO;
+    uint64_t result = 0;
+    for(NSUInteger i = 0; i < size; i++){
+        result = (result << 8) | reader->bytes[reader->offset + i];
+    }
+    reader->offset += size;
+    *value = result;
+    return YES;
+}
+
+@interface OlapicPayloadDecoder()
+/**
+ *  Read a MessagePack value
+ *
+ *  @param reader The reader
+ *  @param depth  How deep the value is
+ *
+ *  @return The value, or nil if the data is not valid
+ */
++(id)readValue:(OlapicMessagePackReader *)reader depth:(NSUInteger)depth;
+/**
+ *  Read the items of a MessagePack array
+ *
+ *  @param reader The reader
+ *  @param count  The number of items
+ *  @param depth  How deep the array is
+ *
+ *  @return The array, or nil if the data is not valid
+ */
++(NSArray *)readArray:(OlapicMessagePackReader *)reader count:(uint64_t)count depth:(NSUInteger)depth;
+/**
+ *  Read the entries of a MessagePack map
+ *
+ *  @param reader The reader
+ *  @param count  The number of entries
+ *  @param depth  How deep the map is
+ *
+ *  @return The dictionary, or nil if the data is not valid
+ */
++(NSDictionary *)readMap:(OlapicMessagePackReader *)reader count:(uint64_t)count depth:(NSUInteger)depth;
+/**
+ *  Read a MessagePack string or binary value
+ *
+ *  @param reader The reader
+ *  @param length The number of bytes
+ *  @param string If it's a string (or binary data)
+ *
+ *  @return The string or data, or nil if the data is not valid
+ */
++(id)readBytes:(OlapicMessagePackReader *)reader length:(uint64_t)length asString:(BOOL)string;
+
+@end
+
+@implementation OlapicPayloadDecoder
+/**
+ *  Read a response
+ *
+ *  @param data  The response data
+ *  @param error A reference to save the error, if the data can't be read
+ *
+ *  @return The response object
+ */
++(id)objectWithData:(NSData *)data error:(NSError **)error{
+    if([self isCompactPayload:data]){
+        return [self objectWithMessagePackData:data error:error];
+    }
+    return [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+}
+/**
+ *  Check if a response uses the compact format
+ *
+ *  @param data The response data
+ *
+ *  @return YES if it's MessagePack
+ */
++(BOOL)isCompactPayload:(NSData *)data{
+    if(![data length]) return NO;
+    uint8_t first = ((const uint8_t *)[data bytes])[0];
+    // fixmap, map16 or map32
+    return (first & 0xf0) == 0x80 || first == 0xde || first == 0xdf;
+}
+/**
+ *  Read a MessagePack payload
+ *
+ *  @param data  The payload
+ *  @param error A reference to save the error, if the data is not valid
+ *
+ *  @return The payload object
+ */
++(id)objectWithMessagePackData:(NSData *)data error:(NSError **)error{
+    OlapicMessagePackReader reader = {[data bytes], [data length], 0};
+    id object = [self readValue:&reader depth:0];
+    if(!object || reader.offset != reader.length){
+        if(error){
+            *error = [NSError errorWithDomain:OlapicNetworkErrorDomain code:OlapicNetworkErrorInvalidResponse userInfo:@{NSLocalizedDescriptionKey: @"The compact payload is not valid"}];
+        }
+        return nil;
+    }
+    return object;
+}
+/**
+ *  Get the value for the 'Accept' header
+ *
+ *  @param compact If the compact format is accepted
+ *
+ *  @return The header value
+ */
++(NSString *)acceptHeaderAllowingCompactPayloads:(BOOL)compact{
+    if(!compact) return @"application/json";
+    return [NSString stringWithFormat:@"%@, application/json;q=0.9",OlapicCompactPayloadMIMEType];
+}
+/**
+ *  Read a MessagePack value
+ *
+ *  @param reader The reader
+ *  @param depth  How deep the value is
+ *
+ *  @return The value, or nil if the data is not valid
+ */
++(id)readValue:(OlapicMessagePackReader *)reader depth:(NSUInteger)depth{
+    if(depth > OlapicPayloadDecoderMaxDepth) return nil;
+    uint64_t type = 0, value = 0;
+    if(!OlapicMessagePackReadUInt(reader, 1, &type)) return nil;
+    if(type <= 0x7f) return [NSNumber numberWithUnsignedChar:(uint8_t)type];
+    if(type >= 0xe0) return [NSNumber numberWithChar:(int8_t)type];
+    if((type & 0xf0) == 0x80) return [self readMap:reader count:(type & 0x0f) depth:depth + 1];
+    if((type & 0xf0) == 0x90) return [self readArray:reader count:(type & 0x0f) depth:depth + 1];
+    if((type & 0xe0) == 0xa0) return [self readBytes:reader length:(type & 0x1f) asString:YES];
+    switch(type){
+        case 0xc0:
+            return [NSNull null];
+        case 0xc2:
+            return [NSNumber numberWithBool:NO];
+        case 0xc3:
+            return [NSNumber numberWithBool:YES];
+        case 0xc4: case 0xc5: case 0xc6:
+            if(!OlapicMessagePackReadUInt(reader, 1 << (type - 0xc4), &value)) return nil;
+            return [self readBytes:reader length:value asString:NO];
+        case 0xca:{
+            if(!OlapicMessagePackReadUInt(reader, 4, &value)) return nil;
+            uint32_t bits = (uint32_t)value;
+            float number;
+            memcpy(&number, &bits, 4);
+            return [NSNumber numberWithFloat:number];
+        }
+        case 0xcb:{
+            if(!OlapicMessagePackReadUInt(reader, 8, &value)) return nil;
+            double number;
+            memcpy(&number, &value, 8);
+            return [NSNumber numberWithDouble:number];
+        }
+        case 0xcc: case 0xcd: case 0xce: case 0xcf:
+            if(!OlapicMessagePackReadUInt(reader, 1 << (type - 0xcc), &value)) return nil;
+            return [NSNumber numberWithUnsignedLongLong:value];
+        case 0xd0:
+            if(!OlapicMessagePackReadUInt(reader, 1, &value)) return nil;
+            return [NSNumber numberWithChar:(int8_t)value];
+        case 0xd1:
+            if(!OlapicMessagePackReadUInt(reader, 2, &value)) return nil;
+            return [NSNumber numberWithShort:(int16_t)value];
+        case 0xd2:
+            if(!OlapicMessagePackReadUInt(reader, 4, &value)) return nil;
+            return [NSNumber numberWithInt:(int32_t)value];
+        case 0xd3:
+            if(!OlapicMessagePackReadUInt(reader, 8, &value)) return nil;
+            return [NSNumber numberWithLongLong:(int64_t)value];
+        case 0xd9: case 0xda: case 0xdb:
+            if(!OlapicMessagePackReadUInt(reader, 1 << (type - 0xd9), &value)) return nil;
+            return [self readBytes:reader length:value asString:YES];
+        case 0xdc: case 0xdd:
+            if(!OlapicMessagePackReadUInt(reader, type == 0xdc ? 2 : 4, &value)) return nil;
+            return [self readArray:reader count:value depth:depth + 1];
+        case 0xde: case 0xdf:
+            if(!OlapicMessagePackReadUInt(reader, type == 0xde ? 2 : 4, &value)) return nil;
+            return [self readMap:reader count:value depth:depth + 1];
+        case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8:
+            // Fixed size extensions (type byte + data), not used by the API
+            value = 1 << (type - 0xd4);
+            if(reader->length - reader->offset < value + 1) return nil;
+            reader->offset += value + 1;
+            return [NSNull null];
+        case 0xc7: case 0xc8: case 0xc9:
+            if(!OlapicMessagePackReadUInt(reader, 1 << (type - 0xc7), &value)) return nil;
+            if(reader->length - reader->offset < value + 1) return nil;
+            reader->offset += value + 1;
+            return [NSNull null];
+        default:
+            return nil;
+    }
+}
+/**
+ *  Read the items of a MessagePack array
+ *
+ *  @param reader The reader
+ *  @param count  The number of items
+ *  @param depth  How deep the array is
+ *
+ *  @return The array, or nil if the data is not valid
+ */
++(NSArray *)readArray:(OlapicMessagePackReader *)reader count:(uint64_t)count depth:(NSUInteger)depth{
+    // Every item takes at least one byte
+    if(count > reader->length - reader->offset) return nil;
+    NSMutableArray *items = [[NSMutableArray alloc] initWithCapacity:(NSUInteger)count];
+    for(uint64_t i = 0; i < count; i++){
+        id item = [self readValue:reader depth:depth];
+        if(!item) return nil;
+        [items addObject:item];
+    }
+    return items;
+}
+/**
+ *  Read the entries of a MessagePack map
+ *
+ *  @param reader The reader
+ *  @param count  The number of entries
+ *  @param depth  How deep the map is
+ *
+ *  @return The dictionary, or nil if the data is not valid
+ */
++(NSDictionary *)readMap:(OlapicMessagePackReader *)reader count:(uint64_t)count depth:(NSUInteger)depth{
+    if(count > (reader->length - reader->offset) / 2) return nil;
+    NSMutableDictionary *map = [[NSMutableDictionary alloc] initWithCapacity:(NSUInteger)count];
+    for(uint64_t i = 0; i < count; i++){
+        id key = [self readValue:reader depth:depth];
+        id value = key ? [self readValue:reader depth:depth] : nil;
+        if(!value) return nil;
+        // Like JSON, the keys are always strings
+        [map setObject:value forKey:[key isKindOfClass:[NSString class]] ? key : [key description]];
+    }
+    return map;
+}
+/**
+ *  Read a MessagePack string or binary value
+ *
+ *  @param reader The reader
+ *  @param length The number of bytes
+ *  @param string If it's a string (or binary data)
+ *
+ *  @return The string or data, or nil if the data is not valid
+ */
++(id)readBytes:(OlapicMessagePackReader *)reader length:(uint64_t)length asString:(BOOL)string{
+    if(length > reader->length - reader->offset) return nil;
+    const uint8_t *start = reader->bytes + reader->offset;
+    reader->offset += (NSUInteger)length;
+    if(!string) return [NSData dataWithBytes:start length:(NSUInteger)length];
+    return [[NSString alloc] initWithBytes:start length:(NSUInteger)length encoding:NSUTF8StringEncoding];
+}
+
+@end
\ No newline at end of file
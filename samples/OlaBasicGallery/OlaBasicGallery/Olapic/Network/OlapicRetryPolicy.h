@@ -0,0 +1,105 @@
+//
+//  OlapicRetryPolicy.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+/**
+ *  Decides if a failed GET request should be retried, and how long
+ *  to wait before doing it. The delay grows exponentially with each
+ *  attempt and gets a random jitter, so the clients that failed at
+ *  the same time don't retry at the same time. If the server sends
+ *  a 'Retry-After' header, that delay is used instead.
+ */
+@interface OlapicRetryPolicy : NSObject{
+    /**
+     *  How many times a request can be retried
+     */
+    NSInteger maxRetries;
+    /**
+     *  The delay before the first retry, in seconds
+     */
+    NSTimeInterval baseDelay;
+    /**
+     *  The maximum delay between retries, in seconds
+     */
+    NSTimeInterval maxDelay;
+    /**
+     *  The random part of the delay, from 0 (none) to 1 (full jitter)
+     */
+    double jitter;
+    /**
+     *  The HTTP status codes that can be retried
+     */
+    NSIndexSet *retryableStatusCodes;
+}
+
+@property (nonatomic) NSInteger maxRetries;
+@property (nonatomic) NSTimeInterval baseDelay;
+@property (nonatomic) NSTimeInterval maxDelay;
+@property (nonatomic) double jitter;
+@property (nonatomic,strong) NSIndexSet *retryableStatusCodes;
+/**
+ *  Get the default policy: 3 retries, starting at half a second,
+ *  up to 30 seconds, retrying 408, 429, 500, 502, 503 and 504
+ *
+ *  @return A new policy
+ */
++(instancetype)defaultPolicy;
+/**
+ *  Check if a failed request can be retried
+ *
+ *  @param error    The request error
+ *  @param response The HTTP response, if there was one
+ *  @param attempt  How many times the request was already retried
+ *
+ *  @return YES if the request should be retried
+ */
+-(BOOL)shouldRetryError:(NSError *)error response:(NSHTTPURLResponse *)response attempt:(NSInteger)attempt;
+/**
+ *  Get the delay before retrying a request
+ *
+ *  @param attempt  How many times the request was already retried
+ *  @param response The HTTP response, if there was one
+ *
+ *  @return The delay in seconds
+ */
+-(NSTimeInterval)delayForAttempt:(NSInteger)attempt response:(NSHTTPURLResponse *)response;
+/**
+ *  Read the 'Retry-After' header of a response. It can be a
+ *  number of seconds or an HTTP date
+ *
+ *  @param response The HTTP response
+ *
+ *  @return The delay in seconds, or a negative number if there's no header
+ */
++(NSTimeInterval)retryAfterForResponse:(NSHTTPURLResponse *)response;
+
+@end
\ No newline at end of file
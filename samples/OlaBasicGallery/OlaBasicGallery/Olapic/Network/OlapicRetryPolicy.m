@@ -0,0 +1,147 @@
+//
+//  OlapicRetryPolicy.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicRetryPolicy.h"
+
+@implementation OlapicRetryPolicy
+@synthesize maxRetries,baseDelay,maxDelay,jitter,retryableStatusCodes;
+/**
+ *  Get the default policy: 3 retries, starting at half a second,
+ *  up to 30 seconds, retrying 408, 429, 500, 502, 503 and 504
+ *
+ *  @return A new policy
+ */
++(instancetype)defaultPolicy{
+    return [[self alloc] init];
+}
+/**
+ *  Class constructor
+ *
+ *  @return An instance of this object (OlapicRetryPolicy)
+ */
+-(id)init{
+    self = [super init];
+    if(self){
+        maxRetries = 3;
+        baseDelay = 0.5;
+        maxDelay = 30;
+        jitter = 0.5;
+        NSMutableIndexSet *codes = [[NSMutableIndexSet alloc] init];
+        [codes addIndex:408];
+        [codes addIndex:429];
+        [codes addIndex:500];
+        [codes addIndexesInRange:NSMakeRange(502, 3)];
+        retryableStatusCodes = codes;
+    }
+    return self;
+}
+/**
+ *  Check if a failed request can be retried
+ *
+ *  @param error    The request error
+ *  @param response The HTTP response, if there was one
+ *  @param attempt  How many times the request was already retried
+ *
+ *  @return YES if the request should be retried
+ */
+-(BOOL)shouldRetryError:(NSError *)error response:(NSHTTPURLResponse *)response attempt:(NSInteger)attempt{
+    if(attempt >= maxRetries){
+        return NO;
+    }
+    if(response && response.statusCode >= 400){
+        return [retryableStatusCodes containsIndex:response.statusCode];
+    }
+    if(![error.domain isEqualToString:NSURLErrorDomain]){
+        return NO;
+    }
+    switch(error.code){
+        case NSURLErrorTimedOut:
+        case NSURLErrorCannotConnectToHost:
+        case NSURLErrorCannotFindHost:
+        case NSURLErrorDNSLookupFailed:
+        case NSURLErrorNetworkConnectionLost:
+            return YES;
+        default:
+            return NO;
+    }
+}
+/**
+ *  Get the delay before retrying a request
+ *
+ *  @param attempt  How many times the request was already retried
+ *  @param response The HTTP response, if there was one
+ *
+ *  @return The delay in seconds
+ */
+-(NSTimeInterval)delayForAttempt:(NSInteger)attempt response:(NSHTTPURLResponse *)response{
+    NSTimeInterval retryAfter = [OlapicRetryPolicy retryAfterForResponse:response];
+    if(retryAfter >= 0){
+        return MIN(retryAfter, maxDelay);
+    }
+    NSTimeInterval delay = MIN(baseDelay * pow(2, attempt), maxDelay);
+    double random = (double)arc4random_uniform(1000) / 1000.0;
+    return delay * (1 - jitter) + delay * jitter * random;
+}
+/**
+ *  Read the 'Retry-After' header of a response. It can be a
+ *  number of seconds or an HTTP date
+ *
+ *  @param response The HTTP response
+ *
+ *  @return The delay in seconds, or a negative number if there's no header
+ */
++(NSTimeInterval)retryAfterForResponse:(NSHTTPURLResponse *)response{
+    NSString *value = [[response allHeaderFields] valueForKey:@"Retry-After"];
+    if(![value length]){
+        return -1;
+    }
+    NSScanner *scanner = [NSScanner scannerWithString:value];
+    double seconds;
+    if([scanner scanDouble:&seconds] && [scanner isAtEnd]){
+        return MAX(seconds, 0);
+    }
+    static NSDateFormatter *formatter = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        formatter = [[NSDateFormatter alloc] init];
+        formatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+        formatter.timeZone = [NSTimeZone timeZoneWithAbbreviation:@"GMT"];
+        formatter.dateFormat = @"EEE',' dd MMM yyyy HH':'mm':'ss 'GMT'";
+    });
+    NSDate *date = [formatter dateFromString:value];
+    if(!date){
+        return -1;
+    }
+    return MAX([date timeIntervalSinceNow], 0);
+}
+
+@end
\ No newline at end of file
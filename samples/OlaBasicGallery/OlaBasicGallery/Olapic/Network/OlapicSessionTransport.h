@@ -0,0 +1,62 @@
+//
+//  OlapicSessionTransport.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "OlapicAFHTTPSessionManager.h"
+#import "OlapicNetworkTransport.h"
+/**
+ *  A transport that uses a single NSURLSession for every request.
+ *  The session keeps the connections alive and, when the server
+ *  supports it, multiplexes the requests over a shared HTTP/2
+ *  connection, so a burst of thumbnails doesn't wait for free
+ *  connection slots. HTTP/1.1 pipelining is left off: it blocks every
+ *  request behind the slowest one and many proxies break it. When the
+ *  system provides task metrics (iOS 10), the connection reuse and the
+ *  protocols are counted in the metrics; before that, only the
+ *  requests and their bytes are counted
+ */
+@interface OlapicSessionTransport : OlapicAFHTTPSessionManager <OlapicNetworkTransport>{
+    /**
+     *  The transport metrics
+     */
+    OlapicTransportMetrics *metrics;
+}
+/**
+ *  Class constructor
+ *
+ *  @param maxConnections The maximum number of connections per host (only used by HTTP/1.1 hosts)
+ *
+ *  @return An instance of this object (OlapicSessionTransport)
+ */
+-(id)initWithMaximumConnectionsPerHost:(NSInteger)maxConnections;
+
+@end
\ No newline at end of file
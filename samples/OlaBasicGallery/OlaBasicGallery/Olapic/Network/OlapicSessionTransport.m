@@ -0,0 +1,109 @@
+//
+//  OlapicSessionTransport.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicSessionTransport.h"
+
+@implementation OlapicSessionTransport
+/**
+ *  Class constructor
+ *
+ *  @return An instance of this object (OlapicSessionTransport)
+ */
+-(id)init{
+    return [self initWithMaximumConnectionsPerHost:4];
+}
+/**
+ *  Class constructor
+ *
+ *  @param maxConnections The maximum number of connections per host (only used by HTTP/1.1 hosts)
+ *
+ *  @return An instance of this object (OlapicSessionTransport)
+ */
+-(id)initWithMaximumConnectionsPerHost:(NSInteger)maxConnections{
+    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+    configuration.HTTPMaximumConnectionsPerHost = maxConnections;
+    self = [super initWithBaseURL:nil sessionConfiguration:configuration];
+    if(self){
+        self.responseSerializer = [OlapicAFHTTPResponseSerializer serializer];
+        metrics = [[OlapicTransportMetrics alloc] init];
+    }
+    return self;
+}
+/**
+ *  Send a request
+ *
+ *  @param request    The request
+ *  @param completion A callback block, called on the completionQueue, with the response data, the HTTP response and an error if the request failed
+ *
+ *  @return The session task
+ */
+-(id)startRequest:(NSURLRequest *)request onCompletion:(void (^)(NSData *responseData, NSHTTPURLResponse *response, NSError *error))completion{
+    // Before iOS 10 the session doesn't report task metrics, so only the
+    // request and its bytes are counted, without the connection details
+    BOOL countsHere = NSClassFromString(@"NSURLSessionTaskMetrics") == nil;
+    __block __weak NSURLSessionDataTask *weakTask = nil;
+    NSURLSessionDataTask *task = [self dataTaskWithRequest:request completionHandler:^(NSURLResponse *response, id responseObject, NSError *error){
+        if(countsHere) [metrics addRequestWithBytes:weakTask.countOfBytesReceived];
+        NSHTTPURLResponse *HTTPResponse = [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+        if(completion) completion(responseObject, HTTPResponse, error);
+    }];
+    weakTask = task;
+    [task resume];
+    return task;
+}
+/**
+ *  Get the transport metrics
+ *
+ *  @return The metrics
+ */
+-(OlapicTransportMetrics *)metrics{
+    return metrics;
+}
+#pragma mark - NSURLSessionTaskDelegate
+/**
+ *  Called by the session (on iOS 10 or newer) with the timing and
+ *  connection information of a finished task. Older systems never
+ *  call it, and startRequest:onCompletion: counts the request instead
+ *
+ *  @param session     The session
+ *  @param task        The finished task
+ *  @param taskMetrics The task metrics (an NSURLSessionTaskMetrics)
+ */
+-(void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(id)taskMetrics{
+    // Each redirect has its own transaction, the last one is the response we got
+    id transaction = [[taskMetrics valueForKey:@"transactionMetrics"] lastObject];
+    BOOL reused = [[transaction valueForKey:@"reusedConnection"] boolValue];
+    NSString *protocol = [transaction valueForKey:@"networkProtocolName"];
+    [metrics addRequestWithBytes:task.countOfBytesReceived reusedConnection:reused protocol:protocol];
+}
+
+@end
\ No newline at end of file
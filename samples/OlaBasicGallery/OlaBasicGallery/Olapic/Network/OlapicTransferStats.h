@@ -0,0 +1,105 @@
+//
+//  OlapicTransferStats.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+/**
+ *  How many bytes each endpoint type sent over the network (compressed)
+ *  and after the transport decompressed them, to see how much the
+ *  compression saves. The counters can be updated from any thread
+ */
+@interface OlapicTransferStats : NSObject{
+    /**
+     *  The compressed bytes, by endpoint type
+     */
+    NSMutableDictionary *compressedBytes;
+    /**
+     *  The uncompressed bytes, by endpoint type
+     */
+    NSMutableDictionary *uncompressedBytes;
+    /**
+     *  The number of responses, by endpoint type
+     */
+    NSCountedSet *responses;
+}
+/**
+ *  Register a response. If its size on the network is unknown, it's
+ *  counted but its bytes are not, so they don't change the ratio
+ *
+ *  @param endpoint     The endpoint type
+ *  @param compressed   The bytes received over the network, or a negative number if it's unknown
+ *  @param uncompressed The bytes after the decompression
+ */
+-(void)addResponseForEndpoint:(NSString *)endpoint compressedBytes:(long long)compressed uncompressedBytes:(long long)uncompressed;
+/**
+ *  Get the endpoint types with responses
+ *
+ *  @return An array of strings
+ */
+-(NSArray *)endpoints;
+/**
+ *  Get the bytes an endpoint type received over the network
+ *
+ *  @param endpoint The endpoint type
+ *
+ *  @return The number of bytes
+ */
+-(long long)compressedBytesForEndpoint:(NSString *)endpoint;
+/**
+ *  Get the bytes an endpoint type received, after the decompression
+ *
+ *  @param endpoint The endpoint type
+ *
+ *  @return The number of bytes
+ */
+-(long long)uncompressedBytesForEndpoint:(NSString *)endpoint;
+/**
+ *  Get the number of responses of an endpoint type
+ *
+ *  @param endpoint The endpoint type
+ *
+ *  @return The number of responses
+ */
+-(NSUInteger)responsesForEndpoint:(NSString *)endpoint;
+/**
+ *  Get the compressed size as a fraction of the uncompressed size
+ *
+ *  @param endpoint The endpoint type
+ *
+ *  @return A number between 0 and 1 (1 if there's nothing compressed)
+ */
+-(double)compressionRatioForEndpoint:(NSString *)endpoint;
+/**
+ *  Reset all the counters
+ */
+-(void)reset;
+
+@end
\ No newline at end of file
@@ -0,0 +1,101 @@
+//
+//  OlapicTransportMetrics.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+/**
+ *  Counters about how a transport is using the network: how many
+ *  requests were sent, how many needed a new connection and which
+ *  protocols were used. The counters can be updated from any thread
+ */
+@interface OlapicTransportMetrics : NSObject{
+    /**
+     *  How many requests were finished
+     */
+    NSUInteger requests;
+    /**
+     *  How many requests used an already open connection
+     */
+    NSUInteger reusedConnections;
+    /**
+     *  How many requests had to open a new connection
+     */
+    NSUInteger newConnections;
+    /**
+     *  How many bytes were received
+     */
+    long long receivedBytes;
+    /**
+     *  The network protocols used ('http/1.1', 'h2', ...) with
+     *  the number of requests for each one
+     */
+    NSCountedSet *protocols;
+}
+
+@property (nonatomic,readonly) NSUInteger requests;
+@property (nonatomic,readonly) NSUInteger reusedConnections;
+@property (nonatomic,readonly) NSUInteger newConnections;
+@property (nonatomic,readonly) long long receivedBytes;
+/**
+ *  Register a finished request
+ *
+ *  @param bytes    The number of bytes received
+ *  @param reused   If the request used an already open connection
+ *  @param protocol The network protocol, or nil if it's unknown
+ */
+-(void)addRequestWithBytes:(long long)bytes reusedConnection:(BOOL)reused protocol:(NSString *)protocol;
+/**
+ *  Register a finished request for a transport that doesn't know
+ *  about the connections
+ *
+ *  @param bytes The number of bytes received
+ */
+-(void)addRequestWithBytes:(long long)bytes;
+/**
+ *  Get the number of requests sent using a protocol
+ *
+ *  @param protocol The network protocol ('http/1.1', 'h2', ...)
+ *
+ *  @return The number of requests
+ */
+-(NSUInteger)requestsUsingProtocol:(NSString *)protocol;
+/**
+ *  Get the fraction of the requests that used an already open connection
+ *
+ *  @return A number between 0 and 1
+ */
+-(double)connectionReuseRatio;
+/**
+ *  Reset all the counters
+ */
+-(void)reset;
+
+@end
\ No newline at end of file
@@ -0,0 +1,130 @@
+//
+//  OlapicTransportMetrics.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicTransportMetrics.h"
+
+@implementation OlapicTransportMetrics
+@synthesize requests,reusedConnections,newConnections,receivedBytes;
+/**
+ *  Class constructor
+ *
+ *  @return An instance of this object (OlapicTransportMetrics)
+ */
+-(id)init{
+    self = [super init];
+    if(self){
+        protocols = [[NSCountedSet alloc] init];
+    }
+    return self;
+}
+/**
+ *  Register a finished request
+ *
+ *  @param bytes    The number of bytes received
+ *  @param reused   If the request used an already open connection
+ *  @param protocol The network protocol, or nil if it's unknown
+ */
+-(void)addRequestWithBytes:(long long)bytes reusedConnection:(BOOL)reused protocol:(NSString *)protocol{
+    @synchronized(self){
+        requests++;
+        receivedBytes += bytes;
+        if(reused){
+            reusedConnections++;
+        }else{
+            newConnections++;
+        }
+        if(protocol) [protocols addObject:protocol];
+    }
+}
+/**
+ *  Register a finished request for a transport that doesn't know
+ *  about the connections
+ *
+ *  @param bytes The number of bytes received
+ */
+-(void)addRequestWithBytes:(long long)bytes{
+    @synchronized(self){
+        requests++;
+        receivedBytes += bytes;
+    }
+}
+/**
+ *  Get the number of requests sent using a protocol
+ *
+ *  @param protocol The network protocol ('http/1.1', 'h2', ...)
+ *
+ *  @return The number of requests
+ */
+-(NSUInteger)requestsUsingProtocol:(NSString *)protocol{
+    @synchronized(self){
+        return [protocols countForObject:protocol];
+    }
+}
+/**
+ *  Get the fraction of the requests that used an already open connection
+ *
+ *  @return A number between 0 and 1
+ */
+-(double)connectionReuseRatio{
+    @synchronized(self){
+        NSUInteger total = reusedConnections + newConnections;
+        return total ? (double)reusedConnections / total : 0;
+    }
+}
+/**
+ *  Reset all the counters
+ */
+-(void)reset{
+    @synchronized(self){
+        requests = 0;
+        reusedConnections = 0;
+        newConnections = 0;
+        receivedBytes = 0;
+        [protocols removeAllObjects];
+    }
+}
+/**
+ *  Get a description of the counters, for the logs
+ *
+ *  @return The description
+ */
+-(NSString *)description{
+    @synchronized(self){
+        NSMutableArray *list = [[NSMutableArray alloc] init];
+        for(NSString *protocol in protocols){
+            [list addObject:[NSString stringWithFormat:@"%@: %lu", protocol, (unsigned long)[protocols countForObject:protocol]]];
+        }
+        return [NSString stringWithFormat:@"<%@ requests: %lu, reused connections: %lu, new connections: %lu, bytes: %lld, protocols: {%@}>", NSStringFromClass([self class]), (unsigned long)requests, (unsigned long)reusedConnections, (unsigned long)newConnections, receivedBytes, [list componentsJoinedByString:@", "]];
+    }
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,191 @@
+//
+//  OlapicSearchIndex.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+/**
+ *  A local inverted index over the streams and categories (their tag
+ *  keys and names) and the media captions seen during the session, so
+ *  the app can search as the user types without a request per key.
+ *
+ *  The text is split into words, lowercased and without accents. Each
+ *  word points to the entities that have it, and the words are kept
+ *  sorted, so a prefix query is a binary search plus a walk over the
+ *  words that start with it. With several words, an entity must match
+ *  all of them.
+ *
+ *  The entities are added by the list controller (every media page) and
+ *  by the widget bootstrap (its stream or category). The streams and
+ *  categories found on the API by tag key are added too, so the API is
+ *  only used for the index misses.
+ *
+ *  It keeps up to maxDocumentCount entities: when there are more, the
+ *  ones that were added (or updated) the longest ago are removed. A
+ *  memory warning removes all of them.
+ *
+ *  All the methods should be called from the main thread.
+ */
+@interface OlapicSearchIndex : NSObject{
+    /**
+     *  All the words, sorted
+     */
+    NSMutableArray *terms;
+    /**
+     *  The keys of the documents that have each word, by word
+     */
+    NSMutableDictionary *postings;
+    /**
+     *  The indexed entities, by document key ("Type/ID")
+     */
+    NSMutableDictionary *documents;
+    /**
+     *  The words of each document, by document key, to remove them
+     *  when the document changes
+     */
+    NSMutableDictionary *documentTerms;
+    /**
+     *  The document keys of the streams and categories, by "Type/tag key"
+     */
+    NSMutableDictionary *tagKeys;
+    /**
+     *  The document keys, from the least to the most recently added
+     */
+    NSMutableOrderedSet *recentDocuments;
+    /**
+     *  How many entities the index keeps
+     */
+    NSUInteger maxDocumentCount;
+}
+
+@property (nonatomic) NSUInteger maxDocumentCount;
+/**
+ *  Get the shared instance
+ *
+ *  @return The shared instance
+ */
++(OlapicSearchIndex *)sharedIndex;
+/**
+ *  Index entities (media, streams or categories; the rest are ignored).
+ *  An entity that was already indexed is indexed again with its
+ *  current data
+ *
+ *  @param entities An array of OlapicEntity objects
+ */
+-(void)addEntities:(NSArray *)entities;
+/**
+ *  Remove everything from the index
+ */
+-(void)removeAllEntities;
+/**
+ *  Get the number of different words in the index
+ *
+ *  @return The number of words
+ */
+-(NSUInteger)termCount;
+/**
+ *  Find the entities with words that start with the words of a query
+ *
+ *  @param query The text the user typed
+ *  @param type  Only the entities of this class (Nil for all of them)
+ *  @param limit The maximum number of results (0 for no limit)
+ *
+ *  @return An array of OlapicEntity objects, the ones with a tag key or
+ *  name that starts with the whole query first
+ */
+-(NSArray *)entitiesMatchingPrefix:(NSString *)query ofType:(Class)type limit:(NSUInteger)limit;
+/**
+ *  Get an indexed stream by its tag key
+ *
+ *  @param tag The tag key
+ *
+ *  @return The stream or nil if it's not in the index
+ */
+-(OlapicStreamEntity *)streamWithTagKey:(NSString *)tag;
+/**
+ *  Get an indexed category by its tag key
+ *
+ *  @param tag The tag key
+ *
+ *  @return The category or nil if it's not in the index
+ */
+-(OlapicCategoryEntity *)categoryWithTagKey:(NSString *)tag;
+/**
+ *  Search the streams or categories. The local results are returned
+ *  right away; if there are none, the query is looked up on the API as
+ *  a tag key (and the result is indexed)
+ *
+ *  @param query   The text the user typed
+ *  @param type    OlapicStreamEntity or OlapicCategoryEntity
+ *  @param limit   The maximum number of results (0 for no limit)
+ *  @param results A callback action with the results, and if they come from the index
+ */
+-(void)search:(NSString *)query ofType:(Class)type limit:(NSUInteger)limit onResults:(void (^)(NSArray *entities, BOOL local))results;
+/**
+ *  Split a text into normalized words (lowercased, without accents)
+ *
+ *  @param text The text
+ *
+ *  @return An array of strings
+ */
++(NSArray *)termsForText:(NSString *)text;
+
+@end
+/**
+ *  Stream lookups that use the search index first
+ */
+@interface OlapicStreamHandler (Search)
+/**
+ *  Get a stream by its tag key, from the search index if it's there or
+ *  from the API (and then it's indexed)
+ *
+ *  @param tag     The tag key
+ *  @param success A callback block for when the stream is found
+ *  @param failure A callback block for when the SDK can't get the stream
+ */
+-(void)getIndexedStreamByTagKey:(NSString *)tag onSuccess:(void (^)(OlapicStreamEntity *stream))success onFailure:(void (^)(NSError *error))failure;
+
+@end
+/**
+ *  Category lookups that use the search index first
+ */
+@interface OlapicCategoryHandler (Search)
+/**
+ *  Get a category by its tag key, from the search index if it's there or
+ *  from the API (and then it's indexed)
+ *
+ *  @param tag     The tag key
+ *  @param success A callback block for when the category is found
+ *  @param failure A callback block for when the SDK can't get the category
+ */
+-(void)getIndexedCategoryByTagKey:(NSString *)tag onSuccess:(void (^)(OlapicCategoryEntity *category))success onFailure:(void (^)(NSError *error))failure;
+
+@end
\ No newline at end of file
@@ -0,0 +1,536 @@
+//
+//  OlapicSearchIndex.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+#import "OlapicSearchIndex.h"
+#import "OlapicEntityInterner.h"
+
+/**
+ *  The entity fields that are indexed
+ */
+static NSString *const OlapicSearchIndexTagKeyField = @"tag_based_key";
+static NSString *const OlapicSearchIndexNameField = @"name";
+static NSString *const OlapicSearchIndexCaptionField = @"caption";
+
+@interface OlapicSearchIndex()
+/**
+ *  Get the class used as the type of an indexed entity
+ *
+ *  @param entity The entity
+ *
+ *  @return OlapicMediaEntity, OlapicStreamEntity, OlapicCategoryEntity or Nil
+ */
++(Class)typeForEntity:(OlapicEntity *)entity;
+/**
+ *  Get the normalized text of the fields of an entity, the
+ *  tag key and name first
+ *
+ *  @param entity The entity
+ *
+ *  @return An array of strings
+ */
++(NSArray *)titlesForEntity:(OlapicEntity *)entity;
+/**
+ *  Get the normalized version of a text (lowercased, without accents)
+ *
+ *  @param text The text
+ *
+ *  @return The normalized text
+ */
++(NSString *)normalizedText:(NSString *)text;
+/**
+ *  Add a word of a document
+ *
+ *  @param term The word
+ *  @param key  The document key
+ */
+-(void)addTerm:(NSString *)term forDocument:(NSString *)key;
+/**
+ *  Remove a document and its words
+ *
+ *  @param key The document key
+ */
+-(void)removeDocument:(NSString *)key;
+/**
+ *  Get the position of the first word that is equal or greater than
+ *  a text
+ *
+ *  @param text The text
+ *
+ *  @return The position (the count of words if there's none)
+ */
+-(NSUInteger)lowerBoundForTerm:(NSString *)text;
+/**
+ *  Get an indexed stream or category by its tag key
+ *
+ *  @param tag  The tag key
+ *  @param type OlapicStreamEntity or OlapicCategoryEntity
+ *
+ *  @return The entity or nil if it's not in the index
+ */
+-(id)entityOfType:(Class)type withTagKey:(NSString *)tag;
+/**
+ *  Get the "Type/tag key" of an entity, used to find it by its tag key
+ *
+ *  @param entity The entity
+ *  @param type   Its type
+ *
+ *  @return The key, or nil if the entity doesn't have a tag key
+ */
++(NSString *)tagKeyForEntity:(OlapicEntity *)entity type:(Class)type;
+/**
+ *  Remove the least recently added documents until there are no more
+ *  than maxDocumentCount
+ */
+-(void)trimToMaxCount;
+/**
+ *  Free the memory after a memory warning
+ *
+ *  @param notification The notification
+ */
+-(void)didReceiveMemoryWarning:(NSNotification *)notification;
+
+@end
+
+@implementation OlapicSearchIndex
+@synthesize maxDocumentCount;
+/**
+ *  Get the shared instance
+ *
+ *  @return The shared instance
+ */
++(OlapicSearchIndex *)sharedIndex{
+    static OlapicSearchIndex *sharedIndex = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedIndex = [[OlapicSearchIndex alloc] init];
+    });
+    return sharedIndex;
+}
+/**
+ *  Class constructor
+ *
+ *  @return An instance of this object (OlapicSearchIndex)
+ */
+-(id)init{
+    self = [super init];
+    if(self){
+        terms = [[NSMutableArray alloc] init];
+        postings = [[NSMutableDictionary alloc] init];
+        documents = [[NSMutableDictionary alloc] init];
+        documentTerms = [[NSMutableDictionary alloc] init];
+        tagKeys = [[NSMutableDictionary alloc] init];
+        recentDocuments = [[NSMutableOrderedSet alloc] init];
+        maxDocumentCount = 2000;
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    }
+    return self;
+}
+/**
+ *  Change how many entities the index keeps, removing them if needed
+ *
+ *  @param count The number of entities
+ */
+-(void)setMaxDocumentCount:(NSUInteger)count{
+    maxDocumentCount = count;
+    [self trimToMaxCount];
+}
+/**
+ *  Index entities (media, streams or categories; the rest are ignored).
+ *  An entity that was already indexed is indexed again with its
+ *  current data
+ *
+ *  @param entities An array of OlapicEntity objects
+ */
+-(void)addEntities:(NSArray *)entities{
+    for(OlapicEntity *entity in entities){
+        Class type = [OlapicSearchIndex typeForEntity:entity];
+        NSString *identifier = [OlapicEntityInterner identifierForJSON:entity.data];
+        if(!type || !identifier) continue;
+        NSString *key = [NSString stringWithFormat:@"%@/%@", NSStringFromClass(type), identifier];
+        NSMutableSet *words = [[NSMutableSet alloc] init];
+        for(NSString *title in [OlapicSearchIndex titlesForEntity:entity]){
+            [words addObjectsFromArray:[OlapicSearchIndex termsForText:title]];
+        }
+        // The whole tag key is a word too, so 'summer_sale' matches 'summer_s'
+        id tag = [entity.data valueForKey:OlapicSearchIndexTagKeyField];
+        if([tag isKindOfClass:[NSString class]] && [tag length]){
+            [words addObject:[OlapicSearchIndex normalizedText:tag]];
+        }
+        [recentDocuments removeObject:key];
+        [recentDocuments addObject:key];
+        NSString *tagKey = [OlapicSearchIndex tagKeyForEntity:entity type:type];
+        if([[documentTerms objectForKey:key] isEqualToSet:words]){
+            [documents setObject:entity forKey:key];
+            if(tagKey) [tagKeys setObject:key forKey:tagKey];
+            continue;
+        }
+        [self removeDocument:key];
+        [documents setObject:entity forKey:key];
+        [documentTerms setObject:words forKey:key];
+        if(tagKey) [tagKeys setObject:key forKey:tagKey];
+        for(NSString *word in words){
+            [self addTerm:word forDocument:key];
+        }
+    }
+    [self trimToMaxCount];
+}
+/**
+ *  Remove the least recently added documents until there are no more
+ *  than maxDocumentCount
+ */
+-(void)trimToMaxCount{
+    while([recentDocuments count] > maxDocumentCount){
+        NSString *key = [recentDocuments firstObject];
+        [recentDocuments removeObjectAtIndex:0];
+        [self removeDocument:key];
+    }
+}
+/**
+ *  Free the memory after a memory warning
+ *
+ *  @param notification The notification
+ */
+-(void)didReceiveMemoryWarning:(NSNotification *)notification{
+    [self removeAllEntities];
+}
+/**
+ *  Remove everything from the index
+ */
+-(void)removeAllEntities{
+    [terms removeAllObjects];
+    [postings removeAllObjects];
+    [documents removeAllObjects];
+    [documentTerms removeAllObjects];
+    [tagKeys removeAllObjects];
+    [recentDocuments removeAllObjects];
+}
+/**
+ *  Get the number of different words in the index
+ *
+ *  @return The number of words
+ */
+-(NSUInteger)termCount{
+    return [terms count];
+}
+/**
+ *  Find the entities with words that start with the words of a query
+ *
+ *  @param query The text the user typed
+ *  @param type  Only the entities of this class (Nil for all of them)
+ *  @param limit The maximum number of results (0 for no limit)
+ *
+ *  @return An array of OlapicEntity objects, the ones with a tag key or
+ *  name that starts with the whole query first
+ */
+-(NSArray *)entitiesMatchingPrefix:(NSString *)query ofType:(Class)type limit:(NSUInteger)limit{
+    NSArray *queryTerms = [OlapicSearchIndex termsForText:query];
+    if(![queryTerms count]) return @[];
+    NSMutableSet *matches = nil;
+    for(NSString *queryTerm in queryTerms){
+        NSMutableSet *termMatches = [[NSMutableSet alloc] init];
+        NSUInteger count = [terms count];
+        for(NSUInteger i = [self lowerBoundForTerm:queryTerm]; i < count; i++){
+            NSString *term = [terms objectAtIndex:i];
+            if(![term hasPrefix:queryTerm]) break;
+            [termMatches unionSet:[postings objectForKey:term]];
+        }
+        if(matches){
+            [matches intersectSet:termMatches];
+        }else{
+            matches = termMatches;
+        }
+        if(![matches count]) return @[];
+    }
+    NSString *typePrefix = type ? [NSStringFromClass(type) stringByAppendingString:@"/"] : nil;
+    NSString *fullQuery = [queryTerms componentsJoinedByString:@" "];
+    NSMutableArray *best = [[NSMutableArray alloc] init];
+    NSMutableArray *rest = [[NSMutableArray alloc] init];
+    for(NSString *key in [[matches allObjects] sortedArrayUsingSelector:@selector(compare:)]){
+        if(typePrefix && ![key hasPrefix:typePrefix]) continue;
+        OlapicEntity *entity = [documents objectForKey:key];
+        NSArray *titles = [OlapicSearchIndex titlesForEntity:entity];
+        BOOL isBest = NO;
+        // The tag key and the name are the first titles, the caption is the last one
+        for(NSUInteger i = 0; i < MIN([titles count], (NSUInteger)2) && !isBest; i++){
+            isBest = [[[OlapicSearchIndex termsForText:[titles objectAtIndex:i]] componentsJoinedByString:@" "] hasPrefix:fullQuery];
+        }
+        [(isBest ? best : rest) addObject:entity];
+        if(limit > 0 && [best count] >= limit) break;
+    }
+    [best addObjectsFromArray:rest];
+    if(limit > 0 && [best count] > limit){
+        return [best subarrayWithRange:NSMakeRange(0, limit)];
+    }
+    return best;
+}
+/**
+ *  Get an indexed stream by its tag key
+ *
+ *  @param tag The tag key
+ *
+ *  @return The stream or nil if it's not in the index
+ */
+-(OlapicStreamEntity *)streamWithTagKey:(NSString *)tag{
+    return [self entityOfType:[OlapicStreamEntity class] withTagKey:tag];
+}
+/**
+ *  Get an indexed category by its tag key
+ *
+ *  @param tag The tag key
+ *
+ *  @return The category or nil if it's not in the index
+ */
+-(OlapicCategoryEntity *)categoryWithTagKey:(NSString *)tag{
+    return [self entityOfType:[OlapicCategoryEntity class] withTagKey:tag];
+}
+/**
+ *  Search the streams or categories. The local results are returned
+ *  right away; if there are none, the query is looked up on the API as
+ *  a tag key (and the result is indexed)
+ *
+ *  @param query   The text the user typed
+ *  @param type    OlapicStreamEntity or OlapicCategoryEntity
+ *  @param limit   The maximum number of results (0 for no limit)
+ *  @param results A callback action with the results, and if they come from the index
+ */
+-(void)search:(NSString *)query ofType:(Class)type limit:(NSUInteger)limit onResults:(void (^)(NSArray *entities, BOOL local))results{
+    NSArray *found = [self entitiesMatchingPrefix:query ofType:type limit:limit];
+    NSString *tag = [query stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    if([found count] || ![tag length]){
+        if(results) results(found, YES);
+        return;
+    }
+    OlapicSDK *olapic = [OlapicSDK sharedOlapicSDK];
+    if(type == [OlapicStreamEntity class]){
+        [[olapic streams] getIndexedStreamByTagKey:tag onSuccess:^(OlapicStreamEntity *stream){
+            if(results) results(stream ? @[stream] : @[], NO);
+        } onFailure:^(NSError *error){
+            if(results) results(@[], NO);
+        }];
+    }else if(type == [OlapicCategoryEntity class]){
+        [[olapic categories] getIndexedCategoryByTagKey:tag onSuccess:^(OlapicCategoryEntity *category){
+            if(results) results(category ? @[category] : @[], NO);
+        } onFailure:^(NSError *error){
+            if(results) results(@[], NO);
+        }];
+    }else if(results){
+        results(found, YES);
+    }
+}
+/**
+ *  Split a text into normalized words (lowercased, without accents)
+ *
+ *  @param text The text
+ *
+ *  @return An array of strings
+ */
++(NSArray *)termsForText:(NSString *)text{
+    if(![text isKindOfClass:[NSString class]]) return @[];
+    NSCharacterSet *separators = [[NSCharacterSet alphanumericCharacterSet] invertedSet];
+    NSMutableArray *words = [[NSMutableArray alloc] init];
+    for(NSString *word in [[OlapicSearchIndex normalizedText:text] componentsSeparatedByCharactersInSet:separators]){
+        if([word length]) [words addObject:word];
+    }
+    return words;
+}
+/**
+ *  Get the normalized version of a text (lowercased, without accents)
+ *
+ *  @param text The text
+ *
+ *  @return The normalized text
+ */
++(NSString *)normalizedText:(NSString *)text{
+    return [[text stringByFoldingWithOptions:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch | NSWidthInsensitiveSearch locale:nil] lowercaseString];
+}
+/**
+ *  Get the class used as the type of an indexed entity
+ *
+ *  @param entity The entity
+ *
+ *  @return OlapicMediaEntity, OlapicStreamEntity, OlapicCategoryEntity or Nil
+ */
++(Class)typeForEntity:(OlapicEntity *)entity{
+    for(Class type in @[[OlapicMediaEntity class], [OlapicStreamEntity class], [OlapicCategoryEntity class]]){
+        if([entity isKindOfClass:type]) return type;
+    }
+    return Nil;
+}
+/**
+ *  Get the normalized text of the fields of an entity, the
+ *  tag key and name first
+ *
+ *  @param entity The entity
+ *
+ *  @return An array of strings
+ */
++(NSArray *)titlesForEntity:(OlapicEntity *)entity{
+    NSMutableArray *titles = [[NSMutableArray alloc] init];
+    for(NSString *field in @[OlapicSearchIndexTagKeyField, OlapicSearchIndexNameField, OlapicSearchIndexCaptionField]){
+        id value = [entity.data valueForKey:field];
+        if([value isKindOfClass:[NSString class]] && [value length]) [titles addObject:value];
+    }
+    return titles;
+}
+/**
+ *  Add a word of a document
+ *
+ *  @param term The word
+ *  @param key  The document key
+ */
+-(void)addTerm:(NSString *)term forDocument:(NSString *)key{
+    NSMutableSet *keys = [postings objectForKey:term];
+    if(!keys){
+        keys = [[NSMutableSet alloc] init];
+        [postings setObject:keys forKey:term];
+        [terms insertObject:term atIndex:[self lowerBoundForTerm:term]];
+    }
+    [keys addObject:key];
+}
+/**
+ *  Remove a document and its words
+ *
+ *  @param key The document key
+ */
+-(void)removeDocument:(NSString *)key{
+    OlapicEntity *entity = [documents objectForKey:key];
+    NSString *tagKey = entity ? [OlapicSearchIndex tagKeyForEntity:entity type:[OlapicSearchIndex typeForEntity:entity]] : nil;
+    if(tagKey && [[tagKeys objectForKey:tagKey] isEqualToString:key]){
+        [tagKeys removeObjectForKey:tagKey];
+    }
+    for(NSString *term in [documentTerms objectForKey:key]){
+        NSMutableSet *keys = [postings objectForKey:term];
+        [keys removeObject:key];
+        if([keys count]) continue;
+        [postings removeObjectForKey:term];
+        NSUInteger position = [self lowerBoundForTerm:term];
+        if(position < [terms count] && [[terms objectAtIndex:position] isEqualToString:term]){
+            [terms removeObjectAtIndex:position];
+        }
+    }
+    [documentTerms removeObjectForKey:key];
+    [documents removeObjectForKey:key];
+}
+/**
+ *  Get the position of the first word that is equal or greater than
+ *  a text
+ *
+ *  @param text The text
+ *
+ *  @return The position (the count of words if there's none)
+ */
+-(NSUInteger)lowerBoundForTerm:(NSString *)text{
+    return [terms indexOfObject:text inSortedRange:NSMakeRange(0, [terms count]) options:NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual usingComparator:^NSComparisonResult(NSString *term, NSString *other){
+        return [term compare:other options:NSLiteralSearch];
+    }];
+}
+/**
+ *  Get an indexed stream or category by its tag key
+ *
+ *  @param tag  The tag key
+ *  @param type OlapicStreamEntity or OlapicCategoryEntity
+ *
+ *  @return The entity or nil if it's not in the index
+ */
+-(id)entityOfType:(Class)type withTagKey:(NSString *)tag{
+    if(![tag length]) return nil;
+    NSString *key = [tagKeys objectForKey:[NSString stringWithFormat:@"%@/%@", NSStringFromClass(type), [OlapicSearchIndex normalizedText:tag]]];
+    return key ? [documents objectForKey:key] : nil;
+}
+/**
+ *  Get the "Type/tag key" of an entity, used to find it by its tag key
+ *
+ *  @param entity The entity
+ *  @param type   Its type
+ *
+ *  @return The key, or nil if the entity doesn't have a tag key
+ */
++(NSString *)tagKeyForEntity:(OlapicEntity *)entity type:(Class)type{
+    id tag = [entity.data valueForKey:OlapicSearchIndexTagKeyField];
+    if(!type || ![tag isKindOfClass:[NSString class]] || ![tag length]) return nil;
+    return [NSString stringWithFormat:@"%@/%@", NSStringFromClass(type), [OlapicSearchIndex normalizedText:tag]];
+}
+/**
+ *  Stop observing the notifications
+ */
+-(void)dealloc{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+@end
+
+@implementation OlapicStreamHandler (Search)
+/**
+ *  Get a stream by its tag key, from the search index if it's there or
+ *  from the API (and then it's indexed)
+ *
+ *  @param tag     The tag key
+ *  @param success A callback block for when the stream is found
+ *  @param failure A callback block for when the SDK can't get the stream
+ */
+-(void)getIndexedStreamByTagKey:(NSString *)tag onSuccess:(void (^)(OlapicStreamEntity *stream))success onFailure:(void (^)(NSError *error))failure{
+    OlapicStreamEntity *indexed = [[OlapicSearchIndex sharedIndex] streamWithTagKey:tag];
+    if(indexed){
+        if(success) success(indexed);
+        return;
+    }
+    [self getStreamByTagKey:tag onSuccess:^(OlapicStreamEntity *stream){
+        if(stream) [[OlapicSearchIndex sharedIndex] addEntities:@[stream]];
+        if(success) success(stream);
+    } onFailure:failure];
+}
+
+@end
+
+@implementation OlapicCategoryHandler (Search)
+/**
+ *  Get a category by its tag key, from the search index if it's there or
+ *  from the API (and then it's indexed)
+ *
+ *  @param tag     The tag key
+ *  @param success A callback block for when the category is found
+ *  @param failure A callback block for when the SDK can't get the category
+ */
+-(void)getIndexedCategoryByTagKey:(NSString *)tag onSuccess:(void (^)(OlapicCategoryEntity *category))success onFailure:(void (^)(NSError *error))failure{
+    OlapicCategoryEntity *indexed = [[OlapicSearchIndex sharedIndex] categoryWithTagKey:tag];
+    if(indexed){
+        if(success) success(indexed);
+        return;
+    }
+    [self getCategoryByTagKey:tag onSuccess:^(OlapicCategoryEntity *category){
+        if(category) [[OlapicSearchIndex sharedIndex] addEntities:@[category]];
+        if(success) success(category);
+    } onFailure:failure];
+}
+
+@end
\ No newline at end of file
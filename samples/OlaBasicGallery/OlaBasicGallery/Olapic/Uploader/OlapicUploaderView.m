@@ -8,6 +8,7 @@
 
 #import "OlapicUploaderView.h"
 #import "OlapicAsyncImageView.h"
+#import "OlapicIdentityMap.h"
 
 @interface OlapicUploaderView(){
     /**
@@ -118,8 +119,8 @@
     // - Set the source and the caption (which we already have, from the media object)
     lblSource.text = [NSString stringWithFormat:@"From %@",[media get:@"source"]];
     txtCaption.text = [media get:@"caption"];
-    // - Start downloading the uploaders information
-    [media getUploader:^(OlapicUploaderEntity *up){
+    // - Start downloading the uploaders information (unless another media already did)
+    [[OlapicIdentityMap sharedMap] getUploaderForMedia:media onSuccess:^(OlapicUploaderEntity *up){
         // - - Set the uploaders reference
         uploader = up;
         // - - Show the name on the UI
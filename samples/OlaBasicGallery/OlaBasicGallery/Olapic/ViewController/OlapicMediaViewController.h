@@ -34,6 +34,8 @@
 #import <OlapicSDK/OlapicSDK.h>
 #import "OlapicAsyncImageView.h"
 #import "OlapicUploaderView.h"
+#import "OlapicTiledImageView.h"
+#import "OlapicMediaPrefetcher.h"
 /**
  *  Show a single media entity in detail, with a zoom
  *  controller and the information about its uploader
@@ -48,6 +50,15 @@
      *  The image object for the zoom
      */
     UIImageView *image;
+    /**
+     *  The original image, drawn by tiles on top of the zoom image
+     */
+    OlapicTiledImageView *tiledImage;
+    /**
+     *  If the original image was already requested, because the zoom
+     *  needed more pixels than the display size image has
+     */
+    BOOL originalRequested;
     /**
      *  The zoom controller
      */
@@ -78,10 +89,21 @@
      *  The real object with the uploader detail
      */
     OlapicUploaderView *detail;
+    /**
+     *  Prefetches the media around this one, from the list it belongs to
+     */
+    OlapicMediaPrefetcher *prefetcher;
+    /**
+     *  The callback for when the user swipes to the next or the previous
+     *  media, so the gallery can show it
+     */
+    void (^neighbourCallback)(OlapicMediaViewController *controller, OlapicMediaEntity *media);
 }
 
 @property (nonatomic,weak) OlapicAsyncImageView *__weak mimage;
 @property (nonatomic,strong) UIImageView *image;
+@property (nonatomic,strong) OlapicTiledImageView *tiledImage;
+@property (nonatomic) BOOL originalRequested;
 @property (nonatomic,strong) UIScrollView *zoomView;
 @property (nonatomic) BOOL firstLoad;
 @property (nonatomic,strong) UIView *uploaderView;
@@ -89,6 +111,8 @@
 @property (nonatomic,strong) UIView *uploaderArrowLine;
 @property (nonatomic) BOOL uploaderViewOpen;
 @property (nonatomic,strong) OlapicUploaderView *detail;
+@property (nonatomic,strong) OlapicMediaPrefetcher *prefetcher;
+@property (nonatomic,strong) void (^neighbourCallback)(OlapicMediaViewController *controller, OlapicMediaEntity *media);
 
 /**
  *  Class constructor
@@ -98,5 +122,14 @@
  *  @return An instance of this object (OlapicMediaViewController)
  */
 -(id)initWithImage:(OlapicAsyncImageView *__weak)img;
+/**
+ *  Class constructor
+ *
+ *  @param img             The thumbnail that called this screen
+ *  @param mediaPrefetcher The object that prefetches the media around this one
+ *
+ *  @return An instance of this object (OlapicMediaViewController)
+ */
+-(id)initWithImage:(OlapicAsyncImageView *__weak)img prefetcher:(OlapicMediaPrefetcher *)mediaPrefetcher;
 
 @end
@@ -65,11 +65,28 @@
  */
 -(CGRect)centeredFrameForScrollView:(UIScrollView *)scroll andUIView:(UIView *)rView;
 /**
- *  Start downloading the full image.
- *  When it first loads, the image will have the thumbnail quality, but as
- *  soon as the full image is downloaded, it will replace it.
+ *  Start downloading the display size image.
+ *  When it first loads, the image will have the thumbnail quality, and the
+ *  display size version replaces it as soon as it's downloaded. The original
+ *  is only downloaded if the user zooms past what this version covers.
  */
 -(void)loadFullImage;
+/**
+ *  Start downloading the original image, once.
+ *  As soon as it's downloaded, a tiled view on top of the zoom image will
+ *  draw only the visible parts of the original, at the resolution needed
+ *  by the zoom scale. It uses the Original priority, so on cellular the
+ *  network client defers it while other requests are waiting.
+ */
+-(void)loadOriginalImage;
+/**
+ *  Check if a zoom scale needs more pixels than the image being shown has
+ *
+ *  @param scale The zoom scale
+ *
+ *  @return YES if the original image is needed
+ */
+-(BOOL)needsOriginalForZoomScale:(CGFloat)scale;
 /**
  *  Resize the image proportionally
  */
@@ -115,11 +132,24 @@
 -(void)resetUploaderViewPosition:(CGSize)size;
 
 -(void)toggleDetail;
+/**
+ *  Swipe from right to left, used to show the next media
+ *
+ *  @param gesture The swipe gesture
+ */
+-(void)handleSwipeNext:(UISwipeGestureRecognizer *)gesture;
+/**
+ *  Ask the gallery to show a media next to this one, unless the
+ *  image is zoomed in
+ *
+ *  @param offset 1 for the next media, -1 for the previous one
+ */
+-(void)showNeighbour:(NSInteger)offset;
 
 @end
 
 @implementation OlapicMediaViewController
-@synthesize mimage,image,zoomView,firstLoad,uploaderView,uploaderViewOpen,detail,uploaderArrow,uploaderArrowLine;
+@synthesize mimage,image,tiledImage,originalRequested,zoomView,firstLoad,uploaderView,uploaderViewOpen,detail,uploaderArrow,uploaderArrowLine,prefetcher,neighbourCallback;
 /**
  *  Class constructor
  *
@@ -128,9 +158,21 @@
  *  @return An instance of this object (OlapicMediaViewController)
  */
 -(id)initWithImage:(OlapicAsyncImageView *__weak)img{
+    return [self initWithImage:img prefetcher:nil];
+}
+/**
+ *  Class constructor
+ *
+ *  @param img             The thumbnail that called this screen
+ *  @param mediaPrefetcher The object that prefetches the media around this one
+ *
+ *  @return An instance of this object (OlapicMediaViewController)
+ */
+-(id)initWithImage:(OlapicAsyncImageView *__weak)img prefetcher:(OlapicMediaPrefetcher *)mediaPrefetcher{
     self = [super init];
     if(self){
         mimage = img;
+        prefetcher = mediaPrefetcher;
         zoomView = [[UIScrollView alloc] initWithFrame:CGRectZero];
         uploaderView = [[UIView alloc] initWithFrame:CGRectZero];
         uploaderView.backgroundColor = [UIColor clearColor];
@@ -173,6 +215,10 @@
         self.navigationItem.rightBarButtonItem = detailBtn;
         // Show the image and center it
         image = [[UIImageView alloc] initWithImage:mimage.thumbImage];
+        // If the image was prefetched, show it instead of the thumbnail
+        NSData *displayData = [prefetcher imageDataForMedia:mimage.media];
+        UIImage *displayImage = displayData ? [UIImage imageWithData:displayData] : nil;
+        if(displayImage) image.image = displayImage;
         if(mimage.media.originalSize.width > 0){
             [self resizeAndCenter];
         }
@@ -180,8 +226,9 @@
         image.contentMode = UIViewContentModeScaleAspectFit;
         // Set the uploader detail view
         uploaderView.frame = CGRectMake(self.view.frame.size.width, 0, kUploaderWidth, self.view.frame.size.height);
-        // Start downloading the full image
+        // Start downloading the full image, and the media around this one
         [self loadFullImage];
+        [prefetcher prefetchAroundMedia:mimage.media];
         // Set the gestures
         // - The swipe from the right edge to show the uploader detail view
         UIScreenEdgePanGestureRecognizer *swipeRight = [[UIScreenEdgePanGestureRecognizer alloc] initWithTarget:self action:@selector(handleSwipeRight:)];
@@ -199,6 +246,12 @@
         [zswipeLeft setDirection:UISwipeGestureRecognizerDirectionRight];
         [zswipeLeft setDelegate:self];
         [zoomView addGestureRecognizer:zswipeLeft];
+        // - The swipe from right to left, to show the next media. It's on the controller
+        //   view so it also works while the zoom is disabled
+        UISwipeGestureRecognizer *swipeNext = [[UISwipeGestureRecognizer alloc] initWithTarget:self action:@selector(handleSwipeNext:)];
+        [swipeNext setDirection:UISwipeGestureRecognizerDirectionLeft];
+        [swipeNext requireGestureRecognizerToFail:swipeRight];
+        [self.view addGestureRecognizer:swipeNext];
     }
     [self readjustSize];
 }
@@ -239,6 +292,11 @@
  *  @param gesture The swipe gesture
  */
 -(void)handleSwipeLeft:(UIScreenEdgePanGestureRecognizer*)gesture{
+    // With the uploader detail view closed, it goes to the previous media
+    if(!uploaderViewOpen && gesture.view == zoomView){
+        [self showNeighbour:-1];
+        return;
+    }
     [UIView beginAnimations:nil context:nil];
     [UIView setAnimationDuration:0.25];
     [UIView setAnimationCurve:UIViewAnimationCurveEaseInOut];
@@ -334,7 +392,9 @@
  */
 -(void)resetZoom{
     if(self.view.frame.size.width < 1) return;
-    CGSize theSize = [mimage.fullImage size];
+    CGSize theSize = tiledImage ? tiledImage.imageSize : mimage.media.originalSize;
+    if(theSize.width < 1 || theSize.height < 1) theSize = image.image.size;
+    if(theSize.width < 1 || theSize.height < 1) return;
     CGSize screenSize = zoomView.frame.size;
     CGFloat widthRatio = screenSize.width / theSize.width;
     CGFloat heightRatio = screenSize.height / theSize.height;
@@ -373,29 +433,86 @@
 	return frameToCenter;
 }
 /**
- *  Start downloading the full image.
- *  When it first loads, the image will have the thumbnail quality, but as
- *  soon as the full image is downloaded, it will replace it.
+ *  Start downloading the display size image.
+ *  When it first loads, the image will have the thumbnail quality, and the
+ *  display size version replaces it as soon as it's downloaded. The original
+ *  is only downloaded if the user zooms past what this version covers.
  */
 -(void)loadFullImage{
-    [mimage downloadFullImageAndDo:^(OlapicAsyncImageView *imageo){
-        [UIView beginAnimations:nil context:nil];
-        [UIView setAnimationDuration:0.30];
-        [UIView setAnimationDelegate:self];
-        image.image = imageo.fullImage;
-        image.frame = [self centeredFrameForScrollView:zoomView andUIView:image];
-        image.contentMode = UIViewContentModeScaleAspectFill;
-        [UIView commitAnimations];
-        [zoomView setUserInteractionEnabled:YES];
-        detail.image = image;
-        [self performSelector:@selector(resetZoom) withObject:nil afterDelay:0.30];
+    __weak OlapicMediaViewController *weakSelf = self;
+    [mimage downloadFullImageAndDo:^(OlapicAsyncImageView *asyncImage){
+        OlapicMediaViewController *controller = weakSelf;
+        if(!controller) return;
+        if(asyncImage.fullImage) controller->image.image = asyncImage.fullImage;
+        controller->detail.image = controller->image;
+        [controller->zoomView setUserInteractionEnabled:YES];
+        [controller performSelector:@selector(resetZoom) withObject:nil afterDelay:0.30];
     }];
 }
+/**
+ *  Start downloading the original image, once.
+ *  As soon as it's downloaded, a tiled view on top of the zoom image will
+ *  draw only the visible parts of the original, at the resolution needed
+ *  by the zoom scale. It uses the Original priority, so on cellular the
+ *  network client defers it while other requests are waiting.
+ */
+-(void)loadOriginalImage{
+    if(originalRequested) return;
+    originalRequested = YES;
+    __weak OlapicMediaViewController *weakSelf = self;
+    [mimage downloadOriginalDataAndDo:^(NSData *data){
+        OlapicMediaViewController *controller = weakSelf;
+        if(!controller || controller->tiledImage) return;
+        OlapicTiledImageView *tiled = [[OlapicTiledImageView alloc] initWithImageData:data frame:controller->image.bounds maximumZoomScale:controller->zoomView.maximumZoomScale];
+        if(!tiled) return;
+        // It follows the size of the zoom image, and the zoom itself
+        // comes from the image transform
+        tiled.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+        controller->tiledImage = tiled;
+        [controller->image addSubview:tiled];
+        controller->image.contentMode = UIViewContentModeScaleAspectFill;
+    }];
+}
+/**
+ *  Check if a zoom scale needs more pixels than the image being shown has
+ *
+ *  @param scale The zoom scale
+ *
+ *  @return YES if the original image is needed
+ */
+-(BOOL)needsOriginalForZoomScale:(CGFloat)scale{
+    UIImage *shown = image.image;
+    if(!shown) return YES;
+    CGFloat screenScale = [UIScreen mainScreen].scale;
+    CGFloat neededWidth = image.bounds.size.width * scale * screenScale;
+    CGFloat neededHeight = image.bounds.size.height * scale * screenScale;
+    return neededWidth > shown.size.width * shown.scale || neededHeight > shown.size.height * shown.scale;
+}
 
 -(void)toggleDetail{
     uploaderViewOpen = uploaderViewOpen ? NO : YES;
     [self resetUploaderViewPosition];
 }
+/**
+ *  Swipe from right to left, used to show the next media
+ *
+ *  @param gesture The swipe gesture
+ */
+-(void)handleSwipeNext:(UISwipeGestureRecognizer *)gesture{
+    if(uploaderViewOpen) return;
+    [self showNeighbour:1];
+}
+/**
+ *  Ask the gallery to show a media next to this one, unless the
+ *  image is zoomed in
+ *
+ *  @param offset 1 for the next media, -1 for the previous one
+ */
+-(void)showNeighbour:(NSInteger)offset{
+    if(zoomView.zoomScale > zoomView.minimumZoomScale + 0.01) return;
+    OlapicMediaEntity *neighbour = [prefetcher mediaNextTo:mimage.media offset:offset];
+    if(neighbour && neighbourCallback) neighbourCallback(self, neighbour);
+}
 
 #pragma mark - Default cycle
 /**
@@ -435,6 +552,14 @@
 - (void)scrollViewDidZoom:(UIScrollView *)scrollView {
     image.frame = [self centeredFrameForScrollView:scrollView andUIView:image];
 }
+/**
+ * When the zoom ends past what the display size image covers, download the original
+ */
+-(void)scrollViewDidEndZooming:(UIScrollView *)scrollView withView:(UIView *)view atScale:(CGFloat)scale{
+    if(!tiledImage && [self needsOriginalForZoomScale:scale]){
+        [self loadOriginalImage];
+    }
+}
 /**
  * Make the zoom for the scroll view
  */
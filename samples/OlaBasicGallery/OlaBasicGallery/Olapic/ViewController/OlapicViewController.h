@@ -32,14 +32,19 @@
 
 #import <Foundation/Foundation.h>
 #import <OlapicSDK/OlapicCustomerMediaList.h>
+#import "OlapicMediaListController.h"
+#import "OlapicWidgetBootstrap.h"
+#import "OlapicMediaPrefetcher.h"
+#import "OlapicMediaListWindow.h"
 
 @class OlapicCustomerMediaList;
 @class OlapicAsyncImageView;
+@class OlapicMediaViewController;
 /**
  *  Connects with the Olapic API and shows the
  *  thumbnail gallery on the screen
  */
-@interface OlapicViewController : UIViewController <OlapicMediaListDelegate>{
+@interface OlapicViewController : UIViewController <OlapicMediaListDelegate,OlapicMediaListControllerDelegate,OlapicMediaListWindowDelegate,UIScrollViewDelegate>{
     /**
      *  The loading indicator to show while the app is downloading the content
      */
@@ -53,6 +58,11 @@
      *  The SDK object to handle media lists
      */
     OlapicCustomerMediaList *list;
+    /**
+     *  The object that loads the list, so its requests can be
+     *  suspended while the gallery is not visible
+     */
+    OlapicMediaListController *listController;
     /**
      *  A container view for the thumbnails
      */
@@ -61,11 +71,45 @@
      *  An array with the already generated thumbnails
      */
     NSMutableArray *thumbnails;
+    /**
+     *  If the thumbnails don't come from the list (but from the cache of a
+     *  previous session, or from the media store after a sorting change),
+     *  and should be replaced by the first page
+     */
+    BOOL showingCachedMedia;
+    /**
+     *  Loads a widget instance, when the gallery shows one instead
+     *  of the customer media
+     */
+    OlapicWidgetBootstrap *bootstrap;
+    /**
+     *  Prefetches the media around the one on the detail screen
+     */
+    OlapicMediaPrefetcher *prefetcher;
+    /**
+     *  Loads the page of the linked media, without walking the
+     *  pages before it
+     */
+    OlapicMediaListWindow *listWindow;
+    /**
+     *  The offset on the list of the media to open when the gallery
+     *  loads (the 'OlapicLinkedOffset' launch argument), or 0
+     */
+    NSInteger linkedOffset;
+    /**
+     *  The thumbnail of the linked media, it's not on the gallery
+     */
+    OlapicAsyncImageView *linkedThumb;
 }
 
 @property (nonatomic,strong) UIActivityIndicatorView *loader;
 @property (nonatomic) BOOL firstLoad;
 @property (nonatomic,strong) OlapicCustomerMediaList *list;
+@property (nonatomic,strong) OlapicMediaListController *listController;
+@property (nonatomic,strong) OlapicWidgetBootstrap *bootstrap;
+@property (nonatomic,strong) OlapicMediaPrefetcher *prefetcher;
+@property (nonatomic,strong) OlapicMediaListWindow *listWindow;
+@property (nonatomic) NSInteger linkedOffset;
 @property (nonatomic,strong) UIScrollView *scroll;
 @property (nonatomic,strong) NSMutableArray *thumbnails;
 /**
@@ -75,6 +119,14 @@
  *  @param media An array of OlapicMediaEntity objects
  */
 -(void)createThumbnailsFromMedia:(NSArray *)media;
+/**
+ *  Generate the thumbnails for an array of media and put them
+ *  at a position of the thumbnail list
+ *
+ *  @param media An array of OlapicMediaEntity objects
+ *  @param index The position of the first one
+ */
+-(void)insertThumbnailsFromMedia:(NSArray *)media atIndex:(NSUInteger)index;
 /**
  *  Updates the thumbnails position, using the current controller
  *  view size as reference
@@ -93,5 +145,18 @@
  *  @param pos The new position
  */
 -(void)changeImage:(OlapicAsyncImageView *)img atPosition:(CGPoint)pos;
+/**
+ *  Tell the thumbnails on the screen that they're displayed, so the
+ *  memory manager evicts the ones that are not visible first
+ */
+-(void)markVisibleThumbnails;
+/**
+ *  Show the detail screen of a media
+ *
+ *  @param media   The media, it must have a thumbnail (on the gallery, or the linked one)
+ *  @param current The detail screen it replaces when the user swipes
+ *  to a neighbour (or nil to open a new one)
+ */
+-(void)showDetailForMedia:(OlapicMediaEntity *)media replacing:(OlapicMediaViewController *)current;
 
 @end
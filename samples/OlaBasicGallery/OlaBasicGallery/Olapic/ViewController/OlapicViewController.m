@@ -30,10 +30,15 @@
 //  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 //  THE SOFTWARE.
 
+#import <QuartzCore/QuartzCore.h>
 #import "OlapicViewController.h"
 #import <OlapicSDK/OlapicSDK.h>
 #import "OlapicAsyncImageView.h"
 #import "OlapicMediaViewController.h"
+#import "OlapicNetworkClient.h"
+#import "OlapicSessionTransport.h"
+#import "OlapicFixtureTransport.h"
+#import "OlapicMediaStore.h"
 
 @interface OlapicViewController()
 /**
@@ -48,11 +53,24 @@
  *  @param size The size to use as reference
  */
 -(void)centerLoader:(CGSize)size;
+/**
+ *  Show the customer media with a new sorting. The media already
+ *  downloaded is shown right away, sorted by the media store, while
+ *  the new list loads its first page
+ *
+ *  @param control The sorting control
+ */
+-(void)sortingChanged:(UISegmentedControl *)control;
+/**
+ *  Load the media added since the gallery was loaded, and show
+ *  it before the rest
+ */
+-(void)refresh;
 
 @end
 
 @implementation OlapicViewController
-@synthesize loader,firstLoad,list,scroll,thumbnails;
+@synthesize loader,firstLoad,list,listController,bootstrap,prefetcher,listWindow,linkedOffset,scroll,thumbnails;
 /**
  *  Class constructor
  *
@@ -62,12 +80,16 @@
     self = [super init];
     if(self){
         scroll = [[UIScrollView alloc] initWithFrame:CGRectZero];
+        scroll.delegate = self;
         loader = [[UIActivityIndicatorView alloc] initWithFrame:CGRectZero];
         loader.activityIndicatorViewStyle = UIActivityIndicatorViewStyleGray;
         [self.view addSubview:scroll];
         [self.view addSubview:loader];
         firstLoad = NO;
         thumbnails = [[NSMutableArray alloc] init];
+        // Set it on the scheme arguments ('-OlapicLinkedOffset 5000') to
+        // open the media at that offset of the list
+        linkedOffset = MAX([[NSUserDefaults standardUserDefaults] integerForKey:@"OlapicLinkedOffset"], 0);
     }
     return self;
 }
@@ -88,11 +110,87 @@
         [loader startAnimating];
         // Set the API Key
         NSString *APIKey = @"<YOUR API KEY>";
+        // Let the network client sign the API requests it makes
+        [[OlapicNetworkClient sharedClient] setAuthKey:APIKey];
+        // Share the connections between all the thumbnails
+        id<OlapicNetworkTransport> transport = [[OlapicSessionTransport alloc] init];
+        // Record the responses for the performance tests (or replay them, without
+        // the network) with the scheme environment variables: OLAPIC_FIXTURE_MODE
+        // ('record' or 'replay'), OLAPIC_FIXTURES_PATH (Documents/Fixtures by default)
+        // and OLAPIC_MOCK_SERVER_URL (to use tools/olapic_mock_server.py)
+        NSDictionary *environment = [[NSProcessInfo processInfo] environment];
+        NSString *fixtureModeName = [[environment valueForKey:@"OLAPIC_FIXTURE_MODE"] lowercaseString];
+        OlapicFixtureTransportMode fixtureMode = OlapicFixtureTransportModePassthrough;
+        if([fixtureModeName isEqualToString:@"record"]){
+            fixtureMode = OlapicFixtureTransportModeRecord;
+        }else if([fixtureModeName isEqualToString:@"replay"]){
+            fixtureMode = OlapicFixtureTransportModeReplay;
+        }
+        NSString *mockServerURL = [environment valueForKey:@"OLAPIC_MOCK_SERVER_URL"];
+        if(fixtureMode != OlapicFixtureTransportModePassthrough || [mockServerURL length]){
+            NSString *fixturesPath = [environment valueForKey:@"OLAPIC_FIXTURES_PATH"];
+            if(![fixturesPath length]){
+                NSString *documents = [NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES) firstObject];
+                fixturesPath = [documents stringByAppendingPathComponent:@"Fixtures"];
+            }
+            OlapicFixtureTransport *fixtureTransport = [[OlapicFixtureTransport alloc] initWithTransport:transport fixturesPath:fixturesPath mode:fixtureMode];
+            if([mockServerURL length]) fixtureTransport.serverURL = [NSURL URLWithString:mockServerURL];
+            transport = fixtureTransport;
+        }
+        [[OlapicNetworkClient sharedClient] setTransport:transport];
         // Connect the SDK
         OlapicSDK *olapic = [OlapicSDK sharedOlapicSDK];
+        // Set a widget instance hash on the scheme arguments
+        // ('-OlapicWidgetInstanceHash <hash>') to show its media instead
+        // of the customer's
+        NSString *widgetInstanceHash = [[NSUserDefaults standardUserDefaults] stringForKey:@"OlapicWidgetInstanceHash"];
+        if([widgetInstanceHash length]){
+            // The bootstrap is kept by this object, so it can't keep it back
+            __weak OlapicViewController *weakSelf = self;
+            bootstrap = [[OlapicWidgetBootstrap alloc] initWithWidgetInstance:widgetInstanceHash authKey:APIKey delegate:self];
+            // The first page of each widget instance is kept for the next session
+            NSString *caches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+            bootstrap.cachePath = [caches stringByAppendingPathComponent:[NSString stringWithFormat:@"OlapicWidget-%@.cache", widgetInstanceHash]];
+            [bootstrap startOnReady:^(OlapicWidgetBootstrap *widget){
+                OlapicViewController *controller = weakSelf;
+                if(!controller) return;
+                controller->listController = widget.listController;
+                controller->listController.delegate = controller;
+            } onFailure:^(NSError *error){
+                UIAlertView *alert = [[UIAlertView alloc] initWithTitle:@"Error" message:error.description delegate:nil cancelButtonTitle:@"Accept" otherButtonTitles:nil];
+                [alert show];
+            }];
+            return;
+        }
         [olapic connectWithCustomerAuthKey:APIKey onSuccess:^(OlapicCustomerEntity *customer){
             list = [[OlapicCustomerMediaList alloc] initForCustomer:customer delegate:self sort:OlapicMediaListSortingTypePhotorank mediaPerPage:32];
-            [list startFetching];
+            listController = [[OlapicMediaListController alloc] initWithList:list];
+            listController.delegate = self;
+            // Show the first page from the last session while the new one loads
+            NSString *caches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+            listController.cachePath = [caches stringByAppendingPathComponent:@"OlapicGallery.cache"];
+            NSArray *cachedMedia = [listController getCachedMedia];
+            if([cachedMedia count]){
+                showingCachedMedia = YES;
+                [self createThumbnailsFromMedia:cachedMedia];
+                [self reorderThumbnails];
+                [loader stopAnimating];
+            }
+            [listController startFetching];
+            if(linkedOffset > 0){
+                // Jump to the page of the linked media
+                listWindow = [[OlapicMediaListWindow alloc] initWithListController:listController maxResidentPages:3];
+                listWindow.delegate = self;
+                [listWindow moveToOffset:linkedOffset];
+            }
+            // The sorting can be changed with the control on the navigation bar
+            UISegmentedControl *sortingControl = [[UISegmentedControl alloc] initWithItems:@[@"Recent", @"Photorank", @"Rated"]];
+            sortingControl.selectedSegmentIndex = 1;
+            [sortingControl addTarget:self action:@selector(sortingChanged:) forControlEvents:UIControlEventValueChanged];
+            self.navigationItem.titleView = sortingControl;
+            // The newest media can be loaded again, for the 'Recent' sorting
+            self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithBarButtonSystemItem:UIBarButtonSystemItemRefresh target:self action:@selector(refresh)];
+            self.navigationItem.rightBarButtonItem.enabled = NO;
         } onFailure:^(NSError *error){
             UIAlertView *alert = [[UIAlertView alloc] initWithTitle:@"Error" message:error.description delegate:nil cancelButtonTitle:@"Accept" otherButtonTitles:nil];
             [alert show];
@@ -107,6 +205,53 @@
 -(void)centerLoader{
     [self centerLoader:self.view.frame.size];
 }
+/**
+ *  Show the customer media with a new sorting. The media already
+ *  downloaded is shown right away, sorted by the media store, while
+ *  the new list loads its first page
+ *
+ *  @param control The sorting control
+ */
+-(void)sortingChanged:(UISegmentedControl *)control{
+    NSArray *sortings = @[@(OlapicMediaListSortingTypeRecent), @(OlapicMediaListSortingTypePhotorank), @(OlapicMediaListSortingTypeRated)];
+    OlapicMediaListSortingType sorting = [[sortings objectAtIndex:control.selectedSegmentIndex] integerValue];
+    OlapicCustomerEntity *customer = list.listCustomer;
+    if(!customer || sorting == list.sorting) return;
+    [prefetcher cancel];
+    prefetcher = nil;
+    [listController cancel];
+    [thumbnails makeObjectsPerformSelector:@selector(removeFromSuperview)];
+    [thumbnails removeAllObjects];
+    scroll.contentOffset = CGPointZero;
+    list = [[OlapicCustomerMediaList alloc] initForCustomer:customer delegate:self sort:sorting mediaPerPage:32];
+    listController = [[OlapicMediaListController alloc] initWithList:list];
+    listController.delegate = self;
+    self.navigationItem.rightBarButtonItem.enabled = NO;
+    // A first page of what was already downloaded, in the new order
+    NSArray *storedMedia = [[OlapicMediaStore sharedStore] mediaSortedLike:sorting];
+    if([storedMedia count] > (NSUInteger)list.mediaPerPage){
+        storedMedia = [storedMedia subarrayWithRange:NSMakeRange(0, list.mediaPerPage)];
+    }
+    showingCachedMedia = [storedMedia count] > 0;
+    if(showingCachedMedia){
+        [self createThumbnailsFromMedia:storedMedia];
+        [self reorderThumbnails];
+        [self markVisibleThumbnails];
+    }else{
+        [loader startAnimating];
+    }
+    [listController startFetching];
+}
+/**
+ *  Load the media added since the gallery was loaded, and show
+ *  it before the rest
+ */
+-(void)refresh{
+    if(![listController canLoadNewerMedia] || [listController fetching]) return;
+    // Until the controller says it's done
+    self.navigationItem.rightBarButtonItem.enabled = NO;
+    [listController loadNewerMedia];
+}
 /**
  *  Center the loading indicator with a given
  *  size as reference
@@ -123,14 +268,25 @@
  *  @param media An array of OlapicMediaEntity objects
  */
 -(void)createThumbnailsFromMedia:(NSArray *)media{
+    [self insertThumbnailsFromMedia:media atIndex:[thumbnails count]];
+}
+/**
+ *  Generate the thumbnails for an array of media and put them
+ *  at a position of the thumbnail list
+ *
+ *  @param media An array of OlapicMediaEntity objects
+ *  @param index The position of the first one
+ */
+-(void)insertThumbnailsFromMedia:(NSArray *)media atIndex:(NSUInteger)index{
+    // The thumbnails don't keep the gallery alive, so dealloc can cancel the list
+    __weak OlapicViewController *weakSelf = self;
     for (int i = 0; i < [media count]; i++){
         OlapicAsyncImageView *thumb = [[OlapicAsyncImageView alloc] initWithMedia:[media objectAtIndex:i] callback:^(OlapicAsyncImageView *image){
-            OlapicMediaViewController *mediaController = [[OlapicMediaViewController alloc] initWithImage:image];
-            [self.navigationController pushViewController:mediaController animated:YES];
+            [weakSelf showDetailForMedia:image.media replacing:nil];
         } andFrame:CGRectMake(0, 0, 74, 74)];
-        [thumbnails addObject:thumb];
+        [thumbnails insertObject:thumb atIndex:index + i];
         [scroll addSubview:thumb];
-        [thumb download];
+        [listController addDependentTask:[thumb download]];
     }
 }
 /**
@@ -211,6 +367,37 @@
 }
 
 #pragma mark - Default cycle
+/**
+ *  Resume the list requests when the gallery is visible again
+ *
+ *  @param animated If the transition is animated
+ */
+-(void)viewWillAppear:(BOOL)animated{
+    [super viewWillAppear:animated];
+    [listController resume];
+}
+/**
+ *  Suspend the list requests while the gallery is not visible. Not
+ *  when it's covered by a detail screen: the prefetcher loads the
+ *  next pages of the list from there
+ *
+ *  @param animated If the transition is animated
+ */
+-(void)viewDidDisappear:(BOOL)animated{
+    [super viewDidDisappear:animated];
+    if([self.navigationController.topViewController isKindOfClass:[OlapicMediaViewController class]]) return;
+    [listController suspend];
+}
+/**
+ *  Cancel the list, and the thumbnails, when the gallery goes away
+ */
+-(void)dealloc{
+    scroll.delegate = nil;
+    [bootstrap cancel];
+    [prefetcher cancel];
+    [listWindow cancel];
+    [listController cancel];
+}
 /**
  *  When the app is rotating to a new orientation, this method will resize the UI
  *  using a CGSize with the values inverted (the vc width as height and the heigth
@@ -238,6 +425,108 @@
 -(void)didRotateFromInterfaceOrientation:(UIInterfaceOrientation)fromInterfaceOrientation{
     [self reorderThumbnails];
     [self centerLoader];
+    [self markVisibleThumbnails];
+}
+#pragma mark - Scroll Delegate
+/**
+ *  The thumbnails on the screen changed
+ *
+ *  @param scrollView The scroll view
+ */
+-(void)scrollViewDidScroll:(UIScrollView *)scrollView{
+    [self markVisibleThumbnails];
+}
+/**
+ *  Tell the thumbnails on the screen that they're displayed, so the
+ *  memory manager evicts the ones that are not visible first
+ */
+-(void)markVisibleThumbnails{
+    CGRect visible = scroll.bounds;
+    for(OlapicAsyncImageView *thumb in thumbnails){
+        if(CGRectIntersectsRect(thumb.frame, visible)){
+            [thumb markDisplayed];
+        }
+    }
+}
+
+/**
+ *  Show the detail screen of a media
+ *
+ *  @param media   The media, it must have a thumbnail
+ *  @param current The detail screen it replaces when the user swipes
+ *  to a neighbour (or nil to open a new one)
+ */
+-(void)showDetailForMedia:(OlapicMediaEntity *)media replacing:(OlapicMediaViewController *)current{
+    OlapicAsyncImageView *thumb = nil;
+    NSUInteger thumbIndex = NSNotFound;
+    for(NSUInteger i = 0; i < [thumbnails count]; i++){
+        OlapicAsyncImageView *candidate = [thumbnails objectAtIndex:i];
+        if(candidate.media == media){
+            thumb = candidate;
+            thumbIndex = i;
+            break;
+        }
+    }
+    if(!thumb && linkedThumb.media == media) thumb = linkedThumb;
+    if(!thumb) return;
+    // The prefetcher follows the list that's currently loaded
+    if(!prefetcher || prefetcher.listController != listController){
+        [prefetcher cancel];
+        prefetcher = [[OlapicMediaPrefetcher alloc] initWithListController:listController];
+    }
+    [thumb markDisplayed];
+    OlapicMediaViewController *mediaController = [[OlapicMediaViewController alloc] initWithImage:thumb prefetcher:prefetcher];
+    __weak OlapicViewController *weakSelf = self;
+    mediaController.neighbourCallback = ^(OlapicMediaViewController *controller, OlapicMediaEntity *neighbour){
+        [weakSelf showDetailForMedia:neighbour replacing:controller];
+    };
+    NSMutableArray *controllers = [self.navigationController.viewControllers mutableCopy];
+    NSUInteger currentIndex = current ? [controllers indexOfObjectIdenticalTo:current] : NSNotFound;
+    if(currentIndex == NSNotFound){
+        [self.navigationController pushViewController:mediaController animated:YES];
+        return;
+    }
+    // Slide the new media in from the side the user swiped to
+    BOOL forward = thumbIndex > [thumbnails indexOfObjectIdenticalTo:current.mimage];
+    CATransition *transition = [CATransition animation];
+    transition.type = kCATransitionPush;
+    transition.subtype = forward ? kCATransitionFromRight : kCATransitionFromLeft;
+    transition.duration = 0.25;
+    [self.navigationController.view.layer addAnimation:transition forKey:nil];
+    [controllers replaceObjectAtIndex:currentIndex withObject:mediaController];
+    [self.navigationController setViewControllers:controllers animated:NO];
+}
+
+#pragma mark - Window Delegate
+/**
+ *  A page of the list window was loaded. When it has the linked
+ *  media, its detail screen is opened
+ *
+ *  @param window The window object
+ *  @param media  A list with the loaded media objects
+ *  @param offset The offset of the first media of the page
+ */
+-(void)OlapicMediaListWindow:(OlapicMediaListWindow *)window didLoadMedia:(NSArray *)media atOffset:(NSInteger)offset{
+    OlapicMediaEntity *linked = [window mediaAtOffset:linkedOffset];
+    if(!linked || linkedThumb) return;
+    linkedThumb = [[OlapicAsyncImageView alloc] initWithMedia:linked callback:nil andFrame:CGRectMake(0, 0, 74, 74)];
+    [listController addDependentTask:[linkedThumb download]];
+    [self showDetailForMedia:linked replacing:nil];
+    // The window was only needed to find it
+    [listWindow cancel];
+    listWindow = nil;
+}
+/**
+ *  A page of the list window couldn't be loaded
+ *
+ *  @param window The window object
+ *  @param error  The error containing the reason why the request failed
+ *  @param offset The offset of the first media of the page
+ */
+-(void)OlapicMediaListWindow:(OlapicMediaListWindow *)window didReceiveAnError:(NSError *)error atOffset:(NSInteger)offset{
+    if(linkedOffset < offset || linkedOffset >= offset + window.list.mediaPerPage) return;
+    UIAlertView *alert = [[UIAlertView alloc] initWithTitle:@"Error" message:error.description delegate:nil cancelButtonTitle:@"Accept" otherButtonTitles:nil];
+    [alert show];
 }
 
 #pragma mark - List Delegate
@@ -249,9 +538,16 @@
  *  @param links     The links to the API from where this media objects were downloaded
  */
 -(void)OlapicMediaList:(OlapicMediaList *)mediaList didLoadMedia:(NSArray *)media withLinks:(NSDictionary *)links{
+    if(showingCachedMedia){
+        // The real first page replaces the cached one
+        showingCachedMedia = NO;
+        [thumbnails makeObjectsPerformSelector:@selector(removeFromSuperview)];
+        [thumbnails removeAllObjects];
+    }
     [self createThumbnailsFromMedia:media];
     [self reorderThumbnails];
     [loader stopAnimating];
+    self.navigationItem.rightBarButtonItem.enabled = [listController canLoadNewerMedia];
 }
 /**
  *  In case the media list object finds an error while downloading the content
@@ -263,4 +559,28 @@
     NSLog(@"LIST ERROR : %@",error);
 }
 
+#pragma mark - List Controller Delegate
+/**
+ *  The media added since the list was loaded, it goes before the rest
+ *
+ *  @param controller The list controller
+ *  @param media      An array of media objects (empty if there's nothing new)
+ */
+-(void)OlapicMediaListController:(OlapicMediaListController *)controller didLoadNewerMedia:(NSArray *)media{
+    self.navigationItem.rightBarButtonItem.enabled = [controller canLoadNewerMedia];
+    if(![media count]) return;
+    [self insertThumbnailsFromMedia:media atIndex:0];
+    [self reorderThumbnails];
+    [self markVisibleThumbnails];
+}
+/**
+ *  The media added since the list was loaded couldn't be downloaded
+ *
+ *  @param controller The list controller
+ *  @param error      The error it found
+ */
+-(void)OlapicMediaListController:(OlapicMediaListController *)controller didFailToLoadNewerMediaWithError:(NSError *)error{
+    self.navigationItem.rightBarButtonItem.enabled = [controller canLoadNewerMedia];
+}
+
 @end
\ No newline at end of file
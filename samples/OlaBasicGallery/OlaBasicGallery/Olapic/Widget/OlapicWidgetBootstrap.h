@@ -0,0 +1,214 @@
+//
+//  OlapicWidgetBootstrap.h
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <OlapicSDK/OlapicSDK.h>
+#import "OlapicMediaListController.h"
+/**
+ *  The bootstrap stages, used to read their timing
+ */
+extern NSString * const OlapicWidgetBootstrapStageConnect;
+extern NSString * const OlapicWidgetBootstrapStageSource;
+extern NSString * const OlapicWidgetBootstrapStageFirstPage;
+extern NSString * const OlapicWidgetBootstrapStageThumbnails;
+extern NSString * const OlapicWidgetBootstrapStageTotal;
+/**
+ *  Loads everything a widget instance needs to be shown, overlapping
+ *  the requests as much as possible:
+ *
+ *  1. Connect the SDK to the widget instance
+ *  2. Get its stream or category. If it came embedded there's no
+ *     request, and if the widget instance links to the media with its
+ *     sorting, the first page is requested at the same time
+ *  3. Load the first page with the list controller (so it uses its
+ *     fieldSelection and cachePath), using the widget instance
+ *     sorting. A shuffled widget keeps the server shuffle, and its
+ *     list puts each page in the stable order of the session seed
+ *  4. Download the first page thumbnails (all at the same time, with
+ *     a high priority), so the gallery requests for them, queued
+ *     after these, find them on the URL cache
+ *
+ *  The ready callback is called as soon as the first page is parsed,
+ *  right before the list gets it and its delegate gets the media; the
+ *  thumbnails keep downloading after that. The time each stage took
+ *  is saved.
+ */
+@interface OlapicWidgetBootstrap : NSObject{
+    /**
+     *  The widget instance hash
+     */
+    NSString *widgetInstanceHash;
+    /**
+     *  The API key
+     */
+    NSString *authKey;
+    /**
+     *  The delegate for the media list
+     */
+    __weak id<OlapicMediaListDelegate> delegate;
+    /**
+     *  The number of media per page
+     */
+    NSInteger mediaPerPage;
+    /**
+     *  The size of the thumbnails, to download the same image size they'll use
+     */
+    CGSize thumbnailSize;
+    /**
+     *  The widget instance
+     */
+    OlapicWidgetInstanceEntity *widgetInstance;
+    /**
+     *  The widget instance stream (OlapicStreamEntity) or category (OlapicCategoryEntity)
+     */
+    OlapicEntity *source;
+    /**
+     *  The media list
+     */
+    OlapicMediaList *list;
+    /**
+     *  The object that loads the list
+     */
+    OlapicMediaListController *listController;
+    /**
+     *  The media fields the list needs (optional, all of them by default)
+     */
+    OlapicMediaFieldSelection *fieldSelection;
+    /**
+     *  Where the list saves its first page (optional)
+     */
+    NSString *cachePath;
+    /**
+     *  The first page of the list
+     */
+    NSDictionary *firstPage;
+    /**
+     *  When each stage started, since the bootstrap started
+     */
+    NSMutableDictionary *stageStarts;
+    /**
+     *  When each stage ended, since the bootstrap started
+     */
+    NSMutableDictionary *stageEnds;
+    /**
+     *  When the bootstrap started
+     */
+    CFAbsoluteTime startTime;
+    /**
+     *  The running requests
+     */
+    NSMutableArray *tasks;
+    /**
+     *  The number of thumbnails still downloading
+     */
+    NSUInteger pendingThumbnails;
+    /**
+     *  If the bootstrap was cancelled
+     */
+    BOOL cancelled;
+    /**
+     *  The callback for when everything is ready
+     */
+    void (^readyCallback)(OlapicWidgetBootstrap *bootstrap);
+    /**
+     *  The callback for when the bootstrap fails
+     */
+    void (^failureCallback)(NSError *error);
+}
+
+@property (nonatomic,strong,readonly) NSString *widgetInstanceHash;
+@property (nonatomic) NSInteger mediaPerPage;
+@property (nonatomic) CGSize thumbnailSize;
+@property (nonatomic,strong) OlapicMediaFieldSelection *fieldSelection;
+@property (nonatomic,copy) NSString *cachePath;
+@property (nonatomic,strong,readonly) OlapicWidgetInstanceEntity *widgetInstance;
+@property (nonatomic,strong,readonly) OlapicEntity *source;
+@property (nonatomic,strong,readonly) OlapicMediaList *list;
+@property (nonatomic,strong,readonly) OlapicMediaListController *listController;
+/**
+ *  Class constructor
+ *
+ *  @param hash         The widget instance hash
+ *  @param key          The API key
+ *  @param listDelegate The delegate for the media list
+ *
+ *  @return An instance of this object (OlapicWidgetBootstrap)
+ */
+-(id)initWithWidgetInstance:(NSString *)hash authKey:(NSString *)key delegate:(id<OlapicMediaListDelegate>)listDelegate;
+/**
+ *  Start loading
+ *
+ *  @param ready   A callback for when the first page is ready, before the list delegate gets it
+ *  @param failure A callback for when something fails
+ */
+-(void)startOnReady:(void (^)(OlapicWidgetBootstrap *bootstrap))ready onFailure:(void (^)(NSError *error))failure;
+/**
+ *  Cancel the requests. No callback will be called. Once the bootstrap
+ *  is ready, the list controller belongs to the caller and it's not
+ *  cancelled
+ */
+-(void)cancel;
+/**
+ *  Get how long a stage took
+ *
+ *  @param stage The stage (like OlapicWidgetBootstrapStageConnect)
+ *
+ *  @return The duration in seconds, or 0 if the stage didn't end
+ */
+-(NSTimeInterval)durationOfStage:(NSString *)stage;
+/**
+ *  Get the duration of all the stages that ended
+ *
+ *  @return A dictionary with the durations (NSNumber, in seconds) by stage
+ */
+-(NSDictionary *)stageDurations;
+
+@end
+/**
+ *  The bootstrap as part of the widget instances handler
+ */
+@interface OlapicWidgetInstanceHandler (Bootstrap)
+/**
+ *  Load a widget instance with its first page of media, and start
+ *  downloading its thumbnails
+ *
+ *  @param hash     The widget instance hash
+ *  @param key      The API key
+ *  @param delegate The delegate for the media list
+ *  @param ready    A callback for when the first page is ready, before the list delegate gets it
+ *  @param failure  A callback for when something fails
+ *
+ *  @return The bootstrap, so it can be cancelled
+ */
+-(OlapicWidgetBootstrap *)bootstrapWidgetInstance:(NSString *)hash authKey:(NSString *)key delegate:(id<OlapicMediaListDelegate>)delegate onReady:(void (^)(OlapicWidgetBootstrap *bootstrap))ready onFailure:(void (^)(NSError *error))failure;
+
+@end
\ No newline at end of file
@@ -0,0 +1,488 @@
+//
+//  OlapicWidgetBootstrap.m
+//  OlaBasicGallery
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicWidgetBootstrap.h"
+#import "OlapicNetworkClient.h"
+#import "OlapicPayloadDecoder.h"
+#import "OlapicIdentityMap.h"
+#import "OlapicImageSizeSelector.h"
+#import "OlapicSearchIndex.h"
+
+NSString * const OlapicWidgetBootstrapStageConnect = @"connect";
+NSString * const OlapicWidgetBootstrapStageSource = @"source";
+NSString * const OlapicWidgetBootstrapStageFirstPage = @"firstPage";
+NSString * const OlapicWidgetBootstrapStageThumbnails = @"thumbnails";
+NSString * const OlapicWidgetBootstrapStageTotal = @"total";
+
+@interface OlapicWidgetBootstrap()
+/**
+ *  Find the widget instance stream or category, and start loading
+ *  the first page as soon as its URL is known
+ */
+-(void)resolveSource;
+/**
+ *  Request the widget instance stream or category
+ *
+ *  @param URL     The resource URL
+ *  @param handler The SDK handler for the resource type
+ */
+-(void)loadSourceFromURL:(NSString *)URL withHandler:(OlapicHandler *)handler;
+/**
+ *  Create the media list for the source entity
+ */
+-(void)createListFromSource;
+/**
+ *  Create the media list before the source arrives, using a media link
+ *
+ *  @param sourceURL The URL of the stream or category
+ *  @param mediaURL  The URL of its media
+ *  @param stream    If the source is a stream (or a category)
+ */
+-(void)createListFromSourceURL:(NSString *)sourceURL mediaURL:(NSString *)mediaURL stream:(BOOL)stream;
+/**
+ *  Create the controller for the list
+ *
+ *  @param shuffled If the list pages should be put in a stable shuffled order
+ */
+-(void)createListController:(BOOL)shuffled;
+/**
+ *  Get the widget instance link to its media with its sorting
+ *
+ *  @return The URL, or nil if there's no such link
+ */
+-(NSString *)mediaURLForSorting;
+/**
+ *  Request the first page of the list with the list controller
+ */
+-(void)loadFirstPage;
+/**
+ *  Download the first page thumbnails
+ */
+-(void)prefetchThumbnails;
+/**
+ *  A thumbnail finished downloading (or failed)
+ */
+-(void)thumbnailDidFinish;
+/**
+ *  Call the ready callback, before the list gets the first page
+ */
+-(void)finish;
+/**
+ *  Cancel everything and call the failure callback
+ *
+ *  @param error The error
+ */
+-(void)failWithError:(NSError *)error;
+/**
+ *  Save the start time of a stage
+ *
+ *  @param stage The stage
+ */
+-(void)beginStage:(NSString *)stage;
+/**
+ *  Save the end time of a stage
+ *
+ *  @param stage The stage
+ */
+-(void)endStage:(NSString *)stage;
+/**
+ *  Get the URL of a link
+ *
+ *  @param name   The link name
+ *  @param entity The entity with the links
+ *
+ *  @return The URL, or nil if the link doesn't exist
+ */
++(NSString *)URLForLink:(NSString *)name inEntity:(OlapicEntity *)entity;
+
+@end
+
+@implementation OlapicWidgetBootstrap
+
+@synthesize widgetInstanceHash,mediaPerPage,thumbnailSize,fieldSelection,cachePath,widgetInstance,source,list,listController;
+/**
+ *  Class constructor
+ *
+ *  @param hash         The widget instance hash
+ *  @param key          The API key
+ *  @param listDelegate The delegate for the media list
+ *
+ *  @return An instance of this object (OlapicWidgetBootstrap)
+ */
+-(id)initWithWidgetInstance:(NSString *)hash authKey:(NSString *)key delegate:(id<OlapicMediaListDelegate>)listDelegate{
+    self = [super init];
+    if(self){
+        widgetInstanceHash = hash;
+        authKey = key;
+        delegate = listDelegate;
+        mediaPerPage = 32;
+        thumbnailSize = CGSizeMake(74, 74);
+        stageStarts = [[NSMutableDictionary alloc] init];
+        stageEnds = [[NSMutableDictionary alloc] init];
+        tasks = [[NSMutableArray alloc] init];
+        cancelled = NO;
+    }
+    return self;
+}
+/**
+ *  Start loading
+ *
+ *  @param ready   A callback for when the first page is ready, before the list delegate gets it
+ *  @param failure A callback for when something fails
+ */
+-(void)startOnReady:(void (^)(OlapicWidgetBootstrap *bootstrap))ready onFailure:(void (^)(NSError *error))failure{
+    readyCallback = ready;
+    failureCallback = failure;
+    startTime = CFAbsoluteTimeGetCurrent();
+    [self beginStage:OlapicWidgetBootstrapStageTotal];
+    [self beginStage:OlapicWidgetBootstrapStageConnect];
+    [[OlapicNetworkClient sharedClient] setAuthKey:authKey];
+    [[OlapicSDK sharedOlapicSDK] connectWithCustomerAuthKey:authKey onSuccess:^(NSDictionary *response){
+        if(cancelled) return;
+        [self endStage:OlapicWidgetBootstrapStageConnect];
+        for(id value in [response allValues]){
+            if([value isKindOfClass:[OlapicWidgetInstanceEntity class]]){
+                widgetInstance = value;
+            }
+        }
+        if(!widgetInstance){
+            [self failWithError:[NSError errorWithDomain:OlapicNetworkErrorDomain code:OlapicNetworkErrorInvalidResponse userInfo:@{NSLocalizedDescriptionKey: @"The widget instance wasn't found"}]];
+            return;
+        }
+        [self resolveSource];
+    } onFailure:^(NSError *error){
+        if(cancelled) return;
+        [self failWithError:error];
+    } toEndpoint:OlapicEndpointTypeWidgetInstance withParameters:@{@"widget_instance": widgetInstanceHash}];
+}
+/**
+ *  Find the widget instance stream or category, and start loading
+ *  the first page as soon as its URL is known
+ */
+-(void)resolveSource{
+    OlapicSDK *olapic = [OlapicSDK sharedOlapicSDK];
+    [self beginStage:OlapicWidgetBootstrapStageSource];
+    for(NSString *type in @[@"stream", @"category"]){
+        OlapicHandler *handler = [type isEqualToString:@"stream"] ? (OlapicHandler *)[olapic streams] : (OlapicHandler *)[olapic categories];
+        NSDictionary *embedded = [widgetInstance get:[NSString stringWithFormat:@"_embedded/%@",type]];
+        if([embedded isKindOfClass:[NSDictionary class]]){
+            // No request needed
+            source = [[OlapicIdentityMap sharedMap] entityFromJSON:embedded withHandler:handler];
+            if(source) [[OlapicSearchIndex sharedIndex] addEntities:@[source]];
+            [self endStage:OlapicWidgetBootstrapStageSource];
+            [self createListFromSource];
+            [self loadFirstPage];
+            return;
+        }
+        NSString *sourceURL = [OlapicWidgetBootstrap URLForLink:type inEntity:widgetInstance];
+        if(sourceURL){
+            NSString *mediaURL = [self mediaURLForSorting];
+            if(mediaURL){
+                // The first page doesn't need to wait for the source
+                [self createListFromSourceURL:sourceURL mediaURL:mediaURL stream:[type isEqualToString:@"stream"]];
+                [self loadFirstPage];
+            }
+            [self loadSourceFromURL:sourceURL withHandler:handler];
+            return;
+        }
+    }
+    [self failWithError:[NSError errorWithDomain:OlapicNetworkErrorDomain code:OlapicNetworkErrorInvalidResponse userInfo:@{NSLocalizedDescriptionKey: @"The widget instance doesn't have a stream or a category"}]];
+}
+/**
+ *  Request the widget instance stream or category
+ *
+ *  @param URL     The resource URL
+ *  @param handler The SDK handler for the resource type
+ */
+-(void)loadSourceFromURL:(NSString *)URL withHandler:(OlapicHandler *)handler{
+    OlapicNetworkTask *task = [[OlapicNetworkClient sharedClient] getObject:URL parameters:nil priority:OlapicRequestPriorityHigh processing:^id(NSData *responseData, NSError **error){
+        id JSON = [OlapicPayloadDecoder objectWithData:responseData error:error];
+        NSDictionary *data = [JSON isKindOfClass:[NSDictionary class]] ? [JSON valueForKey:@"data"] : nil;
+        if(![data isKindOfClass:[NSDictionary class]]){
+            if(error && !*error){
+                *error = [NSError errorWithDomain:OlapicNetworkErrorDomain code:OlapicNetworkErrorInvalidResponse userInfo:@{NSLocalizedDescriptionKey: @"The API response is not valid"}];
+            }
+            return nil;
+        }
+        return [[OlapicIdentityMap sharedMap] entityFromJSON:data withHandler:handler];
+    } onSuccess:^(OlapicEntity *entity){
+        source = entity;
+        if(source) [[OlapicSearchIndex sharedIndex] addEntities:@[source]];
+        [self endStage:OlapicWidgetBootstrapStageSource];
+        if(!list){
+            [self createListFromSource];
+            [self loadFirstPage];
+        }else if([list isKindOfClass:[OlapicStreamMediaList class]] && [source isKindOfClass:[OlapicStreamEntity class]]){
+            [(OlapicStreamMediaList *)list setListStream:(OlapicStreamEntity *)source];
+        }else if([list isKindOfClass:[OlapicCategoryMediaList class]] && [source isKindOfClass:[OlapicCategoryEntity class]]){
+            [(OlapicCategoryMediaList *)list setListCategory:(OlapicCategoryEntity *)source];
+        }
+    } onFailure:^(NSError *error){
+        [self failWithError:error];
+    }];
+    if(task) [tasks addObject:task];
+}
+/**
+ *  Create the media list for the source entity
+ */
+-(void)createListFromSource{
+    OlapicMediaListSortingType sorting = [widgetInstance getSorting];
+    // The server shuffle changes on every request, the device keeps it stable
+    BOOL shuffled = sorting == OlapicMediaListSortingTypeShuffled;
+    if([source isKindOfClass:[OlapicStreamEntity class]]){
+        list = [[OlapicStreamMediaList alloc] initForStream:(OlapicStreamEntity *)source delegate:delegate sort:sorting mediaPerPage:mediaPerPage];
+    }else{
+        list = [[OlapicCategoryMediaList alloc] initForCategory:(OlapicCategoryEntity *)source delegate:delegate sort:sorting mediaPerPage:mediaPerPage];
+    }
+    [self createListController:shuffled];
+}
+/**
+ *  Create the media list before the source arrives, using a media link
+ *
+ *  @param sourceURL The URL of the stream or category
+ *  @param mediaURL  The URL of its media
+ *  @param stream    If the source is a stream (or a category)
+ */
+-(void)createListFromSourceURL:(NSString *)sourceURL mediaURL:(NSString *)mediaURL stream:(BOOL)stream{
+    NSString *sourceId = [[NSURL URLWithString:[sourceURL hasPrefix:@"//"] ? [@"https:" stringByAppendingString:sourceURL] : sourceURL] lastPathComponent];
+    BOOL shuffled = [widgetInstance getSorting] == OlapicMediaListSortingTypeShuffled;
+    if(stream){
+        list = [[OlapicStreamMediaList alloc] initWithStreamId:sourceId delegate:delegate andURL:mediaURL mediaPerPage:mediaPerPage];
+    }else{
+        list = [[OlapicCategoryMediaList alloc] initWithCategoryId:sourceId delegate:delegate andURL:mediaURL mediaPerPage:mediaPerPage];
+    }
+    [self createListController:shuffled];
+}
+/**
+ *  Create the controller for the list
+ *
+ *  @param shuffled If the list pages should be put in a stable shuffled order
+ */
+-(void)createListController:(BOOL)shuffled{
+    listController = [[OlapicMediaListController alloc] initWithList:list];
+    listController.fieldSelection = fieldSelection;
+    listController.cachePath = cachePath;
+    if(shuffled) listController.shuffle = [[OlapicMediaShuffle alloc] initWithSeed:[OlapicMediaShuffle sessionSeed]];
+}
+/**
+ *  Get the widget instance link to its media with its sorting
+ *
+ *  @return The URL, or nil if there's no such link
+ */
+-(NSString *)mediaURLForSorting{
+    NSString *name = nil;
+    switch([widgetInstance getSorting]){
+        case OlapicMediaListSortingTypeShuffled:
+            name = @"media:shuffled";
+            break;
+        case OlapicMediaListSortingTypePhotorank:
+            name = @"media:photorank";
+            break;
+        case OlapicMediaListSortingTypeRated:
+            name = @"media:rated";
+            break;
+        default:
+            name = @"media:recent";
+            break;
+    }
+    // A media link with another sorting would load the wrong order, so
+    // without this one the list waits for the source
+    NSString *URL = [OlapicWidgetBootstrap URLForLink:name inEntity:widgetInstance];
+    return URL ? URL : [OlapicWidgetBootstrap URLForLink:@"media" inEntity:widgetInstance];
+}
+/**
+ *  Request the first page of the list with the list controller
+ */
+-(void)loadFirstPage{
+    [self beginStage:OlapicWidgetBootstrapStageFirstPage];
+    [listController startFetchingOnFirstPage:^(NSDictionary *page){
+        if(cancelled) return;
+        firstPage = page;
+        [self endStage:OlapicWidgetBootstrapStageFirstPage];
+        [self prefetchThumbnails];
+        [self finish];
+    } onFailure:^(NSError *error){
+        [self failWithError:error];
+    }];
+}
+/**
+ *  Download the first page thumbnails
+ */
+-(void)prefetchThumbnails{
+    [self beginStage:OlapicWidgetBootstrapStageThumbnails];
+    NSArray *media = [firstPage valueForKey:@"media"];
+    pendingThumbnails = [media count];
+    if(!pendingThumbnails){
+        [self endStage:OlapicWidgetBootstrapStageThumbnails];
+        return;
+    }
+    for(OlapicMediaEntity *item in media){
+        // The same size the thumbnails will ask for
+        OlapicMediaImageSize size = [OlapicImageSizeSelector imageSizeForMedia:item fittingSize:thumbnailSize allowingCrop:NO];
+        OlapicNetworkTask *task = [[OlapicNetworkClient sharedClient] getData:[item getMediaURLForImageSize:size] parameters:nil priority:OlapicRequestPriorityHigh onSuccess:^(NSData *responseData){
+            [self thumbnailDidFinish];
+        } onFailure:^(NSError *error){
+            // A missing thumbnail doesn't stop the widget
+            [self thumbnailDidFinish];
+        }];
+        if(task) [tasks addObject:task];
+    }
+}
+/**
+ *  A thumbnail finished downloading (or failed)
+ */
+-(void)thumbnailDidFinish{
+    if(cancelled || !pendingThumbnails) return;
+    pendingThumbnails--;
+    if(!pendingThumbnails){
+        [self endStage:OlapicWidgetBootstrapStageThumbnails];
+        [tasks removeAllObjects];
+    }
+}
+/**
+ *  Call the ready callback, before the list gets the first page
+ */
+-(void)finish{
+    [self endStage:OlapicWidgetBootstrapStageTotal];
+    void (^ready)(OlapicWidgetBootstrap *bootstrap) = readyCallback;
+    readyCallback = nil;
+    failureCallback = nil;
+    // The list controller adds the page when this returns, so the
+    // callback can take it before the delegate gets the media
+    if(ready) ready(self);
+}
+/**
+ *  Cancel everything and call the failure callback
+ *
+ *  @param error The error
+ */
+-(void)failWithError:(NSError *)error{
+    if(cancelled) return;
+    void (^failure)(NSError *error) = failureCallback;
+    [self cancel];
+    if(failure) failure(error);
+}
+/**
+ *  Cancel the requests. No callback will be called. Once the bootstrap
+ *  is ready, the list controller belongs to the caller and it's not
+ *  cancelled
+ */
+-(void)cancel{
+    if(cancelled) return;
+    cancelled = YES;
+    for(OlapicNetworkTask *task in tasks){
+        [task cancel];
+    }
+    [tasks removeAllObjects];
+    // Once it's ready, the list belongs to the caller
+    if(!firstPage) [listController cancel];
+    readyCallback = nil;
+    failureCallback = nil;
+}
+/**
+ *  Save the start time of a stage
+ *
+ *  @param stage The stage
+ */
+-(void)beginStage:(NSString *)stage{
+    [stageStarts setObject:[NSNumber numberWithDouble:CFAbsoluteTimeGetCurrent() - startTime] forKey:stage];
+}
+/**
+ *  Save the end time of a stage
+ *
+ *  @param stage The stage
+ */
+-(void)endStage:(NSString *)stage{
+    [stageEnds setObject:[NSNumber numberWithDouble:CFAbsoluteTimeGetCurrent() - startTime] forKey:stage];
+}
+/**
+ *  Get how long a stage took
+ *
+ *  @param stage The stage (like OlapicWidgetBootstrapStageConnect)
+ *
+ *  @return The duration in seconds, or 0 if the stage didn't end
+ */
+-(NSTimeInterval)durationOfStage:(NSString *)stage{
+    NSNumber *end = [stageEnds objectForKey:stage];
+    if(!end) return 0;
+    return [end doubleValue] - [[stageStarts objectForKey:stage] doubleValue];
+}
+/**
+ *  Get the duration of all the stages that ended
+ *
+ *  @return A dictionary with the durations (NSNumber, in seconds) by stage
+ */
+-(NSDictionary *)stageDurations{
+    NSMutableDictionary *durations = [[NSMutableDictionary alloc] init];
+    for(NSString *stage in stageEnds){
+        [durations setObject:[NSNumber numberWithDouble:[self durationOfStage:stage]] forKey:stage];
+    }
+    return durations;
+}
+/**
+ *  Get the URL of a link
+ *
+ *  @param name   The link name
+ *  @param entity The entity with the links
+ *
+ *  @return The URL, or nil if the link doesn't exist
+ */
++(NSString *)URLForLink:(NSString *)name inEntity:(OlapicEntity *)entity{
+    id link = [[entity get:@"_links"] valueForKey:name];
+    if([link isKindOfClass:[NSDictionary class]]){
+        link = [link valueForKey:@"href"];
+    }
+    return [link isKindOfClass:[NSString class]] && [link length] ? link : nil;
+}
+
+@end
+
+@implementation OlapicWidgetInstanceHandler (Bootstrap)
+/**
+ *  Load a widget instance with its first page of media, and start
+ *  downloading its thumbnails
+ *
+ *  @param hash     The widget instance hash
+ *  @param key      The API key
+ *  @param delegate The delegate for the media list
+ *  @param ready    A callback for when the first page is ready, before the list delegate gets it
+ *  @param failure  A callback for when something fails
+ *
+ *  @return The bootstrap, so it can be cancelled
+ */
+-(OlapicWidgetBootstrap *)bootstrapWidgetInstance:(NSString *)hash authKey:(NSString *)key delegate:(id<OlapicMediaListDelegate>)delegate onReady:(void (^)(OlapicWidgetBootstrap *bootstrap))ready onFailure:(void (^)(NSError *error))failure{
+    OlapicWidgetBootstrap *bootstrap = [[OlapicWidgetBootstrap alloc] initWithWidgetInstance:hash authKey:key delegate:delegate];
+    [bootstrap startOnReady:ready onFailure:failure];
+    return bootstrap;
+}
+
+@end
\ No newline at end of file
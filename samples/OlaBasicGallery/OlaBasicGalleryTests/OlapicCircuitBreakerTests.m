@@ -0,0 +1,113 @@
+//
+//  OlapicCircuitBreakerTests.m
+//  OlaBasicGalleryTests
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OlapicCircuitBreaker.h"
+
+@interface OlapicCircuitBreakerTests : XCTestCase{
+    OlapicCircuitBreaker *breaker;
+}
+
+@end
+
+@implementation OlapicCircuitBreakerTests
+
+- (void)setUp
+{
+    [super setUp];
+    breaker = [[OlapicCircuitBreaker alloc] initWithEndpoint:@"test"];
+    breaker.failureThreshold = 3;
+}
+
+- (void)openBreaker
+{
+    for(NSInteger i = 0; i < breaker.failureThreshold; i++){
+        [breaker recordFailure];
+    }
+}
+
+- (void)testOpensAfterTheThreshold
+{
+    XCTAssertTrue([breaker allowsRequest]);
+    [breaker recordFailure];
+    [breaker recordFailure];
+    XCTAssertEqual(breaker.state, OlapicCircuitStateClosed);
+    [breaker recordFailure];
+    XCTAssertEqual(breaker.state, OlapicCircuitStateOpen);
+    XCTAssertFalse([breaker allowsRequest]);
+}
+
+- (void)testSuccessResetsTheFailures
+{
+    [breaker recordFailure];
+    [breaker recordFailure];
+    [breaker recordSuccess];
+    [breaker recordFailure];
+    [breaker recordFailure];
+    XCTAssertEqual(breaker.state, OlapicCircuitStateClosed);
+}
+
+- (void)testHalfOpenLetsOneProbeThrough
+{
+    breaker.resetTimeout = 0;
+    [self openBreaker];
+    XCTAssertTrue([breaker allowsRequest]);
+    XCTAssertEqual(breaker.state, OlapicCircuitStateHalfOpen);
+    XCTAssertFalse([breaker allowsRequest]);
+}
+
+- (void)testProbeSuccessClosesTheCircuit
+{
+    breaker.resetTimeout = 0;
+    [self openBreaker];
+    XCTAssertTrue([breaker allowsRequest]);
+    [breaker recordSuccess];
+    XCTAssertEqual(breaker.state, OlapicCircuitStateClosed);
+    XCTAssertTrue([breaker allowsRequest]);
+    XCTAssertTrue([breaker allowsRequest]);
+}
+
+- (void)testProbeFailureOpensTheCircuit
+{
+    breaker.resetTimeout = 0;
+    [self openBreaker];
+    XCTAssertTrue([breaker allowsRequest]);
+    breaker.resetTimeout = 60;
+    [breaker recordFailure];
+    XCTAssertEqual(breaker.state, OlapicCircuitStateOpen);
+    XCTAssertFalse([breaker allowsRequest]);
+}
+
+- (void)testInconclusiveProbeLetsTheNextOneThrough
+{
+    breaker.resetTimeout = 0;
+    [self openBreaker];
+    XCTAssertTrue([breaker allowsRequest]);
+    [breaker recordInconclusive];
+    XCTAssertEqual(breaker.state, OlapicCircuitStateHalfOpen);
+    XCTAssertTrue([breaker allowsRequest]);
+    XCTAssertFalse([breaker allowsRequest]);
+}
+
+- (void)testInconclusiveDoesNotCountAsFailure
+{
+    for(NSInteger i = 0; i < breaker.failureThreshold * 2; i++){
+        [breaker recordInconclusive];
+    }
+    XCTAssertEqual(breaker.state, OlapicCircuitStateClosed);
+    XCTAssertTrue([breaker allowsRequest]);
+}
+
+- (void)testOpenCircuitError
+{
+    NSError *error = [breaker openCircuitError];
+    XCTAssertEqualObjects(error.domain, OlapicNetworkErrorDomain);
+    XCTAssertEqual(error.code, OlapicNetworkErrorCircuitOpen);
+}
+
+@end
@@ -0,0 +1,152 @@
+//
+//  OlapicFixtureTransportTests.m
+//  OlaBasicGalleryTests
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OlapicFixtureTransport.h"
+
+/**
+ *  A transport that answers every request with the same response,
+ *  without the network
+ */
+@interface OlapicFixtureTransportTestsStub : NSObject <OlapicNetworkTransport>
+
+@property (nonatomic,strong) dispatch_queue_t completionQueue;
+@property (nonatomic,strong) dispatch_group_t completionGroup;
+@property (nonatomic,strong) NSData *responseData;
+@property (nonatomic) NSInteger statusCode;
+@property (nonatomic,strong) NSMutableArray *requests;
+@property (nonatomic,strong) OlapicTransportMetrics *metrics;
+
+@end
+
+@implementation OlapicFixtureTransportTestsStub
+
+- (id)startRequest:(NSURLRequest *)request onCompletion:(void (^)(NSData *responseData, NSHTTPURLResponse *response, NSError *error))completion
+{
+    [self.requests addObject:request];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:self.statusCode HTTPVersion:@"HTTP/1.1" headerFields:@{@"Content-Type": @"application/json", @"Content-Length": @"12"}];
+    NSData *data = self.responseData;
+    NSBlockOperation *operation = [[NSBlockOperation alloc] init];
+    dispatch_group_t group = self.completionGroup;
+    if(group) dispatch_group_enter(group);
+    dispatch_async(self.completionQueue ?: dispatch_get_main_queue(), ^{
+        if(completion) completion(data, response, nil);
+        if(group) dispatch_group_leave(group);
+    });
+    return operation;
+}
+
+@end
+
+@interface OlapicFixtureTransportTests : XCTestCase{
+    NSString *fixturesPath;
+    OlapicFixtureTransportTestsStub *stub;
+}
+
+@end
+
+@implementation OlapicFixtureTransportTests
+
+- (void)setUp
+{
+    [super setUp];
+    fixturesPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"OlapicFixtureTransportTests-%@", [[NSUUID UUID] UUIDString]]];
+    stub = [[OlapicFixtureTransportTestsStub alloc] init];
+    stub.requests = [[NSMutableArray alloc] init];
+    stub.metrics = [[OlapicTransportMetrics alloc] init];
+    stub.statusCode = 200;
+    stub.responseData = [@"{\"data\":[1]}" dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:fixturesPath error:nil];
+    [super tearDown];
+}
+
+/**
+ *  Send a request and wait for its response, the completion blocks
+ *  run on a private queue so the test thread can block
+ */
+- (void)sendRequest:(NSURLRequest *)request withTransport:(OlapicFixtureTransport *)transport onCompletion:(void (^)(NSData *responseData, NSHTTPURLResponse *response, NSError *error))completion
+{
+    transport.completionQueue = dispatch_queue_create("com.olapic.tests.fixtures", DISPATCH_QUEUE_SERIAL);
+    transport.completionGroup = dispatch_group_create();
+    [transport startRequest:request onCompletion:completion];
+    XCTAssertEqual(dispatch_group_wait(transport.completionGroup, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)), (long)0);
+}
+
+- (void)testCanonicalURL
+{
+    XCTAssertEqualObjects([OlapicFixtureTransport canonicalURL:[NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/customers/1/media/recent?rights=1&auth_token=abc&count=20"]], @"https://photorankapi-a.akamaihd.net/customers/1/media/recent?count=20&rights=1");
+    XCTAssertEqualObjects([OlapicFixtureTransport canonicalURL:[NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/customers/1?auth_token=abc"]], @"https://photorankapi-a.akamaihd.net/customers/1");
+    XCTAssertEqualObjects([OlapicFixtureTransport canonicalURL:[NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/customers/1"]], @"https://photorankapi-a.akamaihd.net/customers/1");
+}
+
+- (void)testFixtureKeyIgnoresTheTokenAndTheOrder
+{
+    NSString *key = [OlapicFixtureTransport fixtureKeyForRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/media?a=1&b=2&auth_token=abc"]]];
+    XCTAssertEqualObjects([OlapicFixtureTransport fixtureKeyForRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/media?auth_token=xyz&b=2&a=1"]]], key);
+    XCTAssertTrue([key hasPrefix:@"get-"]);
+    XCTAssertNotEqualObjects([OlapicFixtureTransport fixtureKeyForRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/media?a=1&b=3"]]], key);
+    NSMutableURLRequest *post = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/media?a=1&b=2"]];
+    post.HTTPMethod = @"POST";
+    XCTAssertNotEqualObjects([OlapicFixtureTransport fixtureKeyForRequest:post], key);
+}
+
+- (void)testRecordsAndReplays
+{
+    OlapicFixtureTransport *transport = [[OlapicFixtureTransport alloc] initWithTransport:stub fixturesPath:fixturesPath mode:OlapicFixtureTransportModeRecord];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/media?count=20&auth_token=abc"]];
+    __block NSData *recorded = nil;
+    [self sendRequest:request withTransport:transport onCompletion:^(NSData *responseData, NSHTTPURLResponse *response, NSError *error){
+        recorded = responseData;
+    }];
+    XCTAssertEqualObjects(recorded, stub.responseData);
+    XCTAssertEqual([stub.requests count], (NSUInteger)1);
+    // Same queue: the fixture is written before it's read
+    transport.mode = OlapicFixtureTransportModeReplay;
+    stub.responseData = nil;
+    __block NSData *replayed = nil;
+    __block NSHTTPURLResponse *replayedResponse = nil;
+    __block NSError *replayedError = nil;
+    NSURLRequest *otherToken = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/media?auth_token=xyz&count=20"]];
+    [self sendRequest:otherToken withTransport:transport onCompletion:^(NSData *responseData, NSHTTPURLResponse *response, NSError *error){
+        replayed = responseData;
+        replayedResponse = response;
+        replayedError = error;
+    }];
+    XCTAssertEqual([stub.requests count], (NSUInteger)1);
+    XCTAssertEqualObjects(replayed, [@"{\"data\":[1]}" dataUsingEncoding:NSUTF8StringEncoding]);
+    XCTAssertEqual(replayedResponse.statusCode, (NSInteger)200);
+    XCTAssertNil(replayedError);
+    // The body length can change, it's not replayed
+    XCTAssertNil([[replayedResponse allHeaderFields] valueForKey:@"Content-Length"]);
+    XCTAssertEqual(transport.metrics.requests, (NSUInteger)1);
+    // The token is never saved
+    NSString *key = [OlapicFixtureTransport fixtureKeyForRequest:request];
+    NSString *fixture = [NSString stringWithContentsOfFile:[fixturesPath stringByAppendingPathComponent:[key stringByAppendingPathExtension:@"json"]] encoding:NSUTF8StringEncoding error:nil];
+    XCTAssertNotNil(fixture);
+    XCTAssertEqual([fixture rangeOfString:@"auth_token"].location, (NSUInteger)NSNotFound);
+}
+
+- (void)testReplayWithoutAFixtureFails
+{
+    OlapicFixtureTransport *transport = [[OlapicFixtureTransport alloc] initWithTransport:stub fixturesPath:fixturesPath mode:OlapicFixtureTransportModeReplay];
+    __block NSHTTPURLResponse *replayedResponse = nil;
+    __block NSError *replayedError = nil;
+    [self sendRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/media/missing"]] withTransport:transport onCompletion:^(NSData *responseData, NSHTTPURLResponse *response, NSError *error){
+        replayedResponse = response;
+        replayedError = error;
+    }];
+    XCTAssertEqual([stub.requests count], (NSUInteger)0);
+    XCTAssertEqual(replayedResponse.statusCode, (NSInteger)404);
+    XCTAssertNotNil(replayedError);
+}
+
+@end
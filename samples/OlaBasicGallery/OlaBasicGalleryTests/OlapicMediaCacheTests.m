@@ -0,0 +1,201 @@
+//
+//  OlapicMediaCacheTests.m
+//  OlaBasicGalleryTests
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OlapicMediaCache.h"
+#import "OlapicCachedMediaEntity.h"
+#import "OlapicEmbeddedResources.h"
+
+@interface OlapicMediaCacheTests : XCTestCase{
+    NSString *path;
+    NSArray *items;
+    NSArray *written;
+}
+
+@end
+
+@implementation OlapicMediaCacheTests
+
+- (void)setUp
+{
+    [super setUp];
+    path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"OlapicMediaCacheTests-%@.cache", [[NSUUID UUID] UUIDString]]];
+    items = @[
+        @{@"id": @"1001",
+          @"caption": @"Café on the beach ☀",
+          @"date_submitted": @"2014-06-11T16:43:42+00:00",
+          @"likes": @42,
+          @"score": @0.75,
+          @"video": @NO,
+          @"location": [NSNull null],
+          @"images": @{@"thumbnail": @"https://photos.example.com/1001/thumbnail.jpg", @"original": @"https://photos.example.com/1001/original.jpg"},
+          @"tags": @[@"beach", @"summer", @{@"name": @"sun"}],
+          @"_embedded": @{@"uploader": @{@"name": @"olapic", @"avatar": [NSNull null]}}},
+        @{@"id": @"1002",
+          @"caption": @"",
+          @"date_submitted": @"2014-06-10T09:00:00+00:00",
+          @"likes": @(-3),
+          @"score": @1e10,
+          @"video": @YES,
+          @"images": @{},
+          @"tags": @[],
+          @"_embedded": @{@"uploader": @{@"name": @"olapic"}}}
+    ];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+    [super tearDown];
+}
+
+- (NSArray *)entities
+{
+    NSMutableArray *entities = [[NSMutableArray alloc] init];
+    for(NSDictionary *item in items){
+        [entities addObject:[[OlapicMediaEntity alloc] initWithData:[item mutableCopy]]];
+    }
+    return entities;
+}
+
+- (NSData *)writtenFile
+{
+    NSArray *entities = [self entities];
+    // What the file should have for each entity
+    NSMutableArray *values = [[NSMutableArray alloc] init];
+    for(OlapicMediaEntity *entity in entities){
+        [values addObject:[[OlapicEmbeddedResources completeDataForEntity:entity] copy]];
+    }
+    written = values;
+    NSError *error = nil;
+    XCTAssertTrue([OlapicMediaCache writeMedia:entities toFile:path error:&error], @"%@", error);
+    return [NSData dataWithContentsOfFile:path];
+}
+
+- (void)testRoundTrip
+{
+    [self writtenFile];
+    NSError *error = nil;
+    OlapicMediaCache *cache = [[OlapicMediaCache alloc] initWithContentsOfFile:path error:&error];
+    XCTAssertNotNil(cache, @"%@", error);
+    XCTAssertEqual([cache count], [items count]);
+    for(NSUInteger i = 0; i < [items count]; i++){
+        XCTAssertEqualObjects([cache dictionaryForRecord:i], [written objectAtIndex:i]);
+    }
+    XCTAssertNil([cache dictionaryForRecord:[items count]]);
+}
+
+- (void)testValueAtPath
+{
+    [self writtenFile];
+    OlapicMediaCache *cache = [[OlapicMediaCache alloc] initWithContentsOfFile:path error:nil];
+    XCTAssertEqualObjects([cache valueAtPath:@"id" forRecord:0], @"1001");
+    XCTAssertEqualObjects([cache valueAtPath:@"images/thumbnail" forRecord:0], @"https://photos.example.com/1001/thumbnail.jpg");
+    XCTAssertEqualObjects([cache valueAtPath:@"_embedded/uploader/name" forRecord:1], @"olapic");
+    XCTAssertEqualObjects([cache valueAtPath:@"likes" forRecord:1], @(-3));
+    XCTAssertNil([cache valueAtPath:@"images/thumbnail" forRecord:1]);
+    XCTAssertNil([cache valueAtPath:@"caption/more" forRecord:0]);
+    XCTAssertNil([cache valueAtPath:@"id" forRecord:[items count]]);
+}
+
+- (void)testCachedEntities
+{
+    [self writtenFile];
+    OlapicMediaCache *cache = [[OlapicMediaCache alloc] initWithContentsOfFile:path error:nil];
+    NSArray *media = [cache allMedia];
+    XCTAssertEqual([media count], [items count]);
+    OlapicCachedMediaEntity *entity = [media objectAtIndex:1];
+    XCTAssertTrue([entity isKindOfClass:[OlapicCachedMediaEntity class]]);
+    XCTAssertEqual(entity.index, (NSUInteger)1);
+    // Read from the file until the SDK needs the whole entity
+    XCTAssertFalse([entity isLoaded]);
+    XCTAssertEqualObjects([entity get:@"id"], @"1002");
+    XCTAssertFalse([entity isLoaded]);
+    XCTAssertEqualObjects([entity.data objectForKey:@"caption"], @"");
+    XCTAssertTrue([entity isLoaded]);
+    XCTAssertEqualObjects([entity get:@"id"], @"1002");
+}
+
+- (void)testDeepNesting
+{
+    id shallow = @"leaf", deep = @"leaf";
+    for(NSUInteger i = 0; i < 40; i++) shallow = @[shallow];
+    for(NSUInteger i = 0; i < 100; i++) deep = @[deep];
+    items = @[@{@"id": @"1001", @"nested": shallow}, @{@"id": @"1002", @"nested": deep}];
+    [self writtenFile];
+    OlapicMediaCache *cache = [[OlapicMediaCache alloc] initWithContentsOfFile:path error:nil];
+    XCTAssertEqualObjects([cache dictionaryForRecord:0], [written objectAtIndex:0]);
+    // Too deep to be decoded, but its other values can still be read
+    XCTAssertNil([cache dictionaryForRecord:1]);
+    XCTAssertEqualObjects([cache valueAtPath:@"id" forRecord:1], @"1002");
+}
+
+- (void)testEmptyList
+{
+    XCTAssertTrue([OlapicMediaCache writeMedia:@[] toFile:path error:nil]);
+    OlapicMediaCache *cache = [[OlapicMediaCache alloc] initWithContentsOfFile:path error:nil];
+    XCTAssertNotNil(cache);
+    XCTAssertEqual([cache count], (NSUInteger)0);
+    XCTAssertEqual([[cache allMedia] count], (NSUInteger)0);
+}
+
+- (void)testMissingFile
+{
+    NSError *error = nil;
+    XCTAssertNil([[OlapicMediaCache alloc] initWithContentsOfFile:path error:&error]);
+    XCTAssertNotNil(error);
+}
+
+- (void)testWrongMagicAndVersion
+{
+    NSData *file = [self writtenFile];
+    NSMutableData *corrupt = [file mutableCopy];
+    ((uint8_t *)[corrupt mutableBytes])[0] = 'X';
+    [corrupt writeToFile:path atomically:YES];
+    NSError *error = nil;
+    XCTAssertNil([[OlapicMediaCache alloc] initWithContentsOfFile:path error:&error]);
+    XCTAssertEqualObjects(error.domain, NSCocoaErrorDomain);
+    XCTAssertEqual(error.code, (NSInteger)NSFileReadCorruptFileError);
+    corrupt = [file mutableCopy];
+    ((uint8_t *)[corrupt mutableBytes])[4] += 1;
+    [corrupt writeToFile:path atomically:YES];
+    XCTAssertNil([[OlapicMediaCache alloc] initWithContentsOfFile:path error:nil]);
+}
+
+- (void)testTruncatedFiles
+{
+    NSData *file = [self writtenFile];
+    // The values are at the end, so any cut breaks the last record
+    for(NSUInteger length = 0; length < [file length]; length++){
+        [[file subdataWithRange:NSMakeRange(0, length)] writeToFile:path atomically:YES];
+        XCTAssertNil([[OlapicMediaCache alloc] initWithContentsOfFile:path error:nil], @"Accepted a file cut at %lu bytes", (unsigned long)length);
+    }
+}
+
+- (void)testCorruptBytesAreNeverReadOutOfTheFile
+{
+    NSData *file = [self writtenFile];
+    const uint8_t values[] = {0x00, 0x07, 0x7F, 0xFF};
+    for(NSUInteger offset = 0; offset < [file length]; offset++){
+        for(NSUInteger v = 0; v < sizeof(values); v++){
+            NSMutableData *corrupt = [file mutableCopy];
+            ((uint8_t *)[corrupt mutableBytes])[offset] = values[v];
+            [corrupt writeToFile:path atomically:YES];
+            OlapicMediaCache *cache = [[OlapicMediaCache alloc] initWithContentsOfFile:path error:nil];
+            // A file that is still valid can read different values, but
+            // every read has to stay inside the file
+            for(NSUInteger i = 0; i < [cache count]; i++){
+                id record = [cache dictionaryForRecord:i];
+                XCTAssertTrue(!record || [record isKindOfClass:[NSDictionary class]]);
+                [cache valueAtPath:@"_embedded/uploader/name" forRecord:i];
+            }
+        }
+    }
+}
+
+@end
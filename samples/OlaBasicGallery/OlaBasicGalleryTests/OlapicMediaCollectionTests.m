@@ -0,0 +1,143 @@
+//
+//  OlapicMediaCollectionTests.m
+//  OlaBasicGalleryTests
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OlapicMediaCollection.h"
+
+@interface OlapicMediaCollectionTests : XCTestCase
+
+@end
+
+@implementation OlapicMediaCollectionTests
+
+/**
+ *  Pages with the given sizes, numbered from 'first' on
+ */
+- (NSMutableArray *)pagesWithSizes:(NSArray *)sizes first:(NSUInteger)first
+{
+    NSMutableArray *pages = [[NSMutableArray alloc] init];
+    NSUInteger next = first;
+    for(NSNumber *size in sizes){
+        NSMutableArray *media = [[NSMutableArray alloc] init];
+        for(NSUInteger i = 0; i < [size unsignedIntegerValue]; i++){
+            [media addObject:@(next++)];
+        }
+        [pages addObject:@{@"media": media}];
+    }
+    return pages;
+}
+
+- (void)assertCollection:(OlapicMediaCollection *)collection isSequenceFrom:(NSUInteger)first count:(NSUInteger)count
+{
+    XCTAssertEqual([collection count], count);
+    for(NSUInteger i = 0; i < count; i++){
+        XCTAssertEqualObjects([collection objectAtIndex:i], @(first + i));
+    }
+    NSUInteger expected = first;
+    for(NSNumber *media in collection){
+        XCTAssertEqualObjects(media, @(expected++));
+    }
+    XCTAssertEqual(expected, first + count);
+    XCTAssertThrowsSpecificNamed([collection objectAtIndex:count], NSException, NSRangeException);
+}
+
+- (void)testEmpty
+{
+    OlapicMediaCollection *collection = [[OlapicMediaCollection alloc] initWithPages:[NSMutableArray array]];
+    [self assertCollection:collection isSequenceFrom:0 count:0];
+}
+
+- (void)testUniformPages
+{
+    NSMutableArray *pages = [self pagesWithSizes:@[@32, @32, @32] first:0];
+    [self assertCollection:[[OlapicMediaCollection alloc] initWithPages:pages] isSequenceFrom:0 count:96];
+}
+
+- (void)testShortLastPage
+{
+    NSMutableArray *pages = [self pagesWithSizes:@[@32, @32, @5] first:0];
+    [self assertCollection:[[OlapicMediaCollection alloc] initWithPages:pages] isSequenceFrom:0 count:69];
+}
+
+- (void)testShortFirstPage
+{
+    NSMutableArray *pages = [self pagesWithSizes:@[@3, @32, @32] first:0];
+    [self assertCollection:[[OlapicMediaCollection alloc] initWithPages:pages] isSequenceFrom:0 count:67];
+}
+
+- (void)testShortFirstPageAndLongerLastPage
+{
+    // The last page is longer than the first one, so it can't be
+    // looked up as if all the pages had the first page size
+    NSMutableArray *pages = [self pagesWithSizes:@[@3, @32] first:0];
+    [self assertCollection:[[OlapicMediaCollection alloc] initWithPages:pages] isSequenceFrom:0 count:35];
+}
+
+- (void)testShortFirstAndLastPages
+{
+    NSMutableArray *pages = [self pagesWithSizes:@[@7, @32, @32, @4] first:0];
+    [self assertCollection:[[OlapicMediaCollection alloc] initWithPages:pages] isSequenceFrom:0 count:75];
+}
+
+- (void)testEmptyPages
+{
+    NSMutableArray *pages = [self pagesWithSizes:@[@0, @10, @0, @10] first:0];
+    [self assertCollection:[[OlapicMediaCollection alloc] initWithPages:pages] isSequenceFrom:0 count:20];
+}
+
+- (void)testFollowsAppendedPages
+{
+    NSMutableArray *pages = [self pagesWithSizes:@[@32] first:0];
+    OlapicMediaCollection *collection = [[OlapicMediaCollection alloc] initWithPages:pages];
+    [self assertCollection:collection isSequenceFrom:0 count:32];
+    [pages addObjectsFromArray:[self pagesWithSizes:@[@32, @10] first:32]];
+    [collection pagesDidChange];
+    [self assertCollection:collection isSequenceFrom:0 count:74];
+}
+
+- (void)testFollowsPagesInsertedFirst
+{
+    NSMutableArray *pages = [self pagesWithSizes:@[@32, @32] first:10];
+    OlapicMediaCollection *collection = [[OlapicMediaCollection alloc] initWithPages:pages];
+    [self assertCollection:collection isSequenceFrom:10 count:64];
+    // Like the newer media, put before the loaded pages
+    [pages insertObject:[[self pagesWithSizes:@[@10] first:0] firstObject] atIndex:0];
+    [collection pagesDidChange];
+    [self assertCollection:collection isSequenceFrom:0 count:74];
+}
+
+- (void)testFollowsReplacedPage
+{
+    // Same number of pages, same first and last pages: only the
+    // mutation counter tells the collection about it
+    NSMutableArray *pages = [self pagesWithSizes:@[@32, @32, @32] first:0];
+    OlapicMediaCollection *collection = [[OlapicMediaCollection alloc] initWithPages:pages];
+    [self assertCollection:collection isSequenceFrom:0 count:96];
+    [pages replaceObjectAtIndex:1 withObject:[[self pagesWithSizes:@[@5] first:32] firstObject]];
+    [pages replaceObjectAtIndex:2 withObject:[[self pagesWithSizes:@[@32] first:37] firstObject]];
+    [collection pagesDidChange];
+    XCTAssertEqual([collection count], (NSUInteger)69);
+    XCTAssertEqualObjects([collection objectAtIndex:40], @40);
+}
+
+- (void)testEnumerationFailsWhenPagesChange
+{
+    NSMutableArray *pages = [self pagesWithSizes:@[@32, @32] first:0];
+    OlapicMediaCollection *collection = [[OlapicMediaCollection alloc] initWithPages:pages];
+    void (^mutateWhileEnumerating)(void) = ^{
+        for(NSNumber *media in collection){
+            if([media unsignedIntegerValue] == 40){
+                [pages addObjectsFromArray:[self pagesWithSizes:@[@32] first:64]];
+                [collection pagesDidChange];
+            }
+        }
+    };
+    XCTAssertThrowsSpecificNamed(mutateWhileEnumerating(), NSException, NSGenericException);
+}
+
+@end
@@ -0,0 +1,139 @@
+//
+//  OlapicPayloadDecoderTests.m
+//  OlaBasicGalleryTests
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OlapicPayloadDecoder.h"
+#import "OlapicCircuitBreaker.h"
+
+/**
+ *  {"a": 1, "b": [true, null, "x"], "c": -1, "d": 1.5, "e": 256}
+ */
+static const uint8_t OlapicPayloadDecoderTestsPayload[] = {
+    0x85,
+    0xa1, 'a', 0x01,
+    0xa1, 'b', 0x93, 0xc3, 0xc0, 0xa1, 'x',
+    0xa1, 'c', 0xff,
+    0xa1, 'd', 0xcb, 0x3f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xa1, 'e', 0xcd, 0x01, 0x00
+};
+
+@interface OlapicPayloadDecoderTests : XCTestCase
+
+@end
+
+@implementation OlapicPayloadDecoderTests
+
+- (NSData *)payload
+{
+    return [NSData dataWithBytes:OlapicPayloadDecoderTestsPayload length:sizeof(OlapicPayloadDecoderTestsPayload)];
+}
+
+- (void)assertInvalidPayload:(NSData *)data
+{
+    NSError *error = nil;
+    XCTAssertNil([OlapicPayloadDecoder objectWithMessagePackData:data error:&error], @"Accepted %@", data);
+    XCTAssertEqualObjects(error.domain, OlapicNetworkErrorDomain);
+    XCTAssertEqual(error.code, OlapicNetworkErrorInvalidResponse);
+}
+
+- (void)testDecodesTheCompactPayload
+{
+    NSError *error = nil;
+    NSDictionary *expected = @{@"a": @1, @"b": @[@YES, [NSNull null], @"x"], @"c": @(-1), @"d": @1.5, @"e": @256};
+    XCTAssertEqualObjects([OlapicPayloadDecoder objectWithData:[self payload] error:&error], expected);
+    XCTAssertNil(error);
+}
+
+- (void)testDecodesJSON
+{
+    NSData *JSON = [@"{\"a\": 1, \"b\": [true, null, \"x\"]}" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertFalse([OlapicPayloadDecoder isCompactPayload:JSON]);
+    XCTAssertEqualObjects([OlapicPayloadDecoder objectWithData:JSON error:nil], (@{@"a": @1, @"b": @[@YES, [NSNull null], @"x"]}));
+}
+
+- (void)testDetectsTheFormat
+{
+    XCTAssertTrue([OlapicPayloadDecoder isCompactPayload:[self payload]]);
+    XCTAssertFalse([OlapicPayloadDecoder isCompactPayload:[NSData data]]);
+    XCTAssertFalse([OlapicPayloadDecoder isCompactPayload:[@" {}" dataUsingEncoding:NSUTF8StringEncoding]]);
+}
+
+- (void)testRejectsTruncatedPayloads
+{
+    NSData *payload = [self payload];
+    for(NSUInteger length = 0; length < [payload length]; length++){
+        [self assertInvalidPayload:[payload subdataWithRange:NSMakeRange(0, length)]];
+    }
+}
+
+- (void)testRejectsTrailingBytes
+{
+    NSMutableData *payload = [[self payload] mutableCopy];
+    [payload appendBytes:"\xc0" length:1];
+    [self assertInvalidPayload:payload];
+}
+
+- (void)testRejectsLengthsBeyondTheData
+{
+    const uint8_t map32[] = {0xdf, 0xff, 0xff, 0xff, 0xff, 0xa1, 'a', 0x01};
+    const uint8_t array32[] = {0x81, 0xa1, 'a', 0xdd, 0xff, 0xff, 0xff, 0xff, 0xc0};
+    const uint8_t str32[] = {0x81, 0xa1, 'a', 0xdb, 0xff, 0xff, 0xff, 0xff, 'x'};
+    const uint8_t bin32[] = {0x81, 0xa1, 'a', 0xc6, 0x7f, 0xff, 0xff, 0xff, 0x00};
+    const uint8_t ext32[] = {0x81, 0xa1, 'a', 0xc9, 0xff, 0xff, 0xff, 0xff, 0x01};
+    [self assertInvalidPayload:[NSData dataWithBytes:map32 length:sizeof(map32)]];
+    [self assertInvalidPayload:[NSData dataWithBytes:array32 length:sizeof(array32)]];
+    [self assertInvalidPayload:[NSData dataWithBytes:str32 length:sizeof(str32)]];
+    [self assertInvalidPayload:[NSData dataWithBytes:bin32 length:sizeof(bin32)]];
+    [self assertInvalidPayload:[NSData dataWithBytes:ext32 length:sizeof(ext32)]];
+}
+
+- (void)testRejectsInvalidValues
+{
+    // The reserved type and a string that is not UTF-8
+    const uint8_t reserved[] = {0x81, 0xa1, 'a', 0xc1};
+    const uint8_t notUTF8[] = {0x81, 0xa1, 'a', 0xa2, 0xff, 0xfe};
+    [self assertInvalidPayload:[NSData dataWithBytes:reserved length:sizeof(reserved)]];
+    [self assertInvalidPayload:[NSData dataWithBytes:notUTF8 length:sizeof(notUTF8)]];
+}
+
+- (void)testLimitsTheNesting
+{
+    NSMutableData *shallow = [[NSMutableData alloc] init];
+    NSMutableData *deep = [[NSMutableData alloc] init];
+    [shallow appendBytes:"\x81\xa1" "a" length:3];
+    [deep appendBytes:"\x81\xa1" "a" length:3];
+    for(NSUInteger i = 0; i < 32; i++) [shallow appendBytes:"\x91" length:1];
+    for(NSUInteger i = 0; i < 1000; i++) [deep appendBytes:"\x91" length:1];
+    [shallow appendBytes:"\xc0" length:1];
+    [deep appendBytes:"\xc0" length:1];
+    XCTAssertNotNil([OlapicPayloadDecoder objectWithMessagePackData:shallow error:nil]);
+    [self assertInvalidPayload:deep];
+}
+
+- (void)testSurvivesCorruptBytes
+{
+    NSData *payload = [self payload];
+    for(NSUInteger offset = 0; offset < [payload length]; offset++){
+        for(NSUInteger value = 0; value < 256; value++){
+            NSMutableData *corrupt = [payload mutableCopy];
+            ((uint8_t *)[corrupt mutableBytes])[offset] = (uint8_t)value;
+            NSError *error = nil;
+            id object = [OlapicPayloadDecoder objectWithData:corrupt error:&error];
+            XCTAssertTrue(object || error);
+        }
+    }
+}
+
+- (void)testRejectsCorruptJSON
+{
+    NSError *error = nil;
+    XCTAssertNil([OlapicPayloadDecoder objectWithData:[@"{\"a\": [1, 2" dataUsingEncoding:NSUTF8StringEncoding] error:&error]);
+    XCTAssertNotNil(error);
+}
+
+@end
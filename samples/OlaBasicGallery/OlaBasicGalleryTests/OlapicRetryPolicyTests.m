@@ -0,0 +1,107 @@
+//
+//  OlapicRetryPolicyTests.m
+//  OlaBasicGalleryTests
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OlapicRetryPolicy.h"
+
+@interface OlapicRetryPolicyTests : XCTestCase{
+    OlapicRetryPolicy *policy;
+}
+
+@end
+
+@implementation OlapicRetryPolicyTests
+
+- (void)setUp
+{
+    [super setUp];
+    policy = [OlapicRetryPolicy defaultPolicy];
+}
+
+- (NSHTTPURLResponse *)responseWithStatus:(NSInteger)status headers:(NSDictionary *)headers
+{
+    NSURL *URL = [NSURL URLWithString:@"https://photorankapi-a.akamaihd.net/customers/1/media/recent"];
+    return [[NSHTTPURLResponse alloc] initWithURL:URL statusCode:status HTTPVersion:@"HTTP/1.1" headerFields:headers];
+}
+
+- (void)testRetriesTheRetryableStatusCodes
+{
+    XCTAssertTrue([policy shouldRetryError:nil response:[self responseWithStatus:503 headers:nil] attempt:0]);
+    XCTAssertTrue([policy shouldRetryError:nil response:[self responseWithStatus:429 headers:nil] attempt:0]);
+    XCTAssertFalse([policy shouldRetryError:nil response:[self responseWithStatus:404 headers:nil] attempt:0]);
+    XCTAssertFalse([policy shouldRetryError:nil response:[self responseWithStatus:501 headers:nil] attempt:0]);
+}
+
+- (void)testRetriesTheTransientNetworkErrors
+{
+    NSError *timeout = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil];
+    NSError *cancelled = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+    NSError *other = [NSError errorWithDomain:@"other" code:NSURLErrorTimedOut userInfo:nil];
+    XCTAssertTrue([policy shouldRetryError:timeout response:nil attempt:0]);
+    XCTAssertFalse([policy shouldRetryError:cancelled response:nil attempt:0]);
+    XCTAssertFalse([policy shouldRetryError:other response:nil attempt:0]);
+}
+
+- (void)testStopsAfterMaxRetries
+{
+    NSHTTPURLResponse *response = [self responseWithStatus:503 headers:nil];
+    XCTAssertTrue([policy shouldRetryError:nil response:response attempt:policy.maxRetries - 1]);
+    XCTAssertFalse([policy shouldRetryError:nil response:response attempt:policy.maxRetries]);
+}
+
+- (void)testDelayGrowsExponentiallyUpToTheMaximum
+{
+    policy.jitter = 0;
+    policy.baseDelay = 0.5;
+    policy.maxDelay = 3;
+    XCTAssertEqualWithAccuracy([policy delayForAttempt:0 response:nil], 0.5, 0.0001);
+    XCTAssertEqualWithAccuracy([policy delayForAttempt:1 response:nil], 1.0, 0.0001);
+    XCTAssertEqualWithAccuracy([policy delayForAttempt:2 response:nil], 2.0, 0.0001);
+    XCTAssertEqualWithAccuracy([policy delayForAttempt:3 response:nil], 3.0, 0.0001);
+}
+
+- (void)testJitterStaysWithinTheDelay
+{
+    policy.jitter = 1;
+    for(NSInteger i = 0; i < 100; i++){
+        NSTimeInterval delay = [policy delayForAttempt:2 response:nil];
+        XCTAssertTrue(delay >= 0 && delay <= policy.baseDelay * 4);
+    }
+}
+
+- (void)testRetryAfterInSeconds
+{
+    NSHTTPURLResponse *response = [self responseWithStatus:503 headers:@{@"Retry-After": @"7"}];
+    XCTAssertEqualWithAccuracy([OlapicRetryPolicy retryAfterForResponse:response], 7, 0.0001);
+    XCTAssertEqualWithAccuracy([policy delayForAttempt:0 response:response], 7, 0.0001);
+    policy.maxDelay = 5;
+    XCTAssertEqualWithAccuracy([policy delayForAttempt:0 response:response], 5, 0.0001);
+}
+
+- (void)testRetryAfterAsHTTPDate
+{
+    NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
+    formatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+    formatter.timeZone = [NSTimeZone timeZoneWithAbbreviation:@"GMT"];
+    formatter.dateFormat = @"EEE',' dd MMM yyyy HH':'mm':'ss 'GMT'";
+    NSString *date = [formatter stringFromDate:[NSDate dateWithTimeIntervalSinceNow:120]];
+    NSHTTPURLResponse *response = [self responseWithStatus:429 headers:@{@"Retry-After": date}];
+    XCTAssertEqualWithAccuracy([OlapicRetryPolicy retryAfterForResponse:response], 120, 2);
+    NSString *past = [formatter stringFromDate:[NSDate dateWithTimeIntervalSinceNow:-120]];
+    response = [self responseWithStatus:429 headers:@{@"Retry-After": past}];
+    XCTAssertEqualWithAccuracy([OlapicRetryPolicy retryAfterForResponse:response], 0, 0.0001);
+}
+
+- (void)testMissingOrInvalidRetryAfter
+{
+    XCTAssertTrue([OlapicRetryPolicy retryAfterForResponse:[self responseWithStatus:503 headers:nil]] < 0);
+    XCTAssertTrue([OlapicRetryPolicy retryAfterForResponse:[self responseWithStatus:503 headers:@{@"Retry-After": @"soon"}]] < 0);
+    XCTAssertTrue([OlapicRetryPolicy retryAfterForResponse:nil] < 0);
+}
+
+@end
@@ -0,0 +1,128 @@
+//
+//  OlapicDuplicateDetector.h
+//  OlaUploader
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+/**
+ *  Finds the images that were already uploaded (or that are almost the
+ *  same, like the photos of a burst) before they're uploaded again.
+ *
+ *  Every image gets a 64 bit perceptual hash: it's scaled down to 32x32
+ *  grey pixels, transformed with a DCT (vDSP), and each of the 8x8 lowest
+ *  frequencies becomes a bit, set if it's over their median. Similar
+ *  images have hashes that differ in a few bits, so an image is a
+ *  duplicate if the Hamming distance to a previous upload is at most
+ *  the hammingThreshold.
+ *
+ *  The hashes of the uploaded images are saved on a file, so they're
+ *  remembered between sessions. All the methods should be called from
+ *  the main thread, except perceptualHashForImage:.
+ */
+@interface OlapicDuplicateDetector : NSObject{
+    /**
+     *  The hashes of the previous uploads (NSNumber), from the oldest
+     */
+    NSMutableArray *hashes;
+    /**
+     *  The maximum number of different bits for two images to be duplicates
+     */
+    NSUInteger hammingThreshold;
+    /**
+     *  The maximum number of hashes kept
+     */
+    NSUInteger countLimit;
+    /**
+     *  Where the hashes are saved
+     */
+    NSString *path;
+    /**
+     *  The serial queue that saves the hashes, so the file ends with the last ones
+     */
+    dispatch_queue_t queue;
+}
+
+@property (nonatomic) NSUInteger hammingThreshold;
+@property (nonatomic) NSUInteger countLimit;
+@property (nonatomic,copy,readonly) NSString *path;
+/**
+ *  Get the singleton shared instance
+ *
+ *  @return The shared instance
+ */
++(instancetype)sharedDetector;
+/**
+ *  Class constructor
+ *
+ *  @param filePath Where the hashes are saved (nil to keep them only in memory)
+ *
+ *  @return An instance of this object (OlapicDuplicateDetector)
+ */
+-(id)initWithPath:(NSString *)filePath;
+/**
+ *  Find a previous upload that is the same as an image
+ *
+ *  @param hash     The perceptual hash of the image
+ *  @param distance A reference to save the Hamming distance to the previous upload (optional)
+ *
+ *  @return The hash of the closest previous upload within the threshold, or nil if it's not a duplicate
+ */
+-(NSNumber *)previousUploadMatchingHash:(uint64_t)hash distance:(NSUInteger *)distance;
+/**
+ *  Remember an uploaded image, and save the hashes
+ *
+ *  @param hash The perceptual hash of the image
+ */
+-(void)addUploadedHash:(uint64_t)hash;
+/**
+ *  Forget all the previous uploads
+ */
+-(void)removeAllHashes;
+/**
+ *  Compute the perceptual hash of an image, drawn upright (with its
+ *  imageOrientation applied). It can be called from any thread
+ *
+ *  @param image The image
+ *
+ *  @return The hash (0 if the image can't be read)
+ */
++(uint64_t)perceptualHashForImage:(UIImage *)image;
+/**
+ *  Count the different bits between two hashes
+ *
+ *  @param hash  A hash
+ *  @param other Another hash
+ *
+ *  @return The Hamming distance
+ */
++(NSUInteger)distanceBetweenHash:(uint64_t)hash andHash:(uint64_t)other;
+
+@end
\ No newline at end of file
@@ -0,0 +1,253 @@
+//
+//  OlapicDuplicateDetector.m
+//  OlaUploader
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicDuplicateDetector.h"
+#import <Accelerate/Accelerate.h>
+/**
+ *  The side of the grey image the DCT is computed on
+ */
+static const vDSP_Length OlapicDuplicateDetectorSampleSide = 32;
+/**
+ *  The side of the block of low frequencies used for the hash
+ */
+static const NSUInteger OlapicDuplicateDetectorHashSide = 8;
+
+@interface OlapicDuplicateDetector()
+/**
+ *  Save the hashes on the file
+ */
+-(void)save;
+
+@end
+
+@implementation OlapicDuplicateDetector
+@synthesize hammingThreshold,countLimit,path;
+/**
+ *  Get the singleton shared instance
+ *
+ *  @return The shared instance
+ */
++(instancetype)sharedDetector{
+    static OlapicDuplicateDetector *sharedDetector = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        // Not on the caches, the system could delete them
+        NSString *support = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) firstObject];
+        [[NSFileManager defaultManager] createDirectoryAtPath:support withIntermediateDirectories:YES attributes:nil error:nil];
+        sharedDetector = [[OlapicDuplicateDetector alloc] initWithPath:[support stringByAppendingPathComponent:@"OlapicUploadHashes.plist"]];
+    });
+    return sharedDetector;
+}
+/**
+ *  Class constructor
+ *
+ *  @param filePath Where the hashes are saved (nil to keep them only in memory)
+ *
+ *  @return An instance of this object (OlapicDuplicateDetector)
+ */
+-(id)initWithPath:(NSString *)filePath{
+    self = [super init];
+    if(self){
+        path = [filePath copy];
+        hammingThreshold = 10;
+        countLimit = 5000;
+        queue = dispatch_queue_create("com.olapic.uploader.hashes", DISPATCH_QUEUE_SERIAL);
+        hashes = [[NSMutableArray alloc] init];
+        NSArray *saved = path ? [NSArray arrayWithContentsOfFile:path] : nil;
+        for(id savedHash in saved){
+            if([savedHash isKindOfClass:[NSNumber class]]) [hashes addObject:savedHash];
+        }
+    }
+    return self;
+}
+/**
+ *  Find a previous upload that is the same as an image
+ *
+ *  @param hash     The perceptual hash of the image
+ *  @param distance A reference to save the Hamming distance to the previous upload (optional)
+ *
+ *  @return The hash of the closest previous upload within the threshold, or nil if it's not a duplicate
+ */
+-(NSNumber *)previousUploadMatchingHash:(uint64_t)hash distance:(NSUInteger *)distance{
+    NSNumber *match = nil;
+    NSUInteger best = NSUIntegerMax;
+    for(NSNumber *previous in hashes){
+        NSUInteger bits = [OlapicDuplicateDetector distanceBetweenHash:hash andHash:[previous unsignedLongLongValue]];
+        if(bits <= hammingThreshold && bits < best){
+            best = bits;
+            match = previous;
+            if(bits == 0) break;
+        }
+    }
+    if(match && distance) *distance = best;
+    return match;
+}
+/**
+ *  Remember an uploaded image, and save the hashes
+ *
+ *  @param hash The perceptual hash of the image
+ */
+-(void)addUploadedHash:(uint64_t)hash{
+    [hashes addObject:[NSNumber numberWithUnsignedLongLong:hash]];
+    if([hashes count] > countLimit){
+        [hashes removeObjectsInRange:NSMakeRange(0, [hashes count] - countLimit)];
+    }
+    [self save];
+}
+/**
+ *  Forget all the previous uploads
+ */
+-(void)removeAllHashes{
+    [hashes removeAllObjects];
+    [self save];
+}
+/**
+ *  Save the hashes on the file
+ */
+-(void)save{
+    if(!path) return;
+    NSArray *saved = [hashes copy];
+    NSString *savePath = path;
+    dispatch_async(queue, ^{
+        if(![saved writeToFile:savePath atomically:YES]){
+            NSLog(@"UPLOAD HASHES SAVE ERROR : %@",savePath);
+        }
+    });
+}
+/**
+ *  Compute the perceptual hash of an image, drawn upright (with its
+ *  imageOrientation applied). It can be called from any thread
+ *
+ *  @param image The image
+ *
+ *  @return The hash (0 if the image can't be read)
+ */
++(uint64_t)perceptualHashForImage:(UIImage *)image{
+    CGImageRef cgImage = image.CGImage;
+    if(!cgImage) return 0;
+    vDSP_Length side = OlapicDuplicateDetectorSampleSide;
+    vDSP_Length count = side * side;
+    // Scale it down to grey pixels, Core Graphics averages them
+    uint8_t grey[OlapicDuplicateDetectorSampleSide * OlapicDuplicateDetectorSampleSide];
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceGray();
+    CGContextRef context = CGBitmapContextCreate(grey, side, side, 8, side, colorSpace, (CGBitmapInfo)kCGImageAlphaNone);
+    CGColorSpaceRelease(colorSpace);
+    if(!context) return 0;
+    CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
+    // The camera saves the pixels as they come from the sensor, rotate
+    // (and flip) them like UIKit does. The context is a square, so the
+    // rotated image is drawn on the same rect
+    CGAffineTransform transform = CGAffineTransformIdentity;
+    switch(image.imageOrientation){
+        case UIImageOrientationDown:
+        case UIImageOrientationDownMirrored:
+            transform = CGAffineTransformTranslate(transform, side, side);
+            transform = CGAffineTransformRotate(transform, M_PI);
+            break;
+        case UIImageOrientationLeft:
+        case UIImageOrientationLeftMirrored:
+            transform = CGAffineTransformTranslate(transform, side, 0);
+            transform = CGAffineTransformRotate(transform, M_PI_2);
+            break;
+        case UIImageOrientationRight:
+        case UIImageOrientationRightMirrored:
+            transform = CGAffineTransformTranslate(transform, 0, side);
+            transform = CGAffineTransformRotate(transform, -M_PI_2);
+            break;
+        default:
+            break;
+    }
+    switch(image.imageOrientation){
+        case UIImageOrientationUpMirrored:
+        case UIImageOrientationDownMirrored:
+        case UIImageOrientationLeftMirrored:
+        case UIImageOrientationRightMirrored:
+            transform = CGAffineTransformTranslate(transform, side, 0);
+            transform = CGAffineTransformScale(transform, -1, 1);
+            break;
+        default:
+            break;
+    }
+    CGContextConcatCTM(context, transform);
+    CGContextDrawImage(context, CGRectMake(0, 0, side, side), cgImage);
+    CGContextRelease(context);
+    // 2D DCT: the rows, then the rows of the transposed result
+    float *pixels = malloc(sizeof(float) * count);
+    float *transformed = malloc(sizeof(float) * count);
+    vDSP_vfltu8(grey, 1, pixels, 1, count);
+    vDSP_DFT_Setup setup = vDSP_DCT_CreateSetup(NULL, side, vDSP_DCT_II);
+    if(!setup){
+        free(pixels);
+        free(transformed);
+        return 0;
+    }
+    for(vDSP_Length row = 0; row < side; row++){
+        vDSP_DCT_Execute(setup, pixels + row * side, transformed + row * side);
+    }
+    vDSP_mtrans(transformed, 1, pixels, 1, side, side);
+    for(vDSP_Length row = 0; row < side; row++){
+        vDSP_DCT_Execute(setup, pixels + row * side, transformed + row * side);
+    }
+    vDSP_DFT_DestroySetup(setup);
+    free(pixels);
+    // The lowest frequencies, compared to their median (without the
+    // first one, the average brightness, which is much bigger)
+    NSUInteger hashSide = OlapicDuplicateDetectorHashSide;
+    float low[OlapicDuplicateDetectorHashSide * OlapicDuplicateDetectorHashSide];
+    for(NSUInteger row = 0; row < hashSide; row++){
+        memcpy(low + row * hashSide, transformed + row * side, sizeof(float) * hashSide);
+    }
+    free(transformed);
+    float sorted[OlapicDuplicateDetectorHashSide * OlapicDuplicateDetectorHashSide - 1];
+    memcpy(sorted, low + 1, sizeof(sorted));
+    vDSP_Length sortedCount = sizeof(sorted) / sizeof(float);
+    vDSP_vsort(sorted, sortedCount, 1);
+    float median = sorted[sortedCount / 2];
+    uint64_t hash = 0;
+    for(NSUInteger i = 0; i < hashSide * hashSide; i++){
+        if(low[i] > median) hash |= (1ULL << i);
+    }
+    return hash;
+}
+/**
+ *  Count the different bits between two hashes
+ *
+ *  @param hash  A hash
+ *  @param other Another hash
+ *
+ *  @return The Hamming distance
+ */
++(NSUInteger)distanceBetweenHash:(uint64_t)hash andHash:(uint64_t)other{
+    return (NSUInteger)__builtin_popcountll(hash ^ other);
+}
+
+@end
\ No newline at end of file
@@ -0,0 +1,128 @@
+//
+//  OlapicUploadQueue.h
+//  OlaUploader
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import "OlapicDuplicateDetector.h"
+
+@class OlapicUploaderEntity;
+@class OlapicMediaEntity;
+/**
+ *  The error domain for the uploads the queue doesn't send
+ */
+extern NSString * const OlapicUploadQueueErrorDomain;
+/**
+ *  The error codes of OlapicUploadQueueErrorDomain
+ */
+typedef NS_ENUM(NSInteger, OlapicUploadQueueError){
+    /**
+     *  The image was already uploaded. The userInfo has the Hamming
+     *  distance to the previous upload, as OlapicUploadQueueDistanceKey
+     */
+    OlapicUploadQueueErrorDuplicate = 1
+};
+/**
+ *  The userInfo key with the Hamming distance of a duplicate
+ */
+extern NSString * const OlapicUploadQueueDistanceKey;
+/**
+ *  A serial queue for the uploads that follows the network reachability:
+ *  while the device is offline the uploads wait, uploads that fail
+ *  because the connection was lost go back to the queue, and everything
+ *  resumes automatically when the connection comes back.
+ *
+ *  Before an upload starts, the perceptual hash of the image is computed
+ *  (in the background) and checked with the duplicateDetector. A
+ *  duplicate fails with OlapicUploadQueueErrorDuplicate before any byte
+ *  is sent, unless the onDuplicate block decides to upload it anyway.
+ *  The hashes of the images uploaded are added to the detector.
+ *
+ *  All the methods should be called from the main thread.
+ */
+@interface OlapicUploadQueue : NSObject{
+    /**
+     *  The uploads waiting to be started
+     */
+    NSMutableArray *pending;
+    /**
+     *  If there's an upload running
+     */
+    BOOL uploading;
+    /**
+     *  If the device can reach the network
+     */
+    BOOL online;
+    /**
+     *  Checks the images before they're uploaded (nil to upload everything)
+     */
+    OlapicDuplicateDetector *duplicateDetector;
+}
+
+@property (nonatomic,readonly) BOOL online;
+@property (nonatomic,strong) OlapicDuplicateDetector *duplicateDetector;
+/**
+ *  Get the singleton shared instance
+ *
+ *  @return The shared instance
+ */
++(instancetype)sharedQueue;
+/**
+ *  Queue an image upload
+ *
+ *  @param image    The image to upload
+ *  @param metadata The media metadata (caption, latitude, longitude)
+ *  @param uploader The uploader entity
+ *  @param success  A callback block for when the media is uploaded
+ *  @param failure  A callback block for when the upload fails for a reason other than the connection
+ *  @param progress A callback block for the upload progress (0 to 100)
+ */
+-(void)uploadImage:(UIImage *)image metadata:(NSDictionary *)metadata withUploader:(OlapicUploaderEntity *)uploader onSuccess:(void (^)(OlapicMediaEntity *media))success onFailure:(void (^)(NSError *error))failure onProgress:(void (^)(float progress))progress;
+/**
+ *  Queue an image upload, deciding what to do if it's a duplicate
+ *
+ *  @param image     The image to upload
+ *  @param metadata  The media metadata (caption, latitude, longitude)
+ *  @param uploader  The uploader entity
+ *  @param duplicate A callback block for when the image was already uploaded, it returns YES to upload it anyway (nil to skip it)
+ *  @param success   A callback block for when the media is uploaded
+ *  @param failure   A callback block for when the upload fails for a reason other than the connection
+ *  @param progress  A callback block for the upload progress (0 to 100)
+ */
+-(void)uploadImage:(UIImage *)image metadata:(NSDictionary *)metadata withUploader:(OlapicUploaderEntity *)uploader onDuplicate:(BOOL (^)(NSUInteger distance))duplicate onSuccess:(void (^)(OlapicMediaEntity *media))success onFailure:(void (^)(NSError *error))failure onProgress:(void (^)(float progress))progress;
+/**
+ *  Get the number of uploads that are waiting or running
+ *
+ *  @return The number of uploads
+ */
+-(NSUInteger)count;
+
+@end
\ No newline at end of file
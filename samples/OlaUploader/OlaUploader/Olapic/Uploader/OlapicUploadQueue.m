@@ -0,0 +1,245 @@
+//
+//  OlapicUploadQueue.m
+//  OlaUploader
+//  https://github.com/Olapic/Olapic-SDK-iOS
+//
+//  Documentation
+//  http://docs.photorank.me/ios
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//  https://olapic.com
+//
+//  The MIT License (MIT)
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "OlapicUploadQueue.h"
+#import <OlapicSDK/OlapicSDK.h>
+#import "OlapicAFNetworkReachabilityManager.h"
+
+NSString * const OlapicUploadQueueErrorDomain = @"OlapicUploadQueueErrorDomain";
+NSString * const OlapicUploadQueueDistanceKey = @"OlapicUploadQueueDistanceKey";
+
+@interface OlapicUploadQueue()
+/**
+ *  Read the reachability status and resume the queue if possible
+ *
+ *  @param status The new reachability status
+ */
+-(void)reachabilityChanged:(OlapicAFNetworkReachabilityStatus)status;
+/**
+ *  Start the next upload, if the device is online and nothing
+ *  else is being uploaded
+ */
+-(void)startNextUpload;
+/**
+ *  Check if an error was caused by the lack of connection
+ *
+ *  @param error The error
+ *
+ *  @return YES if the upload can be retried once the device is back online
+ */
+-(BOOL)isConnectionError:(NSError *)error;
+/**
+ *  Upload an image once its hash was checked
+ *
+ *  @param upload The upload information
+ */
+-(void)sendUpload:(NSDictionary *)upload;
+
+@end
+
+@implementation OlapicUploadQueue
+@synthesize online,duplicateDetector;
+/**
+ *  Get the singleton shared instance
+ *
+ *  @return The shared instance
+ */
++(instancetype)sharedQueue{
+    static OlapicUploadQueue *sharedQueue = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedQueue = [[OlapicUploadQueue alloc] init];
+    });
+    return sharedQueue;
+}
+/**
+ *  Class constructor
+ *
+ *  @return An instance of this object (OlapicUploadQueue)
+ */
+-(id)init{
+    self = [super init];
+    if(self){
+        pending = [[NSMutableArray alloc] init];
+        uploading = NO;
+        online = YES;
+        duplicateDetector = [OlapicDuplicateDetector sharedDetector];
+        __weak OlapicUploadQueue *weakSelf = self;
+        OlapicAFNetworkReachabilityManager *reachability = [OlapicAFNetworkReachabilityManager sharedManager];
+        [reachability setReachabilityStatusChangeBlock:^(OlapicAFNetworkReachabilityStatus status){
+            [weakSelf reachabilityChanged:status];
+        }];
+        [reachability startMonitoring];
+    }
+    return self;
+}
+/**
+ *  Read the reachability status and resume the queue if possible
+ *
+ *  @param status The new reachability status
+ */
+-(void)reachabilityChanged:(OlapicAFNetworkReachabilityStatus)status{
+    online = (status != OlapicAFNetworkReachabilityStatusNotReachable);
+    [self startNextUpload];
+}
+/**
+ *  Queue an image upload
+ *
+ *  @param image    The image to upload
+ *  @param metadata The media metadata (caption, latitude, longitude)
+ *  @param uploader The uploader entity
+ *  @param success  A callback block for when the media is uploaded
+ *  @param failure  A callback block for when the upload fails for a reason other than the connection
+ *  @param progress A callback block for the upload progress (0 to 100)
+ */
+-(void)uploadImage:(UIImage *)image metadata:(NSDictionary *)metadata withUploader:(OlapicUploaderEntity *)uploader onSuccess:(void (^)(OlapicMediaEntity *media))success onFailure:(void (^)(NSError *error))failure onProgress:(void (^)(float progress))progress{
+    [self uploadImage:image metadata:metadata withUploader:uploader onDuplicate:nil onSuccess:success onFailure:failure onProgress:progress];
+}
+/**
+ *  Queue an image upload, deciding what to do if it's a duplicate
+ *
+ *  @param image     The image to upload
+ *  @param metadata  The media metadata (caption, latitude, longitude)
+ *  @param uploader  The uploader entity
+ *  @param duplicate A callback block for when the image was already uploaded, it returns YES to upload it anyway (nil to skip it)
+ *  @param success   A callback block for when the media is uploaded
+ *  @param failure   A callback block for when the upload fails for a reason other than the connection
+ *  @param progress  A callback block for the upload progress (0 to 100)
+ */
+-(void)uploadImage:(UIImage *)image metadata:(NSDictionary *)metadata withUploader:(OlapicUploaderEntity *)uploader onDuplicate:(BOOL (^)(NSUInteger distance))duplicate onSuccess:(void (^)(OlapicMediaEntity *media))success onFailure:(void (^)(NSError *error))failure onProgress:(void (^)(float progress))progress{
+    NSMutableDictionary *upload = [[NSMutableDictionary alloc] init];
+    [upload setValue:image forKey:@"image"];
+    [upload setValue:metadata forKey:@"metadata"];
+    [upload setValue:uploader forKey:@"uploader"];
+    if(duplicate) [upload setValue:[duplicate copy] forKey:@"duplicate"];
+    if(success) [upload setValue:[success copy] forKey:@"success"];
+    if(failure) [upload setValue:[failure copy] forKey:@"failure"];
+    if(progress) [upload setValue:[progress copy] forKey:@"progress"];
+    [pending addObject:upload];
+    [self startNextUpload];
+}
+/**
+ *  Start the next upload, if the device is online and nothing
+ *  else is being uploaded
+ */
+-(void)startNextUpload{
+    if(uploading || !online || ![pending count]){
+        return;
+    }
+    NSMutableDictionary *upload = [pending objectAtIndex:0];
+    [pending removeObjectAtIndex:0];
+    uploading = YES;
+    OlapicDuplicateDetector *detector = duplicateDetector;
+    if(!detector || [upload valueForKey:@"hash"]){
+        // Not checked, or already checked before a connection error
+        [self sendUpload:upload];
+        return;
+    }
+    UIImage *image = [upload valueForKey:@"image"];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        uint64_t hash = [OlapicDuplicateDetector perceptualHashForImage:image];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [upload setValue:[NSNumber numberWithUnsignedLongLong:hash] forKey:@"hash"];
+            NSUInteger distance = 0;
+            if(hash && [detector previousUploadMatchingHash:hash distance:&distance]){
+                BOOL (^duplicate)(NSUInteger bits) = [upload valueForKey:@"duplicate"];
+                if(!duplicate || !duplicate(distance)){
+                    uploading = NO;
+                    void (^failure)(NSError *error) = [upload valueForKey:@"failure"];
+                    NSDictionary *userInfo = @{NSLocalizedDescriptionKey: @"The image was already uploaded", OlapicUploadQueueDistanceKey: [NSNumber numberWithUnsignedInteger:distance]};
+                    if(failure) failure([NSError errorWithDomain:OlapicUploadQueueErrorDomain code:OlapicUploadQueueErrorDuplicate userInfo:userInfo]);
+                    [self startNextUpload];
+                    return;
+                }
+            }
+            [self sendUpload:upload];
+        });
+    });
+}
+/**
+ *  Upload an image once its hash was checked
+ *
+ *  @param upload The upload information
+ */
+-(void)sendUpload:(NSDictionary *)upload{
+    void (^success)(OlapicMediaEntity *media) = [upload valueForKey:@"success"];
+    void (^failure)(NSError *error) = [upload valueForKey:@"failure"];
+    void (^progress)(float progress) = [upload valueForKey:@"progress"];
+    OlapicUploaderEntity *uploader = [upload valueForKey:@"uploader"];
+    [uploader uploadMediaFromImage:[upload valueForKey:@"image"] metadata:[upload valueForKey:@"metadata"] onSuccess:^(OlapicMediaEntity *media) {
+        uploading = NO;
+        uint64_t hash = [[upload valueForKey:@"hash"] unsignedLongLongValue];
+        if(hash) [duplicateDetector addUploadedHash:hash];
+        if(success) success(media);
+        [self startNextUpload];
+    } onFailure:^(NSError *error) {
+        uploading = NO;
+        if([self isConnectionError:error]){
+            // Back to the front of the queue, it'll start again when
+            // the connection comes back
+            [pending insertObject:upload atIndex:0];
+            if(online){
+                // Reachability didn't notice yet, try again in a while
+                dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+                    [self startNextUpload];
+                });
+                return;
+            }
+        }else if(failure){
+            failure(error);
+        }
+        [self startNextUpload];
+    } onProgress:^(float value) {
+        if(progress) progress(value);
+    }];
+}
+/**
+ *  Get the number of uploads that are waiting or running
+ *
+ *  @return The number of uploads
+ */
+-(NSUInteger)count{
+    return [pending count] + (uploading ? 1 : 0);
+}
+/**
+ *  Check if an error was caused by the lack of connection
+ *
+ *  @param error The error
+ *
+ *  @return YES if the upload can be retried once the device is back online
+ */
+-(BOOL)isConnectionError:(NSError *)error{
+    if(![error.domain isEqualToString:NSURLErrorDomain]) return NO;
+    return error.code == NSURLErrorNotConnectedToInternet || error.code == NSURLErrorNetworkConnectionLost;
+}
+
+@end
\ No newline at end of file
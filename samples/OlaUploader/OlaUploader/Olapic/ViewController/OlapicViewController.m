@@ -34,6 +34,7 @@
 //  THE SOFTWARE.
 
 #import "OlapicViewController.h"
+#import "OlapicUploadQueue.h"
 
 @interface OlapicViewController ()
 -(void)openSelector:(id)sender;
@@ -164,9 +165,16 @@
     [mediaMetadata setValue:@"The caption" forKey:@"caption"];
     [mediaMetadata setValue:[NSString stringWithFormat:@"%f", locationManager.location.coordinate.latitude] forKey:@"latitude"];
     [mediaMetadata setValue:[NSString stringWithFormat:@"%f", locationManager.location.coordinate.longitude] forKey:@"longitude"];
-    [_uploader uploadMediaFromImage:[self compressForUpload:selectedImage scale:0.5] metadata:mediaMetadata onSuccess:^(OlapicMediaEntity *media) {
+    if(![[OlapicUploadQueue sharedQueue] online]){
+        [self showAlert:@"You are offline, the media will be uploaded when the connection comes back" title:@"Offline"];
+    }
+    [[OlapicUploadQueue sharedQueue] uploadImage:[self compressForUpload:selectedImage scale:0.5] metadata:mediaMetadata withUploader:_uploader onSuccess:^(OlapicMediaEntity *media) {
         [self showAlert:@"The media has been uploaded, it should appear on the moderation queue soon" title:@"Ok"];
     } onFailure:^(NSError *error) {
+        if([error.domain isEqualToString:OlapicUploadQueueErrorDomain] && error.code == OlapicUploadQueueErrorDuplicate){
+            [self showAlert:@"This photo (or a very similar one) was already uploaded" title:@"Duplicate"];
+            return;
+        }
         [self showAlert:[NSString stringWithFormat:@"Error uploading media: %@", error] title:@"Error"];
     } onProgress:^(float progress) {
         self.imageUploadProgress.progress = (progress / 100);
@@ -0,0 +1,145 @@
+//
+//  OlapicDuplicateDetectorTests.m
+//  OlaUploaderTests
+//
+//  Created by The Olapic Team on 10/19/26.
+//  Copyright (c) 2014 Olapic, Inc. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OlapicDuplicateDetector.h"
+
+@interface OlapicDuplicateDetectorTests : XCTestCase
+
+@end
+
+@implementation OlapicDuplicateDetectorTests
+
+/**
+ *  A test pattern: a few rectangles over a gradient
+ */
+- (UIImage *)patternWithSide:(CGFloat)side
+{
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(side, side), YES, 1);
+    for(NSUInteger i = 0; i < 8; i++){
+        [[UIColor colorWithWhite:(CGFloat)i / 8 alpha:1] setFill];
+        UIRectFill(CGRectMake(side * i / 8, 0, side / 8, side));
+    }
+    [[UIColor blackColor] setFill];
+    UIRectFill(CGRectMake(side * 0.1, side * 0.6, side * 0.3, side * 0.3));
+    [[UIColor whiteColor] setFill];
+    UIRectFill(CGRectMake(side * 0.5, side * 0.1, side * 0.2, side * 0.4));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return image;
+}
+
+/**
+ *  Draw an image upright, applying its orientation
+ */
+- (UIImage *)uprightImage:(UIImage *)image
+{
+    UIGraphicsBeginImageContextWithOptions(image.size, YES, 1);
+    [image drawInRect:CGRectMake(0, 0, image.size.width, image.size.height)];
+    UIImage *upright = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return upright;
+}
+
+- (void)testHammingDistance
+{
+    XCTAssertEqual([OlapicDuplicateDetector distanceBetweenHash:0 andHash:0], (NSUInteger)0);
+    XCTAssertEqual([OlapicDuplicateDetector distanceBetweenHash:0x1234 andHash:0x1234], (NSUInteger)0);
+    XCTAssertEqual([OlapicDuplicateDetector distanceBetweenHash:0 andHash:1], (NSUInteger)1);
+    XCTAssertEqual([OlapicDuplicateDetector distanceBetweenHash:0xF0 andHash:0x0F], (NSUInteger)8);
+    XCTAssertEqual([OlapicDuplicateDetector distanceBetweenHash:0 andHash:UINT64_MAX], (NSUInteger)64);
+    XCTAssertEqual([OlapicDuplicateDetector distanceBetweenHash:1ULL << 63 andHash:1], (NSUInteger)2);
+    XCTAssertEqual([OlapicDuplicateDetector distanceBetweenHash:0xAAAAAAAAAAAAAAAAULL andHash:0x5555555555555555ULL], (NSUInteger)64);
+}
+
+- (void)testMatchesWithinTheThreshold
+{
+    OlapicDuplicateDetector *detector = [[OlapicDuplicateDetector alloc] initWithPath:nil];
+    detector.hammingThreshold = 4;
+    [detector addUploadedHash:0xFFFF];
+    [detector addUploadedHash:0xFF00FF];
+    NSUInteger distance = NSUIntegerMax;
+    // 3 bits away from the first one, and more from the second one
+    XCTAssertEqualObjects([detector previousUploadMatchingHash:0xFFF8 distance:&distance], @(0xFFFFULL));
+    XCTAssertEqual(distance, (NSUInteger)3);
+    XCTAssertEqualObjects([detector previousUploadMatchingHash:0xFF00FF distance:&distance], @(0xFF00FFULL));
+    XCTAssertEqual(distance, (NSUInteger)0);
+    // 5 bits away from the closest one
+    XCTAssertNil([detector previousUploadMatchingHash:0xFFE0 distance:NULL]);
+    [detector removeAllHashes];
+    XCTAssertNil([detector previousUploadMatchingHash:0xFFFF distance:NULL]);
+}
+
+- (void)testKeepsOnlyTheNewestHashes
+{
+    OlapicDuplicateDetector *detector = [[OlapicDuplicateDetector alloc] initWithPath:nil];
+    detector.hammingThreshold = 0;
+    detector.countLimit = 2;
+    [detector addUploadedHash:1];
+    [detector addUploadedHash:2];
+    [detector addUploadedHash:3];
+    XCTAssertNil([detector previousUploadMatchingHash:1 distance:NULL]);
+    XCTAssertNotNil([detector previousUploadMatchingHash:2 distance:NULL]);
+    XCTAssertNotNil([detector previousUploadMatchingHash:3 distance:NULL]);
+}
+
+- (void)testReadsTheSavedHashes
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"OlapicDuplicateDetectorTests-%@.plist", [[NSUUID UUID] UUIDString]]];
+    XCTAssertTrue([@[@(0xABCDULL), @"not a hash"] writeToFile:path atomically:YES]);
+    OlapicDuplicateDetector *detector = [[OlapicDuplicateDetector alloc] initWithPath:path];
+    detector.hammingThreshold = 0;
+    XCTAssertNotNil([detector previousUploadMatchingHash:0xABCD distance:NULL]);
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+- (void)testPerceptualHash
+{
+    UIImage *image = [self patternWithSide:256];
+    uint64_t hash = [OlapicDuplicateDetector perceptualHashForImage:image];
+    XCTAssertNotEqual(hash, (uint64_t)0);
+    XCTAssertEqual([OlapicDuplicateDetector perceptualHashForImage:image], hash);
+    // The same picture at another size is a duplicate
+    uint64_t smaller = [OlapicDuplicateDetector perceptualHashForImage:[self patternWithSide:128]];
+    XCTAssertTrue([OlapicDuplicateDetector distanceBetweenHash:hash andHash:smaller] <= [[OlapicDuplicateDetector alloc] initWithPath:nil].hammingThreshold);
+    XCTAssertEqual([OlapicDuplicateDetector perceptualHashForImage:[[UIImage alloc] init]], (uint64_t)0);
+}
+
+- (void)testDifferentImageIsNotADuplicate
+{
+    UIImage *image = [self patternWithSide:256];
+    // The negative of the pattern: every frequency changes its sign
+    UIGraphicsBeginImageContextWithOptions(image.size, YES, 1);
+    [image drawAtPoint:CGPointZero];
+    CGContextSetBlendMode(UIGraphicsGetCurrentContext(), kCGBlendModeDifference);
+    [[UIColor whiteColor] setFill];
+    UIRectFill(CGRectMake(0, 0, image.size.width, image.size.height));
+    UIImage *negative = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    uint64_t hash = [OlapicDuplicateDetector perceptualHashForImage:image];
+    uint64_t other = [OlapicDuplicateDetector perceptualHashForImage:negative];
+    OlapicDuplicateDetector *detector = [[OlapicDuplicateDetector alloc] initWithPath:nil];
+    XCTAssertTrue([OlapicDuplicateDetector distanceBetweenHash:hash andHash:other] > detector.hammingThreshold);
+    [detector addUploadedHash:hash];
+    XCTAssertNil([detector previousUploadMatchingHash:other distance:NULL]);
+}
+
+- (void)testAppliesTheOrientation
+{
+    CGImageRef pixels = [self patternWithSide:256].CGImage;
+    OlapicDuplicateDetector *detector = [[OlapicDuplicateDetector alloc] initWithPath:nil];
+    UIImageOrientation orientations[] = {UIImageOrientationDown, UIImageOrientationLeft, UIImageOrientationRight, UIImageOrientationUpMirrored, UIImageOrientationLeftMirrored};
+    for(NSUInteger i = 0; i < sizeof(orientations) / sizeof(orientations[0]); i++){
+        UIImage *rotated = [UIImage imageWithCGImage:pixels scale:1 orientation:orientations[i]];
+        uint64_t hash = [OlapicDuplicateDetector perceptualHashForImage:rotated];
+        uint64_t upright = [OlapicDuplicateDetector perceptualHashForImage:[self uprightImage:rotated]];
+        XCTAssertTrue([OlapicDuplicateDetector distanceBetweenHash:hash andHash:upright] <= detector.hammingThreshold, @"orientation %ld", (long)orientations[i]);
+    }
+}
+
+@end
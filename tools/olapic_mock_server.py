@@ -0,0 +1,275 @@
+#!/usr/bin/env python3
+"""A local stand-in for the Olapic API, for repeatable performance tests.
+
+It serves the fixtures recorded by the samples' OlapicFixtureTransport
+(a '<key>.json' file with the method, URL, status and headers of each
+response, next to a '<key>.body' file), and it can make them slower or
+less reliable:
+
+  --latency / --jitter   milliseconds before each response starts
+  --bandwidth            kilobytes per second for the bodies (both ways)
+  --error-rate           fraction of the requests answered with --error-status
+  --drop-rate            fraction of the connections closed without an answer
+  --seed                 makes the injected latency and errors repeatable
+
+A request matches the fixture with the same method, path and query (the
+'auth_token' parameter is ignored and the parameters can come in any
+order), or else the one with the same method and path. The links in the
+bodies that point to the recorded hosts are rewritten to this server, so
+the pagination stays local. POST and PUT requests without a fixture (like
+the uploads) read the whole body and get --upload-status back.
+
+Only the Python 3 standard library is needed:
+
+  python3 tools/olapic_mock_server.py --fixtures path/to/Fixtures \\
+      --port 8080 --latency 120 --jitter 40 --bandwidth 512 --error-rate 0.02
+
+Point the app at it with OlapicFixtureTransport's serverURL, or send the
+requests directly (for example, with a load testing tool on a headless box).
+"""
+import argparse
+import json
+import os
+import random
+import signal
+import socket
+import sys
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import urlsplit
+
+
+def canonical_query(query):
+    """Sort the query parameters and drop the API key."""
+    pairs = [p for p in query.split('&') if p and not p.startswith('auth_token=')]
+    return '&'.join(sorted(pairs))
+
+
+class Fixtures(object):
+    """The recorded responses, by method, path and query."""
+
+    def __init__(self, directory):
+        self.directory = directory
+        self.exact = {}
+        self.by_path = {}
+        self.hosts = set()
+        for name in sorted(os.listdir(directory)):
+            if not name.endswith('.json'):
+                continue
+            with open(os.path.join(directory, name)) as f:
+                fixture = json.load(f)
+            method = fixture.get('method', 'GET').upper()
+            path = fixture.get('path') or '/'
+            query = canonical_query(fixture.get('query', ''))
+            body_path = os.path.join(directory, fixture.get('body') or name[:-5] + '.body')
+            with open(body_path, 'rb') as f:
+                fixture['data'] = f.read()
+            self.exact[(method, path, query)] = fixture
+            self.by_path.setdefault((method, path), fixture)
+            if fixture.get('host'):
+                self.hosts.add(fixture['host'])
+
+    def __len__(self):
+        return len(self.exact)
+
+    def find(self, method, path, query):
+        fixture = self.exact.get((method, path, canonical_query(query)))
+        if fixture is None:
+            fixture = self.by_path.get((method, path))
+        return fixture
+
+
+class Faults(object):
+    """The injected latency, bandwidth and errors."""
+
+    def __init__(self, options):
+        self.options = options
+        self.random = random.Random(options.seed)
+        self.lock = threading.Lock()
+
+    def draw(self):
+        """Decide what happens to a request: (delay, drop, error)."""
+        o = self.options
+        with self.lock:
+            jitter = self.random.uniform(-o.jitter, o.jitter) if o.jitter else 0.0
+            drop = self.random.random() < o.drop_rate
+            error = self.random.random() < o.error_rate
+        return max(o.latency + jitter, 0.0) / 1000.0, drop, error
+
+    def throttle(self, size, started):
+        """Sleep until 'size' bytes fit in the bandwidth since 'started'."""
+        if not self.options.bandwidth:
+            return
+        expected = size / (self.options.bandwidth * 1024.0)
+        remaining = expected - (time.monotonic() - started)
+        if remaining > 0:
+            time.sleep(remaining)
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'
+    server_version = 'OlapicMockServer/1.0'
+    chunk_size = 4096
+
+    def do_GET(self):
+        self.answer()
+
+    def do_HEAD(self):
+        self.answer()
+
+    def do_POST(self):
+        self.answer()
+
+    def do_PUT(self):
+        self.answer()
+
+    def do_DELETE(self):
+        self.answer()
+
+    def read_body(self):
+        length = int(self.headers.get('Content-Length') or 0)
+        started = time.monotonic()
+        received = 0
+        while received < length:
+            chunk = self.rfile.read(min(self.chunk_size, length - received))
+            if not chunk:
+                break
+            received += len(chunk)
+            self.server.faults.throttle(received, started)
+        return received
+
+    def answer(self):
+        started = time.monotonic()
+        method = self.command.upper()
+        split = urlsplit(self.path)
+        received = self.read_body()
+        delay, drop, error = self.server.faults.draw()
+        time.sleep(delay)
+        if drop:
+            self.log_message('%s %s dropped', method, self.path)
+            self.close_connection = True
+            try:
+                self.connection.shutdown(socket.SHUT_RDWR)
+            except OSError:
+                pass
+            return
+        options = self.server.options
+        fixture = self.server.fixtures.find(method, split.path or '/', split.query)
+        headers = {}
+        if error:
+            status = options.error_status
+            data = json.dumps({'metadata': {'code': status, 'message': 'Injected error'}}).encode()
+            headers['Content-Type'] = 'application/json'
+        elif fixture is not None:
+            status = int(fixture.get('status', 200))
+            data = self.rewrite_links(fixture['data'])
+            headers.update(fixture.get('headers') or {})
+        elif method in ('POST', 'PUT'):
+            status = options.upload_status
+            data = json.dumps({'metadata': {'code': status}, 'data': {'received_bytes': received}}).encode()
+            headers['Content-Type'] = 'application/json'
+        else:
+            status = 404
+            data = json.dumps({'metadata': {'code': 404, 'message': 'No fixture for the request'}}).encode()
+            headers['Content-Type'] = 'application/json'
+        self.send_response(status)
+        for name, value in headers.items():
+            if name.lower() not in ('content-length', 'content-encoding', 'transfer-encoding', 'connection', 'date', 'server'):
+                self.send_header(name, value)
+        self.send_header('Content-Length', str(len(data)))
+        self.end_headers()
+        if method != 'HEAD':
+            self.write_body(data)
+        self.server.count(status, len(data), time.monotonic() - started)
+
+    def write_body(self, data):
+        started = time.monotonic()
+        sent = 0
+        while sent < len(data):
+            chunk = data[sent:sent + self.chunk_size]
+            self.wfile.write(chunk)
+            sent += len(chunk)
+            self.server.faults.throttle(sent, started)
+
+    def rewrite_links(self, data):
+        if self.server.options.keep_links or not self.server.fixtures.hosts:
+            return data
+        local = (self.headers.get('Host') or '%s:%d' % self.server.server_address[:2]).encode()
+        for host in self.server.fixtures.hosts:
+            remote = host.encode()
+            data = data.replace(b'https://' + remote, b'http://' + local)
+            data = data.replace(b'http://' + remote, b'http://' + local)
+            data = data.replace(b'//' + remote, b'//' + local)
+        return data
+
+    def log_message(self, format, *args):
+        if not self.server.options.quiet:
+            sys.stderr.write('%s - %s\n' % (self.address_string(), format % args))
+
+
+class MockServer(ThreadingHTTPServer):
+    daemon_threads = True
+
+    def __init__(self, options, fixtures):
+        ThreadingHTTPServer.__init__(self, (options.host, options.port), Handler)
+        self.options = options
+        self.fixtures = fixtures
+        self.faults = Faults(options)
+        self.stats_lock = threading.Lock()
+        self.statuses = {}
+        self.bytes_sent = 0
+        self.durations = []
+
+    def count(self, status, size, duration):
+        with self.stats_lock:
+            self.statuses[status] = self.statuses.get(status, 0) + 1
+            self.bytes_sent += size
+            self.durations.append(duration)
+
+    def summary(self):
+        with self.stats_lock:
+            durations = sorted(self.durations)
+            if not durations:
+                return 'No requests'
+            percentile = lambda p: durations[min(int(p * len(durations)), len(durations) - 1)] * 1000
+            return '%d requests, %d bytes, statuses %s, p50 %.0f ms, p95 %.0f ms' % (
+                len(durations), self.bytes_sent, self.statuses, percentile(0.5), percentile(0.95))
+
+
+def stop(signum, frame):
+    raise KeyboardInterrupt
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Serve recorded Olapic API fixtures with injected latency and errors.')
+    parser.add_argument('--fixtures', required=True, help='the directory with the recorded fixtures')
+    parser.add_argument('--host', default='127.0.0.1')
+    parser.add_argument('--port', type=int, default=8080)
+    parser.add_argument('--latency', type=float, default=0.0, help='milliseconds before each response')
+    parser.add_argument('--jitter', type=float, default=0.0, help='random +/- milliseconds added to the latency')
+    parser.add_argument('--bandwidth', type=float, default=0.0, help='kilobytes per second for each body (0 is unlimited)')
+    parser.add_argument('--error-rate', type=float, default=0.0, help='fraction of the requests that fail')
+    parser.add_argument('--error-status', type=int, default=503)
+    parser.add_argument('--drop-rate', type=float, default=0.0, help='fraction of the connections closed without an answer')
+    parser.add_argument('--upload-status', type=int, default=201, help='status for the POST and PUT requests without a fixture')
+    parser.add_argument('--seed', type=int, default=None, help='seed for the injected faults')
+    parser.add_argument('--keep-links', action='store_true', help="don't rewrite the recorded hosts in the bodies")
+    parser.add_argument('--quiet', action='store_true', help="don't log every request")
+    options = parser.parse_args()
+    fixtures = Fixtures(options.fixtures)
+    server = MockServer(options, fixtures)
+    # CI runners stop it with SIGTERM, the summary is still printed
+    signal.signal(signal.SIGTERM, stop)
+    sys.stderr.write('Serving %d fixtures on http://%s:%d\n' % (len(fixtures), options.host, server.server_address[1]))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+        sys.stderr.write(server.summary() + '\n')
+
+
+if __name__ == '__main__':
+    main()